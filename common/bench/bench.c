@@ -0,0 +1,248 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE ""
+#endif
+
+#define MAX_REPEATS 64
+#define MAX_NAME 128
+
+volatile uint64_t bench_sink;
+
+typedef struct baseline_t {
+    char build_type[MAX_NAME];
+    size_t n;
+    char (*names)[MAX_NAME];
+    double *ns_per_op;
+} baseline_t;
+
+double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+void bench_run(const bench_case_t *c, double min_time, int repeats, bench_result_t *r) {
+    double t[MAX_REPEATS];
+    uint64_t ops = 1;
+
+    // Calibration, this also warms up caches and branch predictors
+    for (;;) {
+        double start = bench_now();
+        c->run(c->arg, ops);
+        double elapsed = bench_now() - start;
+
+        if (elapsed >= min_time || ops >= UINT64_C(1) << 40)
+            break;
+
+        // Aim slightly above min_time, but never grow by more than 16x at once
+        double scale = elapsed > 0 ? 1.2 * min_time / elapsed : 16;
+        ops = scale > 16 ? ops * 16 : scale < 2 ? ops * 2 : (uint64_t)(ops * scale);
+    }
+
+    for (int i = 0; i < repeats; i++) {
+        double start = bench_now();
+        c->run(c->arg, ops);
+        t[i] = (bench_now() - start) * 1e9 / ops;
+    }
+    qsort(t, repeats, sizeof(double), cmp_double);
+
+    r->name = c->name;
+    r->ops = ops;
+    r->ns_per_op = t[0];
+    r->ns_per_op_median = repeats & 1 ? t[repeats / 2] : (t[repeats / 2 - 1] + t[repeats / 2]) / 2;
+    r->mb_per_s = c->bytes_per_op > 0 ? c->bytes_per_op / r->ns_per_op * 1e3 : 0;
+}
+
+static void write_json(FILE *out, const char *suite, const bench_result_t *r, size_t n) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"suite\": \"%s\",\n", suite);
+    fprintf(out, "  \"build_type\": \"%s\",\n", BENCH_BUILD_TYPE);
+    fprintf(out, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < n; i++) {
+        fprintf(out, "    { \"name\": \"%s\", \"ns_per_op\": %.6g, \"ns_per_op_median\": %.6g, "
+                "\"ops\": %lu, \"mb_per_s\": %.6g }%s\n", r[i].name, r[i].ns_per_op, r[i].ns_per_op_median,
+                r[i].ops, r[i].mb_per_s, i + 1 < n ? "," : "");
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
+
+// Reads the files written by write_json, one benchmark per line
+static bool read_baseline(const char *path, baseline_t *b) {
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+
+    memset(b, 0, sizeof(*b));
+    size_t cap = 0;
+    char *line = NULL;
+    size_t line_n = 0;
+
+    while (getline(&line, &line_n, f) != -1) {
+        char name[MAX_NAME];
+        double ns;
+
+        if (sscanf(line, " \"build_type\": \"%127[^\"]\"", b->build_type) == 1)
+            continue;
+        if (sscanf(line, " { \"name\": \"%127[^\"]\", \"ns_per_op\": %lf", name, &ns) < 2)
+            continue;
+
+        if (b->n == cap) {
+            cap = cap ? 2 * cap : 32;
+            b->names = realloc(b->names, cap * sizeof(*b->names));
+            b->ns_per_op = realloc(b->ns_per_op, cap * sizeof(double));
+        }
+        strcpy(b->names[b->n], name);
+        b->ns_per_op[b->n++] = ns;
+    }
+
+    free(line);
+    fclose(f);
+    return true;
+}
+
+// Prints the comparison to stderr, returns the number of regressions
+static int compare(const baseline_t *b, const bench_result_t *r, size_t n, double tolerance) {
+    int regressions = 0;
+
+    if (strcmp(b->build_type, BENCH_BUILD_TYPE))
+        fprintf(stderr, "warning: baseline build type \"%s\" differs from \"%s\"\n", b->build_type, BENCH_BUILD_TYPE);
+
+    fprintf(stderr, "%-40s %12s %12s %9s\n", "benchmark", "baseline ns", "ns", "change");
+    for (size_t i = 0; i < n; i++) {
+        size_t j = 0;
+        while (j < b->n && strcmp(b->names[j], r[i].name))
+            j++;
+
+        if (j == b->n) {
+            fprintf(stderr, "%-40s %12s %12.4g %9s  new\n", r[i].name, "-", r[i].ns_per_op, "");
+            continue;
+        }
+
+        double change = r[i].ns_per_op / b->ns_per_op[j] - 1;
+        const char *verdict = "";
+        if (change > tolerance) {
+            verdict = "  REGRESSION";
+            regressions++;
+        } else if (change < -tolerance) {
+            verdict = "  faster";
+        }
+
+        fprintf(stderr, "%-40s %12.4g %12.4g %+8.1f%%%s\n", r[i].name, b->ns_per_op[j], r[i].ns_per_op,
+                100 * change, verdict);
+    }
+
+    return regressions;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-o OUTFILE] [-c BASELINE] [-T TOLERANCE] [-m MIN_MS] [-r REPEATS] [FILTER...]\n", prog);
+    fprintf(stderr, "  -o OUTFILE    Write the JSON results to OUTFILE instead of stdout\n");
+    fprintf(stderr, "  -c BASELINE   Compare against the JSON results of an earlier run, exit with 1 on regressions\n");
+    fprintf(stderr, "  -T TOLERANCE  Relative slowdown reported as regression, default 0.1\n");
+    fprintf(stderr, "  -m MIN_MS     Minimum duration of one repetition, default 100\n");
+    fprintf(stderr, "  -r REPEATS    Repetitions per benchmark, the fastest one is reported, default 5\n");
+    fprintf(stderr, "Only benchmarks whose name contains one of the FILTERs are run.\n");
+}
+
+int bench_main(int argc, char *argv[], const char *suite, const bench_case_t *cases, size_t n) {
+    const char *prog = argv[0];
+    const char *out_path = NULL, *baseline_path = NULL;
+    double tolerance = 0.1, min_ms = 100;
+    int repeats = 5;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:c:T:m:r:")) != -1) {
+        switch (opt) {
+        case 'o':
+            out_path = optarg;
+            break;
+        case 'c':
+            baseline_path = optarg;
+            break;
+        case 'T':
+            if (sscanf(optarg, "%lf", &tolerance) < 1 || !(tolerance >= 0)) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as tolerance!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'm':
+            if (sscanf(optarg, "%lf", &min_ms) < 1 || !(min_ms > 0)) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as duration!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'r':
+            if (sscanf(optarg, "%d", &repeats) < 1 || repeats < 1 || repeats > MAX_REPEATS) {
+                fprintf(stderr, "%s: Invalid argument, repetitions must be in [1, %d]!\n", prog, MAX_REPEATS);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            usage(prog);
+            return EXIT_FAILURE;
+        }
+    }
+
+    baseline_t baseline;
+    if (baseline_path && !read_baseline(baseline_path, &baseline)) {
+        perror(baseline_path);
+        return EXIT_FAILURE;
+    }
+
+    bench_result_t *results = calloc(n, sizeof(bench_result_t));
+    size_t n_results = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        bool selected = optind == argc;
+        for (int j = optind; j < argc && !selected; j++)
+            selected = strstr(cases[i].name, argv[j]) != NULL;
+        if (!selected)
+            continue;
+
+        bench_result_t *r = &results[n_results++];
+        bench_run(&cases[i], min_ms * 1e-3, repeats, r);
+        fprintf(stderr, "%-40s %10.4g ns/op", r->name, r->ns_per_op);
+        if (r->mb_per_s > 0)
+            fprintf(stderr, " %10.1f MB/s", r->mb_per_s);
+        fprintf(stderr, "\n");
+    }
+
+    int ret = EXIT_SUCCESS;
+    FILE *out = out_path ? fopen(out_path, "w") : stdout;
+    if (!out) {
+        perror(out_path);
+        ret = EXIT_FAILURE;
+    } else {
+        write_json(out, suite, results, n_results);
+        if (out != stdout)
+            fclose(out);
+    }
+
+    if (baseline_path) {
+        int regressions = compare(&baseline, results, n_results, tolerance);
+        if (regressions) {
+            fprintf(stderr, "%d regression(s) above %.0f%%\n", regressions, 100 * tolerance);
+            ret = EXIT_FAILURE;
+        }
+        free(baseline.names);
+        free(baseline.ns_per_op);
+    }
+
+    free(results);
+    return ret;
+}
@@ -0,0 +1,56 @@
+#ifndef H_BENCH
+#define H_BENCH
+
+/*
+ * Minimal benchmark harness, shared by reference/bench and verification/bench.
+ *
+ * Every case runs a given number of operations per call. The iteration count
+ * is doubled until one call takes at least the minimum time, then the call is
+ * repeated and the fastest repetition is reported, as ns per operation and,
+ * for cases with bytes_per_op, MB/s.
+ *
+ * bench_main writes the results as JSON, one benchmark per line:
+ *
+ *   {
+ *     "suite": "reference",
+ *     "build_type": "Release",
+ *     "benchmarks": [
+ *       { "name": "xoroshiro128plus_next", "ns_per_op": 1.234, ... },
+ *       ...
+ *     ]
+ *   }
+ *
+ * and, with -c, compares them against such a file from an earlier run.
+ */
+
+typedef struct bench_case_t {
+    const char *name;
+    void (*run)(void *arg, uint64_t ops);
+    void *arg;
+    double bytes_per_op;    // input bytes consumed per operation, or 0
+} bench_case_t;
+
+typedef struct bench_result_t {
+    const char *name;
+    uint64_t ops;           // operations per repetition
+    double ns_per_op;       // fastest repetition
+    double ns_per_op_median;
+    double mb_per_s;        // 0 unless bytes_per_op is set
+} bench_result_t;
+
+/*
+ * Results of the cases are folded into this, so they cannot be optimized away
+ */
+extern volatile uint64_t bench_sink;
+
+double bench_now(void);
+
+void bench_run(const bench_case_t *c, double min_time, int repeats, bench_result_t *r);
+
+/*
+ * Command line driver: [-o OUTFILE] [-c BASELINE] [-T TOLERANCE] [-m MIN_MS] [-r REPEATS] [FILTER...]
+ * Returns the exit code: non-zero on usage errors and regressions against the baseline.
+ */
+int bench_main(int argc, char *argv[], const char *suite, const bench_case_t *cases, size_t n);
+
+#endif
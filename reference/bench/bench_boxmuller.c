@@ -0,0 +1,337 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "xoroshiro128plus.h"
+#include "urng.h"
+#include "fxpnt.h"
+#include "fxpnt_piecewise_poly.h"
+#include "fxpnt_fixed.h"
+#include "boxmuller.h"
+#include "grng16.h"
+#include "output_remapper.h"
+#include "xoro_lanes.h"
+
+#include "main.h"
+#include "gaussian.h"
+
+#include "bench.h"
+
+/*
+ * Micro- and macro-benchmarks of the components in lib and of gaussian() in
+ * main. Every case consumes precomputed random inputs, INPUTS of them in a
+ * cycle, so the timings do not include the URNG unless it is the subject.
+ */
+
+#define INPUTS 4096
+#define BATCH 1024  // samples per boxmuller_generate call
+
+// The static evaluators of gaussian.c
+FXPNT_FIXED_PP2(log_eval, pp_fx, 8)
+FXPNT_FIXED_PP2(sqrt_eval, pp_fx, 4)
+FXPNT_FIXED_PP2(cos_eval, pp_fx, 4)
+
+typedef struct inputs_t {
+    fxpnt_t a[INPUTS], b[INPUTS];   // (8,32), |a|, |b| < 2
+    fxpnt_t frac[INPUTS];           // 1 + 32-bit fraction
+    uint64_t rand[INPUTS];
+    uint32_t u[3 * BATCH];
+    int16_t x[2 * BATCH];
+    int8_t lanes[2 * BATCH];
+    float lanes_f[2 * BATCH];
+} inputs_t;
+
+typedef struct pp_case_t {
+    const inputs_t *in;
+    fxpnt_pp_t *pp;                 // runtime table
+    const fxpnt_pp2_seg_t *table;   // static table
+} pp_case_t;
+
+static inputs_t in;
+static fxpnt_cfg_t pp_cfg;
+
+static void bench_xoroshiro128plus_next(void *arg, uint64_t ops) {
+    xoroshiro128plus_t *xoro = arg;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc ^= xoroshiro128plus_next(xoro);
+    bench_sink ^= acc;
+}
+
+static void bench_splitmix64_next(void *arg, uint64_t ops) {
+    xoroshiro128plus_t *xoro = arg;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc ^= splitmix64_next(xoro);
+    bench_sink ^= acc;
+}
+
+static void bench_urng_next(void *arg, uint64_t ops) {
+    urng_t *g = arg;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc ^= urng_next(g);
+    bench_sink ^= acc;
+}
+
+static void bench_urng_fill(void *arg, uint64_t ops) {
+    urng_t *g = arg;
+    uint64_t buf[1024];
+    for (uint64_t i = 0; i < ops; i += 1024) {
+        size_t n = ops - i < 1024 ? ops - i : 1024;
+        urng_fill(g, buf, n);
+        bench_sink ^= buf[0];
+    }
+}
+
+static void bench_fxpnt_mult(void *arg, uint64_t ops) {
+    const inputs_t *in = arg;
+    fxpnt_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += fxpnt_mult(&pp_cfg, in->a[i % INPUTS], in->b[i % INPUTS]);
+    bench_sink ^= acc;
+}
+
+static void bench_pp_fx_mult(void *arg, uint64_t ops) {
+    const inputs_t *in = arg;
+    fxpnt_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += pp_fx_mult(in->a[i % INPUTS], in->b[i % INPUTS]);
+    bench_sink ^= acc;
+}
+
+static void bench_fxpnt_pp_eval(void *arg, uint64_t ops) {
+    const pp_case_t *c = arg;
+    fxpnt_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += fxpnt_pp_eval(c->pp, c->in->frac[i % INPUTS]);
+    bench_sink ^= acc;
+}
+
+static void bench_pp_fx_pp_eval(void *arg, uint64_t ops) {
+    const pp_case_t *c = arg;
+    fxpnt_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++)
+        acc += pp_fx_pp_eval(c->pp, c->in->frac[i % INPUTS]);
+    bench_sink ^= acc;
+}
+
+#define BENCH_PP2(NAME)                                                 \
+static void bench_##NAME(void *arg, uint64_t ops) {                     \
+    const pp_case_t *c = arg;                                           \
+    fxpnt_t acc = 0;                                                    \
+    for (uint64_t i = 0; i < ops; i++)                                  \
+        acc += NAME(c->table, c->in->frac[i % INPUTS]);                 \
+    bench_sink ^= acc;                                                  \
+}
+
+BENCH_PP2(log_eval)
+BENCH_PP2(sqrt_eval)
+BENCH_PP2(cos_eval)
+
+static void bench_gaussian(void *arg, uint64_t ops) {
+    const gaussian_ctx_t *ctx = arg;
+    fxpnt_t out[2], acc = 0;
+    for (uint64_t i = 0; i < ops; i++) {
+        gaussian(ctx, in.rand[i % INPUTS], out);
+        acc += out[0] ^ out[1];
+    }
+    bench_sink ^= acc;
+}
+
+static void bench_boxmuller_eval(void *arg, uint64_t ops) {
+    const boxmuller_t *bm = arg;
+    int16_t x[2];
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < ops; i++) {
+        const uint32_t *u = &in.u[3 * (i % BATCH)];
+        boxmuller_eval(bm, u[0] | (uint64_t)(u[1] & 0xFFFF) << 32, u[1] >> 16, u[2] & 0x7FFFFFFF, x);
+        acc += x[0] ^ x[1];
+    }
+    bench_sink ^= acc;
+}
+
+// One op is one input, i.e. two samples
+static void bench_boxmuller_generate(void *arg, uint64_t ops) {
+    const boxmuller_t *bm = arg;
+    for (uint64_t i = 0; i < ops; i += BATCH) {
+        size_t n = ops - i < BATCH ? ops - i : BATCH;
+        boxmuller_generate(bm, in.u, n, in.x);
+        bench_sink ^= in.x[0];
+    }
+}
+
+// One op is one data word, i.e. one cycle of grng_16
+static void bench_grng16_run(void *arg, uint64_t ops) {
+    grng16_t *g = arg;
+    int8_t data[BATCH][GRNG16_LANES];
+    for (uint64_t i = 0; i < ops; i += BATCH) {
+        size_t n = ops - i < BATCH ? ops - i : BATCH;
+        grng16_run(g, n, 256, 0, &data[0][0]);
+        bench_sink ^= data[0][0];
+    }
+}
+
+typedef struct xoro_lanes_case_t {
+    xoro_lanes_isa_t isa;
+    xoro_lanes_t x;
+} xoro_lanes_case_t;
+
+// One op is one output of one lane
+static void bench_xoro_lanes_fill(void *arg, uint64_t ops) {
+    xoro_lanes_case_t *c = arg;
+    static uint64_t out[4096];
+    size_t max_steps = 4096 / c->x.lanes;
+
+    xoro_lanes_set_isa(c->isa);
+    for (uint64_t i = 0; i < ops; i += max_steps * c->x.lanes) {
+        size_t steps = (ops - i + c->x.lanes - 1) / c->x.lanes;
+        if (steps > max_steps)
+            steps = max_steps;
+        xoro_lanes_fill(&c->x, steps, out);
+        bench_sink ^= out[0];
+    }
+}
+
+// One op is one value
+static void bench_output_remapper_generate(void *arg, uint64_t ops) {
+    output_remapper_set_isa(*(const output_remapper_isa_t *) arg);
+    for (uint64_t i = 0; i < ops; i += 2 * BATCH) {
+        size_t n = ops - i < 2 * BATCH ? ops - i : 2 * BATCH;
+        output_remapper_generate(in.x, n, 256, 8, in.lanes);
+        bench_sink ^= in.lanes[0];
+    }
+}
+
+static void bench_output_remapper_unpack(void *arg, uint64_t ops) {
+    output_remapper_set_isa(*(const output_remapper_isa_t *) arg);
+    for (uint64_t i = 0; i < ops; i += 2 * BATCH) {
+        size_t n = ops - i < 2 * BATCH ? ops - i : 2 * BATCH;
+        output_remapper_unpack(in.lanes, n, in.lanes_f);
+        bench_sink ^= (uint64_t) in.lanes_f[0];
+    }
+}
+
+static void fill_pp(fxpnt_pp_t *pp, const fxpnt_pp2_seg_t *table) {
+    for (size_t i = 0; i < pp->n; i++) {
+        fxpnt_t *seg = fxpnt_pp_get_seg(pp, i);
+        seg[0] = table[i].c_0;
+        seg[1] = table[i].c_1;
+        seg[2] = table[i].c_2;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    xoroshiro128plus_t xoro;
+    xoroshiro128plus_init(&xoro, 0x0123456789abcdef);
+
+    pp_cfg = pp_fx_cfg();
+    for (size_t i = 0; i < INPUTS; i++) {
+        in.a[i] = (fxpnt_t)(xoroshiro128plus_next(&xoro) >> 30) - (INT64_C(1) << 33);
+        in.b[i] = (fxpnt_t)(xoroshiro128plus_next(&xoro) >> 30) - (INT64_C(1) << 33);
+        in.frac[i] = pp_fx_from_int(1) | (xoroshiro128plus_next(&xoro) >> 32);
+        in.rand[i] = xoroshiro128plus_next(&xoro);
+    }
+    for (size_t i = 0; i < 3 * BATCH; i++)
+        in.u[i] = xoroshiro128plus_next(&xoro);
+    for (size_t i = 0; i < 2 * BATCH; i++) {
+        in.x[i] = (int16_t) xoroshiro128plus_next(&xoro);
+        in.lanes[i] = (int8_t)(xoroshiro128plus_next(&xoro) % 63) - 31;
+    }
+
+    fxpnt_pp_t *log_pp = fxpnt_pp_new(&pp_cfg, 8, 2);
+    fxpnt_pp_t *sqrt_pp = fxpnt_pp_new(&pp_cfg, 4, 2);
+    fxpnt_pp_t *cos_pp = fxpnt_pp_new(&pp_cfg, 4, 2);
+    fill_pp(log_pp, FXPNT_PP_LOG);
+    fill_pp(sqrt_pp, FXPNT_PP_SQRT);
+    fill_pp(cos_pp, FXPNT_PP_COS);
+
+    pp_case_t log_case = { &in, log_pp, FXPNT_PP_LOG };
+    pp_case_t sqrt_case = { &in, sqrt_pp, FXPNT_PP_SQRT };
+    pp_case_t cos_case = { &in, cos_pp, FXPNT_PP_COS };
+
+    gaussian_ctx_t *ctx = setup();
+    boxmuller_t *bm = boxmuller_new();
+    grng16_t *grng = grng16_new(0);
+    grng16_reset(grng);
+
+    static const output_remapper_isa_t isas[] = {
+        OUTPUT_REMAPPER_ISA_SCALAR, OUTPUT_REMAPPER_ISA_AVX2, OUTPUT_REMAPPER_ISA_AVX512
+    };
+    static const char *isa_names[] = { "scalar", "avx2", "avx512" };
+
+    static const xoro_lanes_isa_t lanes_isas[] = {
+        XORO_LANES_ISA_SCALAR, XORO_LANES_ISA_AVX2, XORO_LANES_ISA_AVX512
+    };
+    static const size_t lane_counts[] = { 4, 8, 12, 16 };
+
+    bench_case_t cases[64] = {
+        { "xoroshiro128plus_next", bench_xoroshiro128plus_next, &xoro, 0 },
+        { "splitmix64_next", bench_splitmix64_next, &xoro, 0 },
+        { "fxpnt_mult", bench_fxpnt_mult, &in, 0 },
+        { "pp_fx_mult", bench_pp_fx_mult, &in, 0 },
+        { "fxpnt_pp_eval/log", bench_fxpnt_pp_eval, &log_case, 0 },
+        { "fxpnt_pp_eval/sqrt", bench_fxpnt_pp_eval, &sqrt_case, 0 },
+        { "fxpnt_pp_eval/cos", bench_fxpnt_pp_eval, &cos_case, 0 },
+        { "pp_fx_pp_eval/log", bench_pp_fx_pp_eval, &log_case, 0 },
+        { "pp_fx_pp_eval/sqrt", bench_pp_fx_pp_eval, &sqrt_case, 0 },
+        { "pp_fx_pp_eval/cos", bench_pp_fx_pp_eval, &cos_case, 0 },
+        { "fxpnt_fixed_pp2/log", bench_log_eval, &log_case, 0 },
+        { "fxpnt_fixed_pp2/sqrt", bench_sqrt_eval, &sqrt_case, 0 },
+        { "fxpnt_fixed_pp2/cos", bench_cos_eval, &cos_case, 0 },
+        { "gaussian", bench_gaussian, ctx, 0 },
+        { "boxmuller_eval", bench_boxmuller_eval, bm, 0 },
+        { "boxmuller_generate", bench_boxmuller_generate, bm, 12 },
+        { "grng16_run", bench_grng16_run, grng, 16 },
+    };
+    size_t n = 0;
+    while (cases[n].name)
+        n++;
+
+    urng_t urngs[URNG_KIND_COUNT];
+    char urng_names[2 * URNG_KIND_COUNT][64];
+    for (int i = 0; i < URNG_KIND_COUNT; i++) {
+        urng_init(&urngs[i], (urng_kind_t) i, 0x0123456789abcdef);
+        snprintf(urng_names[2 * i], sizeof(urng_names[0]), "urng_next/%s", urng_name((urng_kind_t) i));
+        snprintf(urng_names[2 * i + 1], sizeof(urng_names[0]), "urng_fill/%s", urng_name((urng_kind_t) i));
+        cases[n++] = (bench_case_t) { urng_names[2 * i], bench_urng_next, &urngs[i], 8 };
+        cases[n++] = (bench_case_t) { urng_names[2 * i + 1], bench_urng_fill, &urngs[i], 8 };
+    }
+
+    // 12 lanes are the instances of grng_16
+    xoro_lanes_case_t lanes_cases[3][4];
+    char lanes_names[3][4][64];
+    for (size_t i = 0; i < 3; i++) {
+        if (!xoro_lanes_isa_supported(lanes_isas[i]))
+            continue;
+        for (size_t j = 0; j < 4; j++) {
+            lanes_cases[i][j].isa = lanes_isas[i];
+            xoro_lanes_seed(&lanes_cases[i][j].x, lane_counts[j], 0x0123456789abcdef);
+            snprintf(lanes_names[i][j], sizeof(lanes_names[0][0]), "xoro_lanes_fill/%s/%zu", isa_names[i], lane_counts[j]);
+            cases[n++] = (bench_case_t) { lanes_names[i][j], bench_xoro_lanes_fill, &lanes_cases[i][j], 8 };
+        }
+    }
+
+    char names[2 * 3][64];
+    for (size_t i = 0; i < 3; i++) {
+        if (!output_remapper_isa_supported(isas[i]))
+            continue;
+        snprintf(names[2 * i], sizeof(names[0]), "output_remapper_generate/%s", isa_names[i]);
+        snprintf(names[2 * i + 1], sizeof(names[0]), "output_remapper_unpack/%s", isa_names[i]);
+        cases[n++] = (bench_case_t) { names[2 * i], bench_output_remapper_generate, (void *) &isas[i], 2 };
+        cases[n++] = (bench_case_t) { names[2 * i + 1], bench_output_remapper_unpack, (void *) &isas[i], 1 };
+    }
+
+    int ret = bench_main(argc, argv, "reference", cases, n);
+
+    grng16_free(grng);
+    boxmuller_free(bm);
+    teardown(ctx);
+    fxpnt_pp_free(log_pp);
+    fxpnt_pp_free(sqrt_pp);
+    fxpnt_pp_free(cos_pp);
+
+    return ret;
+}
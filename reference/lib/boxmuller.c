@@ -0,0 +1,210 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "boxmuller.h"
+#include "boxmuller_kernels.h"
+#include "boxmuller_datapath.h"
+#include "pp_fcn_rom.h"
+
+// Extracts bits [hi..lo] of a ROM vector, like vec(hi downto lo) in VHDL
+static uint64_t rom_bits(const uint64_t *vec, int hi, int lo) {
+    uint64_t v = 0;
+    for (int i = hi; i >= lo; i--)
+        v = (v << 1) | ((vec[i / 64] >> (i % 64)) & 1);
+    return v;
+}
+
+boxmuller_t *boxmuller_new(void) {
+    boxmuller_t *bm = calloc(1, sizeof(boxmuller_t));
+
+    // vec = [C_2 (14)][C_1 (23)][C_0 (31)]
+    for (size_t i = 0; i < LOG_COEFF_TABLE_DATA_LENGTH; i++) {
+        const uint64_t *vec = LOG_COEFF_TABLE_DATA[i];
+        bm->ln[i].c_0 = sext(rom_bits(vec, 30, 0), 31);
+        bm->ln[i].c_1 = rom_bits(vec, 53, 31);
+        bm->ln[i].c_2 = sext(rom_bits(vec, 67, 54), 14);
+    }
+
+    // vec = [C_1 (13)][C_0 (19)]
+    for (size_t i = 0; i < SQRT_COEFF_TABLE_DATA_LENGTH; i++) {
+        const uint64_t *vec = SQRT_COEFF_TABLE_DATA[i];
+        bm->sqrt[i].c_0 = (int32_t)(uint32_t)(rom_bits(vec, 18, 0) << 13);
+        bm->sqrt[i].c_1 = sext(rom_bits(vec, 31, 19), 13);
+    }
+
+    // vec = [C_1 sin (12)][C_0 sin (19)][C_1 cos (12)][C_0 cos (19)]
+    for (size_t i = 0; i < TRIG_COEFF_TABLE_DATA_LENGTH; i++) {
+        const uint64_t *vec = TRIG_COEFF_TABLE_DATA[i];
+        bm->trig[i].c_0_cos = sext(rom_bits(vec, 18, 0), 19) * 128;
+        bm->trig[i].c_1_cos = sext(rom_bits(vec, 30, 19), 12);
+        bm->trig[i].c_0_sin = sext(rom_bits(vec, 49, 31), 19) * 128;
+        bm->trig[i].c_1_sin = sext(rom_bits(vec, 61, 50), 12);
+    }
+
+    bm->isa = BOXMULLER_ISA_SCALAR;
+    boxmuller_set_isa(bm, BOXMULLER_ISA_AVX2);
+    boxmuller_set_isa(bm, BOXMULLER_ISA_AVX512);
+
+    return bm;
+}
+
+void boxmuller_free(boxmuller_t *bm) {
+    free(bm);
+}
+
+bool boxmuller_isa_supported(boxmuller_isa_t isa) {
+    switch (isa) {
+    case BOXMULLER_ISA_SCALAR:
+        return true;
+#ifdef BOXMULLER_HAVE_AVX2
+    case BOXMULLER_ISA_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+#ifdef BOXMULLER_HAVE_AVX512
+    case BOXMULLER_ISA_AVX512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd");
+#endif
+    default:
+        return false;
+    }
+}
+
+bool boxmuller_set_isa(boxmuller_t *bm, boxmuller_isa_t isa) {
+    if (!boxmuller_isa_supported(isa))
+        return false;
+
+    bm->isa = isa;
+    return true;
+}
+
+//
+// pp_fcn_ln: x (0,31) -> y_e (0,27) ~ ln(1+x)
+//
+static inline uint32_t eval_ln(const boxmuller_t *bm, uint32_t x) {
+    const boxmuller_ln_seg_t *seg = &bm->ln[x >> 23];
+    int64_t x_a = (x & 0x7FFFFF) >> 1;                      // r_i_x
+
+    // r_2_y = r_1_y + C_1 * 2^13, of which only bits 35..13 are used
+    int64_t eta_2 = seg->c_2 * (x_a >> 9);                  // r_1_y
+    int64_t mult_a = sext(seg->c_1 + (eta_2 >> 13), 23);    // w_3_a
+    int64_t mult_p = sext((mult_a * x_a) >> 22, 24);        // w_3_y
+    int64_t y = sext(mult_p + seg->c_0, 31);                // r_o
+
+    return (uint32_t)(y >> 3) & 0x7FFFFFF;
+}
+
+//
+// pp_fcn_sqrt: x (1,0,19) -> y (1,16) ~ sqrt(1+x) or sqrt(2*(1+x))
+//
+static inline uint32_t eval_sqrt(const boxmuller_t *bm, uint32_t x) {
+    const boxmuller_sqrt_seg_t *seg = &bm->sqrt[x >> 13];
+    int32_t y = (int32_t)((uint32_t) seg->c_0 + (uint32_t)(seg->c_1 * (int32_t)(x & 0x1FFF))); // r_2_y
+
+    return 0x10000 | (((uint32_t) y >> 15) & 0xFFFF);
+}
+
+//
+// pp_fcn_trig: x (0,14) -> sin(pi/2*x), cos(pi/2*x) (2,16)
+//
+static inline void eval_trig(const boxmuller_t *bm, uint32_t x, int32_t *y_sin, int32_t *y_cos) {
+    const boxmuller_trig_seg_t *seg = &bm->trig[x >> 7];
+    int32_t x_a = x & 0x7F;
+
+    *y_sin = sext(seg->c_0_sin + seg->c_1_sin * x_a, 26) >> 8;
+    *y_cos = sext(seg->c_0_cos + seg->c_1_cos * x_a, 26) >> 8;
+}
+
+//
+// f = sqrt(e), e (7,24) -> f (5,13), range reduction to [1,4)
+//
+static inline int64_t stage_f(const boxmuller_t *bm, uint32_t e) {
+    int exp_f = __builtin_clz((e << 1) | 1) - 6;                        // r_f_exp
+    uint32_t x_f = exp_f >= 0 ? (e << exp_f) & 0x7FFFFFFF : e >> -exp_f; // w_f_x
+    x_f = ((uint32_t)(exp_f & 1) << 24) | (x_f & 0xFFFFFF);            // r_f_x
+
+    uint32_t y_f = eval_sqrt(bm, x_f >> 5);                             // r_f_y
+
+    int rec_f = -exp_f;                                                 // r_f_exp_d(7)
+    rec_f -= rec_f & 1;                                                 // r_f_exp_d(8)
+    uint32_t w_f = rec_f >= 0 ? (y_f << (rec_f >> 1)) & 0xFFFFF : y_f >> (-rec_f >> 1);
+    return w_f >> 3;                                                    // r_f (5,13)
+}
+
+//
+// g_0 = sin(2 pi u_1), g_1 = cos(2 pi u_1), (2,16)
+//
+static inline void stage_g(const boxmuller_t *bm, uint32_t u_1, int64_t *g_0, int64_t *g_1) {
+    int32_t y_sin, y_cos;
+    eval_trig(bm, u_1 & 0x3FFF, &y_sin, &y_cos);
+
+    int quad = (u_1 >> 14) & 0x3;
+    int32_t a = (quad & 1) ? y_cos : y_sin;
+    int32_t b = (quad & 1) ? y_sin : y_cos;
+    *g_0 = (quad & 2) ? -a : a;
+    *g_1 = ((quad + 1) & 2) ? -b : b;
+}
+
+static inline void transform(const boxmuller_t *bm, uint64_t u_0, uint32_t u_1, uint32_t u_2, int16_t *x) {
+    //
+    // e = -2 ln(u) = 2 * (exp_e * ln(2) - ln(1 + u_2)), u = 2^-exp_e * (1 + u_2)
+    //
+    int64_t exp_e = (u_0 ? __builtin_clzll(u_0) - 16 : 48) + 1;       // r_e_exp
+    int64_t y_e = eval_ln(bm, u_2) >> 1;                                // r_e_y
+    int64_t e_int = sext(exp_e * LN2 - y_e, 34);                        // r_e_int
+    uint32_t e = (uint32_t)(e_int >> 1) & 0x7FFFFFFF;                   // r_e (7,24)
+
+    int64_t f = stage_f(bm, e);
+
+    int64_t g_0, g_1;
+    stage_g(bm, u_1, &g_0, &g_1);
+
+    x[0] = (int16_t)((f * g_0) >> 18);
+    x[1] = (int16_t)((f * g_1) >> 18);
+}
+
+void boxmuller_eval(const boxmuller_t *bm, uint64_t u_0, uint32_t u_1, uint32_t u_2, int16_t *x) {
+    transform(bm, u_0 & 0xFFFFFFFFFFFFUL, u_1 & 0xFFFF, u_2 & 0x7FFFFFFF, x);
+}
+
+uint32_t boxmuller_eval_ln(const boxmuller_t *bm, uint32_t u_2) {
+    return eval_ln(bm, u_2 & 0x7FFFFFFF);
+}
+
+uint32_t boxmuller_eval_sqrt(const boxmuller_t *bm, uint32_t x) {
+    return eval_sqrt(bm, x & 0xFFFFF);
+}
+
+uint32_t boxmuller_eval_f(const boxmuller_t *bm, uint32_t e) {
+    return (uint32_t) stage_f(bm, e & 0x7FFFFFFF);
+}
+
+void boxmuller_eval_g(const boxmuller_t *bm, uint32_t u_1, int32_t *g) {
+    int64_t g_0, g_1;
+    stage_g(bm, u_1 & 0xFFFF, &g_0, &g_1);
+    g[0] = (int32_t) g_0;
+    g[1] = (int32_t) g_1;
+}
+
+void boxmuller_generate_scalar(const boxmuller_t *bm, const uint32_t *u, size_t n, int16_t *x) {
+    for (size_t i = 0; i < n; i++, u += 3, x += 2)
+        transform(bm, BOXMULLER_U_0(u), BOXMULLER_U_1(u), BOXMULLER_U_2(u), x);
+}
+
+void boxmuller_generate(const boxmuller_t *bm, const uint32_t *u, size_t n, int16_t *x) {
+    switch (bm->isa) {
+#ifdef BOXMULLER_HAVE_AVX512
+    case BOXMULLER_ISA_AVX512:
+        boxmuller_generate_avx512(bm, u, n, x);
+        return;
+#endif
+#ifdef BOXMULLER_HAVE_AVX2
+    case BOXMULLER_ISA_AVX2:
+        boxmuller_generate_avx2(bm, u, n, x);
+        return;
+#endif
+    default:
+        boxmuller_generate_scalar(bm, u, n, x);
+        return;
+    }
+}
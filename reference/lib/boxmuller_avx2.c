@@ -0,0 +1,160 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <immintrin.h>
+
+#include "boxmuller.h"
+#include "boxmuller_kernels.h"
+#include "boxmuller_datapath.h"
+
+/*
+ * AVX2 implementation of boxmuller_generate, 8 samples per iteration.
+ * Every step mirrors transform() in boxmuller.c; see there for the mapping to
+ * the VHDL registers.
+ */
+
+// Sign extends the lower n bits of each 32-bit lane
+#define SEXT(X, N) _mm256_srai_epi32(_mm256_slli_epi32((X), 32 - (N)), 32 - (N))
+
+// floor(log2(x)) for 0 < x < 2^31; the bit below the leading one is cleared, so
+// that the conversion can not round up to the next power of two. x = 0 yields -127.
+static inline __m256i ilog2(__m256i x) {
+    x = _mm256_andnot_si256(_mm256_srli_epi32(x, 1), x);
+    __m256i bits = _mm256_castps_si256(_mm256_cvtepi32_ps(x));
+    return _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+}
+
+// Bits 22+31..22 of the signed 32x32-bit products of all eight lanes
+static inline __m256i mul_shr22(__m256i a, __m256i b) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 22);
+    __m256i odd = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), 10);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+// Bits 18+31..18 of the signed 32x32-bit products of all eight lanes
+static inline __m256i mul_shr18(__m256i a, __m256i b) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 18);
+    __m256i odd = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), 14);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+// Shifts left for s >= 0, right for s < 0
+static inline __m256i shift_lr(__m256i x, __m256i s) {
+    __m256i zero = _mm256_setzero_si256();
+    x = _mm256_sllv_epi32(x, _mm256_max_epi32(s, zero));
+    return _mm256_srlv_epi32(x, _mm256_max_epi32(_mm256_sub_epi32(zero, s), zero));
+}
+
+// Negates lanes where the mask is all ones
+static inline __m256i cond_neg(__m256i x, __m256i mask) {
+    return _mm256_sub_epi32(_mm256_xor_si256(x, mask), mask);
+}
+
+static inline __m256i transform(const boxmuller_t *bm, __m256i w_0, __m256i w_1, __m256i w_2) {
+    const int *ln = (const int *) bm->ln;
+    const int *sqrt = (const int *) bm->sqrt;
+    const int *trig = (const int *) bm->trig;
+
+    __m256i mask_24 = _mm256_set1_epi32(0xFFFFFF);
+
+    //
+    // Split u: u_0 = u(48 downto 1) as two 24-bit halves, u_1 = u(64 downto 49), u_2 = u(95 downto 65)
+    //
+    __m256i u_0_hi = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi32(w_1, 7), _mm256_srli_epi32(w_0, 25)), mask_24);
+    __m256i u_0_lo = _mm256_and_si256(_mm256_srli_epi32(w_0, 1), mask_24);
+    __m256i u_1 = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi32(w_1, 17), _mm256_slli_epi32(w_2, 15)), _mm256_set1_epi32(0xFFFF));
+    __m256i u_2 = _mm256_srli_epi32(w_2, 1);
+
+    //
+    // exp_e = lzd_48(u_0) + 1; both halves convert to float exactly
+    //
+    __m256i lz = _mm256_min_epi32(_mm256_sub_epi32(_mm256_set1_epi32(23), ilog2(u_0_hi)),
+                                  _mm256_sub_epi32(_mm256_set1_epi32(47), ilog2(u_0_lo)));
+    __m256i exp_e = _mm256_add_epi32(_mm256_min_epi32(lz, _mm256_set1_epi32(48)), _mm256_set1_epi32(1));
+
+    //
+    // pp_fcn_ln
+    //
+    __m256i seg = _mm256_slli_epi32(_mm256_srli_epi32(u_2, 23), 2);
+    __m256i c_0 = _mm256_i32gather_epi32(ln + 0, seg, 4);
+    __m256i c_1 = _mm256_i32gather_epi32(ln + 1, seg, 4);
+    __m256i c_2 = _mm256_i32gather_epi32(ln + 2, seg, 4);
+
+    __m256i x_a = _mm256_srli_epi32(_mm256_and_si256(u_2, _mm256_set1_epi32(0x7FFFFF)), 1);
+    __m256i eta_2 = _mm256_mullo_epi32(c_2, _mm256_srli_epi32(x_a, 9));
+    __m256i mult_a = SEXT(_mm256_add_epi32(c_1, _mm256_srai_epi32(eta_2, 13)), 23);
+    __m256i mult_p = SEXT(mul_shr22(mult_a, x_a), 24);
+    __m256i y = SEXT(_mm256_add_epi32(mult_p, c_0), 31);
+    __m256i y_e = _mm256_and_si256(_mm256_srli_epi32(y, 4), _mm256_set1_epi32(0x3FFFFFF));
+
+    // Only bits 31..1 of the 34-bit r_e_int are used; exp_e * LN2 < 2^32
+    __m256i e_int = _mm256_sub_epi32(_mm256_mullo_epi32(exp_e, _mm256_set1_epi32(LN2)), y_e);
+    __m256i e = _mm256_srli_epi32(e_int, 1);
+
+    //
+    // f = sqrt(e)
+    //
+    __m256i p = _mm256_min_epi32(_mm256_sub_epi32(_mm256_set1_epi32(30), ilog2(e)), _mm256_set1_epi32(31));
+    __m256i exp_f = _mm256_sub_epi32(p, _mm256_set1_epi32(6));
+    __m256i x_f = _mm256_and_si256(shift_lr(e, exp_f), mask_24);
+    x_f = _mm256_or_si256(x_f, _mm256_slli_epi32(_mm256_and_si256(exp_f, _mm256_set1_epi32(1)), 24));
+
+    seg = _mm256_slli_epi32(_mm256_srli_epi32(x_f, 18), 1);
+    c_0 = _mm256_i32gather_epi32(sqrt + 0, seg, 4);
+    c_1 = _mm256_i32gather_epi32(sqrt + 1, seg, 4);
+
+    __m256i s_x = _mm256_and_si256(_mm256_srli_epi32(x_f, 5), _mm256_set1_epi32(0x1FFF));
+    y = _mm256_add_epi32(c_0, _mm256_mullo_epi32(c_1, s_x));
+    __m256i y_f = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(y, 15), _mm256_set1_epi32(0xFFFF)), _mm256_set1_epi32(0x10000));
+
+    __m256i rec_f = _mm256_sub_epi32(_mm256_setzero_si256(), exp_f);
+    rec_f = _mm256_srai_epi32(rec_f, 1);
+    __m256i f = _mm256_srli_epi32(_mm256_and_si256(shift_lr(y_f, rec_f), _mm256_set1_epi32(0xFFFFF)), 3);
+
+    //
+    // sin/cos, the segment lookup is shared
+    //
+    __m256i x_g = _mm256_and_si256(u_1, _mm256_set1_epi32(0x3FFF));
+    seg = _mm256_slli_epi32(_mm256_srli_epi32(x_g, 7), 2);
+    __m256i x_g_a = _mm256_and_si256(x_g, _mm256_set1_epi32(0x7F));
+
+    __m256i c_0_sin = _mm256_i32gather_epi32(trig + 0, seg, 4);
+    __m256i c_1_sin = _mm256_i32gather_epi32(trig + 1, seg, 4);
+    __m256i c_0_cos = _mm256_i32gather_epi32(trig + 2, seg, 4);
+    __m256i c_1_cos = _mm256_i32gather_epi32(trig + 3, seg, 4);
+
+    __m256i y_sin = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_add_epi32(c_0_sin, _mm256_mullo_epi32(c_1_sin, x_g_a)), 6), 14);
+    __m256i y_cos = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_add_epi32(c_0_cos, _mm256_mullo_epi32(c_1_cos, x_g_a)), 6), 14);
+
+    // Branch-free quadrant select
+    __m256i quad = _mm256_srli_epi32(u_1, 14);
+    __m256i swap = _mm256_cmpeq_epi32(_mm256_and_si256(quad, _mm256_set1_epi32(1)), _mm256_set1_epi32(1));
+    __m256i neg_0 = _mm256_cmpeq_epi32(_mm256_and_si256(quad, _mm256_set1_epi32(2)), _mm256_set1_epi32(2));
+    __m256i neg_1 = _mm256_xor_si256(neg_0, swap);
+
+    __m256i g_0 = cond_neg(_mm256_blendv_epi8(y_sin, y_cos, swap), neg_0);
+    __m256i g_1 = cond_neg(_mm256_blendv_epi8(y_cos, y_sin, swap), neg_1);
+
+    //
+    // x = f * g, pack x_0 and x_1 of each sample into one 32-bit lane
+    //
+    __m256i x_0 = _mm256_and_si256(mul_shr18(f, g_0), _mm256_set1_epi32(0xFFFF));
+    __m256i x_1 = _mm256_slli_epi32(mul_shr18(f, g_1), 16);
+
+    return _mm256_or_si256(x_0, x_1);
+}
+
+void boxmuller_generate_avx2(const boxmuller_t *bm, const uint32_t *u, size_t n, int16_t *x) {
+    const __m256i idx = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, u += 3 * 8, x += 2 * 8) {
+        __m256i w_0 = _mm256_i32gather_epi32((const int *) u + 0, idx, 4);
+        __m256i w_1 = _mm256_i32gather_epi32((const int *) u + 1, idx, 4);
+        __m256i w_2 = _mm256_i32gather_epi32((const int *) u + 2, idx, 4);
+
+        _mm256_storeu_si256((__m256i *) x, transform(bm, w_0, w_1, w_2));
+    }
+
+    boxmuller_generate_scalar(bm, u, n - i, x);
+}
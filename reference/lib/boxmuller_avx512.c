@@ -0,0 +1,142 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <immintrin.h>
+
+#include "boxmuller.h"
+#include "boxmuller_kernels.h"
+#include "boxmuller_datapath.h"
+
+/*
+ * AVX-512 (F + CD) implementation of boxmuller_generate, 16 samples per
+ * iteration. Every step mirrors transform() in boxmuller.c; see there for the
+ * mapping to the VHDL registers.
+ */
+
+// Sign extends the lower n bits of each 32-bit lane
+#define SEXT(X, N) _mm512_srai_epi32(_mm512_slli_epi32((X), 32 - (N)), 32 - (N))
+
+// Bits S+31..S of the signed 32x32-bit products of all sixteen lanes
+static inline __m512i mul_shr(__m512i a, __m512i b, const int s) {
+    __m512i even = _mm512_srli_epi64(_mm512_mul_epi32(a, b), s);
+    __m512i odd = _mm512_slli_epi64(_mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32)), 32 - s);
+    return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+}
+
+// Shifts left for s >= 0, right for s < 0
+static inline __m512i shift_lr(__m512i x, __m512i s) {
+    __m512i zero = _mm512_setzero_si512();
+    x = _mm512_sllv_epi32(x, _mm512_max_epi32(s, zero));
+    return _mm512_srlv_epi32(x, _mm512_max_epi32(_mm512_sub_epi32(zero, s), zero));
+}
+
+static inline __m512i transform(const boxmuller_t *bm, __m512i w_0, __m512i w_1, __m512i w_2) {
+    const int *ln = (const int *) bm->ln;
+    const int *sqrt = (const int *) bm->sqrt;
+    const int *trig = (const int *) bm->trig;
+
+    __m512i zero = _mm512_setzero_si512();
+
+    //
+    // Split u: u_0 = u(48 downto 1) as 32 + 16 bits, u_1 = u(64 downto 49), u_2 = u(95 downto 65)
+    //
+    __m512i u_0_hi = _mm512_or_si512(_mm512_slli_epi32(w_1, 15), _mm512_srli_epi32(w_0, 17));
+    __m512i u_0_lo = _mm512_and_si512(_mm512_srli_epi32(w_0, 1), _mm512_set1_epi32(0xFFFF));
+    __m512i u_1 = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi32(w_1, 17), _mm512_slli_epi32(w_2, 15)), _mm512_set1_epi32(0xFFFF));
+    __m512i u_2 = _mm512_srli_epi32(w_2, 1);
+
+    //
+    // exp_e = lzd_48(u_0) + 1
+    //
+    __mmask16 hi_zero = _mm512_cmpeq_epi32_mask(u_0_hi, zero);
+    __m512i lz = _mm512_mask_add_epi32(_mm512_lzcnt_epi32(u_0_hi), hi_zero,
+                                       _mm512_lzcnt_epi32(u_0_lo), _mm512_set1_epi32(16));
+    __m512i exp_e = _mm512_add_epi32(lz, _mm512_set1_epi32(1));
+
+    //
+    // pp_fcn_ln
+    //
+    __m512i seg = _mm512_slli_epi32(_mm512_srli_epi32(u_2, 23), 2);
+    __m512i c_0 = _mm512_i32gather_epi32(seg, ln + 0, 4);
+    __m512i c_1 = _mm512_i32gather_epi32(seg, ln + 1, 4);
+    __m512i c_2 = _mm512_i32gather_epi32(seg, ln + 2, 4);
+
+    __m512i x_a = _mm512_srli_epi32(_mm512_and_si512(u_2, _mm512_set1_epi32(0x7FFFFF)), 1);
+    __m512i eta_2 = _mm512_mullo_epi32(c_2, _mm512_srli_epi32(x_a, 9));
+    __m512i mult_a = SEXT(_mm512_add_epi32(c_1, _mm512_srai_epi32(eta_2, 13)), 23);
+    __m512i mult_p = SEXT(mul_shr(mult_a, x_a, 22), 24);
+    __m512i y = SEXT(_mm512_add_epi32(mult_p, c_0), 31);
+    __m512i y_e = _mm512_and_si512(_mm512_srli_epi32(y, 4), _mm512_set1_epi32(0x3FFFFFF));
+
+    // Only bits 31..1 of the 34-bit r_e_int are used; exp_e * LN2 < 2^32
+    __m512i e_int = _mm512_sub_epi32(_mm512_mullo_epi32(exp_e, _mm512_set1_epi32(LN2)), y_e);
+    __m512i e = _mm512_srli_epi32(e_int, 1);
+
+    //
+    // f = sqrt(e)
+    //
+    __m512i p = _mm512_lzcnt_epi32(_mm512_or_si512(_mm512_slli_epi32(e, 1), _mm512_set1_epi32(1)));
+    __m512i exp_f = _mm512_sub_epi32(p, _mm512_set1_epi32(6));
+    __m512i x_f = _mm512_and_si512(shift_lr(e, exp_f), _mm512_set1_epi32(0xFFFFFF));
+    x_f = _mm512_or_si512(x_f, _mm512_slli_epi32(_mm512_and_si512(exp_f, _mm512_set1_epi32(1)), 24));
+
+    seg = _mm512_slli_epi32(_mm512_srli_epi32(x_f, 18), 1);
+    c_0 = _mm512_i32gather_epi32(seg, sqrt + 0, 4);
+    c_1 = _mm512_i32gather_epi32(seg, sqrt + 1, 4);
+
+    __m512i s_x = _mm512_and_si512(_mm512_srli_epi32(x_f, 5), _mm512_set1_epi32(0x1FFF));
+    y = _mm512_add_epi32(c_0, _mm512_mullo_epi32(c_1, s_x));
+    __m512i y_f = _mm512_or_si512(_mm512_and_si512(_mm512_srli_epi32(y, 15), _mm512_set1_epi32(0xFFFF)), _mm512_set1_epi32(0x10000));
+
+    __m512i rec_f = _mm512_srai_epi32(_mm512_sub_epi32(zero, exp_f), 1);
+    __m512i f = _mm512_srli_epi32(_mm512_and_si512(shift_lr(y_f, rec_f), _mm512_set1_epi32(0xFFFFF)), 3);
+
+    //
+    // sin/cos, the segment lookup is shared
+    //
+    __m512i x_g = _mm512_and_si512(u_1, _mm512_set1_epi32(0x3FFF));
+    seg = _mm512_slli_epi32(_mm512_srli_epi32(x_g, 7), 2);
+    __m512i x_g_a = _mm512_and_si512(x_g, _mm512_set1_epi32(0x7F));
+
+    __m512i c_0_sin = _mm512_i32gather_epi32(seg, trig + 0, 4);
+    __m512i c_1_sin = _mm512_i32gather_epi32(seg, trig + 1, 4);
+    __m512i c_0_cos = _mm512_i32gather_epi32(seg, trig + 2, 4);
+    __m512i c_1_cos = _mm512_i32gather_epi32(seg, trig + 3, 4);
+
+    __m512i y_sin = _mm512_srai_epi32(_mm512_slli_epi32(_mm512_add_epi32(c_0_sin, _mm512_mullo_epi32(c_1_sin, x_g_a)), 6), 14);
+    __m512i y_cos = _mm512_srai_epi32(_mm512_slli_epi32(_mm512_add_epi32(c_0_cos, _mm512_mullo_epi32(c_1_cos, x_g_a)), 6), 14);
+
+    // Branch-free quadrant select
+    __m512i quad = _mm512_srli_epi32(u_1, 14);
+    __mmask16 swap = _mm512_test_epi32_mask(quad, _mm512_set1_epi32(1));
+    __mmask16 neg_0 = _mm512_test_epi32_mask(quad, _mm512_set1_epi32(2));
+    __mmask16 neg_1 = neg_0 ^ swap;
+
+    __m512i g_0 = _mm512_mask_blend_epi32(swap, y_sin, y_cos);
+    __m512i g_1 = _mm512_mask_blend_epi32(swap, y_cos, y_sin);
+    g_0 = _mm512_mask_sub_epi32(g_0, neg_0, zero, g_0);
+    g_1 = _mm512_mask_sub_epi32(g_1, neg_1, zero, g_1);
+
+    //
+    // x = f * g, pack x_0 and x_1 of each sample into one 32-bit lane
+    //
+    __m512i x_0 = _mm512_and_si512(mul_shr(f, g_0, 18), _mm512_set1_epi32(0xFFFF));
+    __m512i x_1 = _mm512_slli_epi32(mul_shr(f, g_1, 18), 16);
+
+    return _mm512_or_si512(x_0, x_1);
+}
+
+void boxmuller_generate_avx512(const boxmuller_t *bm, const uint32_t *u, size_t n, int16_t *x) {
+    const __m512i idx = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16, u += 3 * 16, x += 2 * 16) {
+        __m512i w_0 = _mm512_i32gather_epi32(idx, (const int *) u + 0, 4);
+        __m512i w_1 = _mm512_i32gather_epi32(idx, (const int *) u + 1, 4);
+        __m512i w_2 = _mm512_i32gather_epi32(idx, (const int *) u + 2, 4);
+
+        _mm512_storeu_si512((__m512i *) x, transform(bm, w_0, w_1, w_2));
+    }
+
+    boxmuller_generate_scalar(bm, u, n - i, x);
+}
@@ -0,0 +1,16 @@
+#ifndef H_BOXMULLER_DATAPATH
+#define H_BOXMULLER_DATAPATH
+
+/*
+ * Constants and helpers of the boxmuller.vhd datapath, shared by the models
+ * of boxmuller_generate and of grng_16.
+ */
+
+#define LN2 46516319L // = ln(2) * 2^26, see boxmuller.vhd
+
+// Sign extends the lower n bits of x
+static inline int64_t sext(int64_t x, int n) {
+    return (int64_t)((uint64_t) x << (64 - n)) >> (64 - n);
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "boxmuller.h"
+#include "boxmuller_errmap.h"
+
+const boxmuller_unit_info_t BOXMULLER_UNITS[BOXMULLER_UNIT_COUNT] = {
+    [BOXMULLER_UNIT_LN]   = { "ln",   31, 256, -27 },
+    [BOXMULLER_UNIT_SQRT] = { "sqrt", 20, 128, -16 },
+    [BOXMULLER_UNIT_F]    = { "f",    31, 32,  -13 },
+    [BOXMULLER_UNIT_SIN]  = { "sin",  16, 512, -16 },
+    [BOXMULLER_UNIT_COS]  = { "cos",  16, 512, -16 },
+};
+
+size_t boxmuller_errmap_bin(boxmuller_unit_t unit, uint32_t x) {
+    switch (unit) {
+    case BOXMULLER_UNIT_LN:
+        return x >> 23;
+    case BOXMULLER_UNIT_SQRT:
+        return x >> 13;
+    case BOXMULLER_UNIT_F:
+        // exp_f + 6, see r_f_exp
+        return __builtin_clz((x << 1) | 1);
+    default:
+        return x >> 7;
+    }
+}
+
+double boxmuller_errmap_eval(const boxmuller_t *bm, boxmuller_unit_t unit, uint32_t x, double *y, double *y_ref) {
+    double out, ref;
+    int32_t g[2];
+
+    switch (unit) {
+    case BOXMULLER_UNIT_LN:
+        out = ldexp(boxmuller_eval_ln(bm, x), -27);
+        ref = log1p(ldexp(x, -31));
+        break;
+    case BOXMULLER_UNIT_SQRT:
+        out = ldexp(boxmuller_eval_sqrt(bm, x), -16);
+        ref = sqrt((1 + ldexp(x & 0x7FFFF, -19)) * (x >> 19 ? 2 : 1));
+        break;
+    case BOXMULLER_UNIT_F:
+        out = ldexp(boxmuller_eval_f(bm, x), -13);
+        ref = sqrt(ldexp(x, -24));
+        break;
+    case BOXMULLER_UNIT_SIN:
+        boxmuller_eval_g(bm, x, g);
+        out = ldexp(g[0], -16);
+        ref = sin(2 * M_PI * ldexp(x, -16));
+        break;
+    default:
+        boxmuller_eval_g(bm, x, g);
+        out = ldexp(g[1], -16);
+        ref = cos(2 * M_PI * ldexp(x, -16));
+        break;
+    }
+
+    if (y)
+        *y = out;
+    if (y_ref)
+        *y_ref = ref;
+    return out - ref;
+}
+
+static inline void err_add(boxmuller_err_t *bin, uint32_t x, double err) {
+    double a = fabs(err);
+
+    bin->n++;
+    bin->sum += err;
+    bin->sum_abs += a;
+    if (a > bin->max_abs || bin->n == 1) {
+        bin->max_abs = a;
+        bin->worst = x;
+    }
+}
+
+void boxmuller_errmap_sweep(const boxmuller_t *bm, boxmuller_unit_t unit, uint64_t begin, uint64_t end,
+        boxmuller_err_t *bins) {
+    for (uint64_t x = begin; x < end; x++)
+        err_add(&bins[boxmuller_errmap_bin(unit, x)], x, boxmuller_errmap_eval(bm, unit, x, NULL, NULL));
+}
+
+void boxmuller_err_merge(boxmuller_err_t *acc, const boxmuller_err_t *b) {
+    if (!b->n)
+        return;
+
+    if (!acc->n || b->max_abs > acc->max_abs || (b->max_abs == acc->max_abs && b->worst < acc->worst)) {
+        acc->max_abs = b->max_abs;
+        acc->worst = b->worst;
+    }
+
+    acc->n += b->n;
+    acc->sum += b->sum;
+    acc->sum_abs += b->sum_abs;
+}
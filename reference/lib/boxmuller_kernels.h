@@ -0,0 +1,17 @@
+#ifndef H_BOXMULLER_KERNELS
+#define H_BOXMULLER_KERNELS
+
+/*
+ * Instruction set specific implementations of boxmuller_generate. The SIMD
+ * kernels are compiled with their own target flags and must only be called
+ * after checking boxmuller_isa_supported. They fall back to the scalar kernel
+ * for the remainder of n that does not fill a full vector.
+ */
+
+void boxmuller_generate_scalar(const boxmuller_t *bm, const uint32_t *u, size_t n, int16_t *x);
+
+void boxmuller_generate_avx2(const boxmuller_t *bm, const uint32_t *u, size_t n, int16_t *x);
+
+void boxmuller_generate_avx512(const boxmuller_t *bm, const uint32_t *u, size_t n, int16_t *x);
+
+#endif
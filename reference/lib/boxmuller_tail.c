@@ -0,0 +1,116 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "xoroshiro128plus.h"
+#include "urng.h"
+#include "boxmuller.h"
+#include "boxmuller_tail.h"
+
+// u_0 with lz leading zeros is (1 << shift) | (any shift bits), or 0 for lz = 48
+#define STRATUM_SHIFT(LZ) ((LZ) == 48 ? 0 : 47 - (LZ))
+
+boxmuller_tail_t *boxmuller_tail_new(const boxmuller_t *bm, double threshold) {
+    // (5,11) can't represent |x| >= 16
+    if (!(threshold < 16))
+        return NULL;
+
+    boxmuller_tail_t *tail = calloc(1, sizeof(boxmuller_tail_t));
+    tail->threshold = threshold;
+
+    // Code c stands for [c, c + 1) * 2^-11, which is above the threshold
+    // (but for its lower edge) iff c >= ceil(threshold * 2^11)
+    tail->threshold_code = threshold < 0 ? 0 : (int32_t) ceil(threshold * 2048);
+
+    // f, and with it the admissible set of u_1, shrinks with lz, so the
+    // strata end at the first lz that can't reach the threshold
+    uint16_t *u_1 = malloc(0x10000 * sizeof(uint16_t));
+    unsigned __int128 count = 0;
+
+    for (int lz = 48; lz >= 0; lz--) {
+        uint64_t u_0 = lz == 48 ? 0 : UINT64_C(1) << (47 - lz);
+
+        uint32_t n = 0;
+        for (uint32_t j = 0; j < 0x10000; j++) {
+            int16_t x[2];
+            boxmuller_eval(bm, u_0, j, 0, x);
+            if (boxmuller_tail_accept(tail, x[0]) || boxmuller_tail_accept(tail, x[1]))
+                u_1[n++] = j;
+        }
+
+        if (!n)
+            break;
+
+        boxmuller_tail_stratum_t *s = &tail->strata[tail->n_strata++];
+        s->lz = lz;
+        s->n_u_1 = n;
+        s->u_1 = malloc(n * sizeof(uint16_t));
+        for (uint32_t j = 0; j < n; j++)
+            s->u_1[j] = u_1[j];
+
+        count += (unsigned __int128) n << STRATUM_SHIFT(lz);
+    }
+
+    free(u_1);
+
+    if (!tail->n_strata) {
+        free(tail);
+        return NULL;
+    }
+
+    // count <= 2^16 * 2^48
+    tail->count = (uint64_t) count;
+    tail->weight = (double) count / 18446744073709551616.0;
+
+    return tail;
+}
+
+void boxmuller_tail_free(boxmuller_tail_t *tail) {
+    for (int i = 0; i < tail->n_strata; i++)
+        free(tail->strata[i].u_1);
+    free(tail);
+}
+
+// Uniform integer in [0, n), n = 0 meaning 2^64. Lemire's multiply-shift with
+// exact rejection.
+static uint64_t draw_index(urng_t *g, uint64_t n) {
+    uint64_t r = urng_next(g);
+    if (!n)
+        return r;
+
+    unsigned __int128 m = (unsigned __int128) r * n;
+    if ((uint64_t) m < n) {
+        uint64_t t = -n % n;
+        while ((uint64_t) m < t)
+            m = (unsigned __int128) urng_next(g) * n;
+    }
+    return (uint64_t)(m >> 64);
+}
+
+void boxmuller_tail_draw(const boxmuller_tail_t *tail, urng_t *g, uint32_t *u, size_t n) {
+    for (size_t i = 0; i < n; i++, u += 3) {
+        // Enumerates the (u_0, u_1) pairs stratum by stratum, the largest
+        // (lowest lz) stratum is the last one
+        uint64_t idx = draw_index(g, tail->count);
+        const boxmuller_tail_stratum_t *s = &tail->strata[tail->n_strata - 1];
+        for (;;) {
+            uint64_t size = (uint64_t) s->n_u_1 << STRATUM_SHIFT(s->lz);
+            if (idx < size || s == tail->strata)
+                break;
+            idx -= size;
+            s--;
+        }
+
+        int shift = STRATUM_SHIFT(s->lz);
+        uint64_t u_0 = s->lz == 48 ? 0 : (UINT64_C(1) << shift) | (idx & ((UINT64_C(1) << shift) - 1));
+        uint64_t u_1 = s->u_1[idx >> shift];
+        uint64_t u_2 = urng_next(g) >> 33;
+
+        // u(48 downto 1) = u_0, u(64 downto 49) = u_1, u(95 downto 65) = u_2
+        uint64_t lo = (u_0 << 1) | (u_1 << 49);
+        u[0] = (uint32_t) lo;
+        u[1] = (uint32_t)(lo >> 32);
+        u[2] = (uint32_t)((u_1 >> 15) | (u_2 << 1));
+    }
+}
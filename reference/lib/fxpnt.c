@@ -39,25 +39,14 @@ void fxpnt_free(fxpnt_cfg_t *cfg) {
 }
 
 fxpnt_t fxpnt_mult(fxpnt_cfg_t *cfg, fxpnt_t a, fxpnt_t b) {
-    bool sign_a = a < 0;
-    bool sign_b = b < 0;
+    bool sign = (a < 0) ^ (b < 0);
 
-    if (sign_a)
-        a = -a;
-    if (sign_b)
-        b = -b;
+    // Product of the magnitudes, truncated towards zero
+    uint64_t m_a = a < 0 ? -(uint64_t) a : (uint64_t) a;
+    uint64_t m_b = b < 0 ? -(uint64_t) b : (uint64_t) b;
+    uint64_t z = (uint64_t)(((unsigned __int128) m_a * m_b) >> cfg->n_f);
 
-    bool sign = sign_a ^ sign_b;
-    
-    uint64_t a_i = FXPNT_INT(cfg, a);
-    uint64_t a_f = FXPNT_FRAC(cfg, a);
-    uint64_t b_i = FXPNT_INT(cfg, b);
-    uint64_t b_f = FXPNT_FRAC(cfg, b);
-
-    uint64_t z_f = (a_f * b_f >> cfg->n_f) + a_i * b_f + b_i * a_f;
-    uint64_t z_i = a_i * b_i + (z_f >> cfg->n_f);
-
-    fxpnt_t ret = fxpnt_new(cfg, z_i, z_f);
+    fxpnt_t ret = fxpnt_new(cfg, FXPNT_INT(cfg, z), FXPNT_FRAC(cfg, z));
     return sign ? -ret : ret;
 }
 
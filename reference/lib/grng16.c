@@ -0,0 +1,286 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "xoroshiro128plus.h"
+#include "xoro_seeds.h"
+#include "boxmuller.h"
+#include "grng16.h"
+#include "boxmuller_datapath.h"
+
+grng16_t *grng16_new(unsigned seed_base) {
+    if ((uint64_t) seed_base * GRNG16_XORO_COUNT + GRNG16_XORO_COUNT > XORO_SEEDS_LENGTH)
+        return NULL;
+
+    grng16_t *g = calloc(1, sizeof(grng16_t));
+    g->bm = boxmuller_new();
+    g->seed_base = seed_base;
+    return g;
+}
+
+void grng16_free(grng16_t *g) {
+    boxmuller_free(g->bm);
+    free(g);
+}
+
+//
+// shifter_lr: 3 stages, sync reset. c >= 0 shifts left, c < 0 right, by
+// |c| >> c_shift, in data_width bits.
+//
+static inline void shifter_clock(grng16_bm_t *r, int i, uint32_t din, int32_t c, int c_shift, int data_width) {
+    uint32_t mask = (uint32_t)((UINT64_C(1) << data_width) - 1);
+
+    // Postprocessing
+    r->sh_dout[i] = r->sh_data_0[i];
+
+    // shift_0, the right shift is sll of the reversed vector
+    uint32_t s = r->sh_c[i];
+    if (s >= (uint32_t) data_width)
+        r->sh_data_0[i] = 0;
+    else
+        r->sh_data_0[i] = r->sh_neg[i] ? r->sh_data[i] >> s : (r->sh_data[i] << s) & mask;
+    r->sh_neg_0[i] = r->sh_neg[i];
+
+    // Preprocessing
+    r->sh_data[i] = din & mask;
+    r->sh_neg[i] = c < 0;
+    r->sh_c[i] = ((uint32_t)(c < 0 ? -c : c) & 0x3F) >> c_shift;
+}
+
+static inline void shifter_reset(grng16_bm_t *r, int i) {
+    r->sh_data[i] = r->sh_c[i] = r->sh_data_0[i] = r->sh_dout[i] = 0;
+    r->sh_neg[i] = r->sh_neg_0[i] = 0;
+}
+
+static void bm_reset(grng16_bm_t *r) {
+    r->lzd_e_p = 0;
+    r->lzd_f_p = 0;
+    shifter_reset(r, 0);
+    shifter_reset(r, 1);
+}
+
+//
+// One enabled edge of boxmuller.vhd and its function units. The stages are
+// updated from the output to the input, so every register still reads the
+// value of its predecessor before the edge.
+//
+static inline void bm_clock(const boxmuller_t *restrict bm, grng16_bm_t *restrict r, const uint32_t *restrict u, bool reset) {
+    // Output
+    r->r_x_0 = r->r_o_0;
+    r->r_x_1 = r->r_o_1;
+    r->r_o_0 = (int64_t) r->r_f * r->r_b2_g_0;
+    r->r_o_1 = (int64_t) r->r_f * r->r_b2_g_1;
+
+    // sin/cos
+    r->r_b2_g_0 = r->r_b_g_0;
+    r->r_b2_g_1 = r->r_b_g_1;
+    r->r_b_g_0 = r->r_t_g_0;
+    r->r_b_g_1 = r->r_t_g_1;
+
+    int32_t w_t_sin = r->tr_3_y_sin >> 8;
+    int32_t w_t_cos = r->tr_3_y_cos >> 8;
+    int quad = r->r_t_quad[6];
+    int32_t a = (quad & 1) ? w_t_cos : w_t_sin;
+    int32_t b = (quad & 1) ? w_t_sin : w_t_cos;
+    r->r_t_g_0 = (quad & 2) ? sext(-a, 18) : a;
+    r->r_t_g_1 = ((quad + 1) & 2) ? sext(-b, 18) : b;
+
+    for (int i = 6; i > 0; i--)
+        r->r_t_quad[i] = r->r_t_quad[i - 1];
+    r->r_t_quad[0] = r->r_i_u_1 >> 14;
+
+    // pp_fcn_trig
+    r->tr_3_y_sin = r->tr_2_y_sin;
+    r->tr_3_y_cos = r->tr_2_y_cos;
+    r->tr_2_y_sin = sext(r->tr_1_c_0_sin + r->tr_1_y_sin, 26);
+    r->tr_2_y_cos = sext(r->tr_1_c_0_cos + r->tr_1_y_cos, 26);
+
+    const boxmuller_trig_seg_t *tr = &bm->trig[r->tr_0_seg];
+    r->tr_1_y_sin = tr->c_1_sin * r->tr_0_x;
+    r->tr_1_y_cos = tr->c_1_cos * r->tr_0_x;
+    r->tr_1_c_0_sin = tr->c_0_sin;
+    r->tr_1_c_0_cos = tr->c_0_cos;
+
+    r->tr_0_x = r->tr_r2_x;
+    r->tr_0_seg = r->tr_r2_seg;
+    r->tr_r2_x = r->tr_r_x;
+    r->tr_r2_seg = r->tr_r_seg;
+    r->tr_r_x = r->tr_i_x;
+    r->tr_r_seg = r->tr_i_seg;
+    r->tr_i_x = r->r_i_u_1 & 0x7F;
+    r->tr_i_seg = (r->r_i_u_1 >> 7) & 0x7F;
+
+    // f = sqrt(e), range reconstruction
+    r->r_f = r->sh_dout[1] >> 3;
+    if (reset)
+        shifter_reset(r, 1);
+    else
+        shifter_clock(r, 1, r->r_f_y, r->r_f_exp_d[10], 1, 20);
+
+    // pp_fcn_sqrt
+    r->r_f_y = 0x10000 | (((uint32_t) r->sq_2_y >> 15) & 0xFFFF);
+    r->sq_2_y = (int32_t)((uint32_t) r->sq_1_y + (uint32_t) r->sq_1_c_0);
+
+    const boxmuller_sqrt_seg_t *sq = &bm->sqrt[r->sq_0_seg];
+    r->sq_1_y = sq->c_1 * r->sq_0_x;
+    r->sq_1_c_0 = sq->c_0;
+
+    r->sq_0_x = r->sq_r2_x;
+    r->sq_0_seg = r->sq_r2_seg;
+    r->sq_r2_x = r->sq_r_x;
+    r->sq_r2_seg = r->sq_r_seg;
+    r->sq_r_x = r->sq_i_x;
+    r->sq_r_seg = r->sq_i_seg;
+    r->sq_i_x = (r->r_f_x >> 5) & 0x1FFF;
+    r->sq_i_seg = r->r_f_x >> 18;
+
+    // f = sqrt(e), range reduction
+    r->r_f_x = ((uint32_t)(r->r_f_exp_d[2] & 1) << 24) | (r->sh_dout[0] & 0xFFFFFF);
+    if (reset)
+        shifter_reset(r, 0);
+    else
+        shifter_clock(r, 0, r->r_f_e_1, r->r_f_exp, 0, 31);
+
+    r->r_f_exp_d[10] = r->r_f_exp_d[9];
+    r->r_f_exp_d[9] = r->r_f_exp_d[8];
+    r->r_f_exp_d[8] = sext(r->r_f_exp_d[7] - (r->r_f_exp_d[7] & 1), 6);
+    r->r_f_exp_d[7] = sext(-r->r_f_exp_d[6], 6);
+    for (int i = 6; i > 0; i--)
+        r->r_f_exp_d[i] = r->r_f_exp_d[i - 1];
+    r->r_f_exp_d[0] = r->r_f_exp;
+
+    r->r_f_exp = (int32_t) r->lzd_f_p - 6;
+    r->r_f_e_1 = r->r_f_e_0;
+    r->r_f_e_0 = r->r_e;
+    r->lzd_f_p = reset ? 0 : __builtin_clz(((uint32_t) r->r_e << 1) | 1);
+
+    // e = -2 ln(u_0)
+    r->r_e = sext(r->r_e_int >> 1, 31);
+    r->r_e_int = sext(r->r_e_exp_ln - r->r_e_y, 34);
+    r->r_e_exp_ln = sext((int64_t) r->r_e_exp * LN2, 34);
+    r->r_e_y = ((uint32_t)(r->ln_o >> 3) & 0x7FFFFFF) >> 1;
+    r->r_e_exp = (int32_t) r->lzd_e_p + 1;
+
+    // pp_fcn_ln, with the 4 stages of mult_23_23_24
+    r->ln_o = sext(r->ln_3_y[3] + bm->ln[r->ln_3_seg[3]].c_0, 31);
+    for (int i = 3; i > 0; i--) {
+        r->ln_3_y[i] = r->ln_3_y[i - 1];
+        r->ln_3_seg[i] = r->ln_3_seg[i - 1];
+    }
+    r->ln_3_y[0] = sext((sext(r->ln_2_y >> 13, 23) * r->ln_2_x) >> 22, 24);
+    r->ln_3_seg[0] = r->ln_2_seg;
+
+    r->ln_2_x = r->ln_1_x;
+    r->ln_2_y = sext(r->ln_1_y + r->ln_1_c_1, 37);
+    r->ln_2_seg = r->ln_1_seg;
+
+    const boxmuller_ln_seg_t *ln = &bm->ln[r->ln_d_seg];
+    r->ln_1_x = r->ln_d_x;
+    r->ln_1_y = (int64_t) ln->c_2 * (r->ln_d_x >> 9);
+    r->ln_1_c_1 = (int64_t) ln->c_1 << 13;
+    r->ln_1_seg = r->ln_d_seg;
+
+    r->ln_d_x = r->ln_0_x;
+    r->ln_d_seg = r->ln_0_seg;
+    r->ln_0_x = r->ln_r_x;
+    r->ln_0_seg = r->ln_r_seg;
+    r->ln_r_x = r->ln_i_x;
+    r->ln_r_seg = r->ln_i_seg;
+    r->ln_i_x = (r->r_i_u_2 & 0x7FFFFF) >> 1;
+    r->ln_i_seg = r->r_i_u_2 >> 23;
+
+    r->lzd_e_p = reset ? 0 : r->r_i_u_0 ? __builtin_clzll(r->r_i_u_0) - 16 : 48;
+
+    // Input
+    r->r_i_u_0 = BOXMULLER_U_0(u);
+    r->r_i_u_1 = BOXMULLER_U_1(u);
+    r->r_i_u_2 = BOXMULLER_U_2(u);
+}
+
+//
+// One enabled edge of the 16 output_remappers
+//
+static inline void remap_clock(grng16_t *g, int16_t factor, int8_t offset) {
+    for (int i = 0; i < GRNG16_LANES; i++) {
+        grng16_remap_t *r = &g->remap[i];
+        const grng16_bm_t *b = &g->bms[i / 2];
+
+        if (r->r_4_y > 31)
+            r->r_5_y = 31;
+        else if (r->r_4_y < -31)
+            r->r_5_y = -31;
+        else
+            r->r_5_y = r->r_4_y;
+        r->r_4_y = r->r_3_y >> 17;
+        r->r_3_y = (int32_t)((uint32_t) r->r_2_y + (uint32_t) g->r_2_offset);
+        r->r_2_y = (int32_t) r->r_1_din * g->r_1_factor;
+        r->r_1_din = r->r_0_din;
+        r->r_0_din = (int16_t)(((i & 1) ? b->r_x_1 : b->r_x_0) >> 18);
+    }
+
+    g->r_2_offset = (int32_t) g->r_1_offset * (1 << 17) + (1 << 16);
+    g->r_1_factor = g->r_0_factor;
+    g->r_1_offset = g->r_0_offset;
+    g->r_0_factor = factor;
+    g->r_0_offset = offset;
+}
+
+static void xoro_seed(grng16_t *g) {
+    for (int i = 0; i < GRNG16_XORO_COUNT; i++) {
+        g->xoro[i].s[0] = XORO_SEEDS[g->seed_base * GRNG16_XORO_COUNT + i][0];
+        g->xoro[i].s[1] = XORO_SEEDS[g->seed_base * GRNG16_XORO_COUNT + i][1];
+    }
+}
+
+static inline void clock_enabled(grng16_t *g, bool reset, int16_t factor, int8_t offset) {
+    // w_xoro_data, combinational from the xoroshiro states
+    uint64_t xoro_data[GRNG16_XORO_COUNT];
+    uint32_t u[GRNG16_XORO_COUNT * 2];
+    for (int i = 0; i < GRNG16_XORO_COUNT; i++)
+        xoro_data[i] = g->xoro[i].s[0] + g->xoro[i].s[1];
+    memcpy(u, xoro_data, sizeof(u));
+
+    remap_clock(g, factor, offset);
+    for (int i = 0; i < GRNG16_BM_COUNT; i++)
+        bm_clock(g->bm, &g->bms[i], &u[3 * i], reset);
+
+    if (reset) {
+        xoro_seed(g);
+    } else {
+        for (int i = 0; i < GRNG16_XORO_COUNT; i++)
+            xoroshiro128plus_next(&g->xoro[i]);
+    }
+    g->cycle++;
+}
+
+void grng16_clock(grng16_t *g, bool resetn, bool en, int16_t factor, int8_t offset) {
+    if (en) {
+        clock_enabled(g, !resetn, factor, offset);
+        return;
+    }
+
+    // Only the reset is independent of en
+    if (!resetn) {
+        xoro_seed(g);
+        for (int i = 0; i < GRNG16_BM_COUNT; i++)
+            bm_reset(&g->bms[i]);
+    }
+    g->cycle++;
+}
+
+void grng16_data(const grng16_t *g, int8_t *data) {
+    for (int i = 0; i < GRNG16_LANES; i++)
+        data[i] = g->remap[i].r_5_y;
+}
+
+void grng16_reset(grng16_t *g) {
+    grng16_clock(g, false, false, 0, 0);
+}
+
+void grng16_run(grng16_t *g, size_t n, int16_t factor, int8_t offset, int8_t *data) {
+    for (size_t i = 0; i < n; i++, data += GRNG16_LANES) {
+        clock_enabled(g, false, factor, offset);
+        grng16_data(g, data);
+    }
+}
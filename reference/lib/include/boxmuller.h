@@ -0,0 +1,118 @@
+#ifndef H_BOXMULLER
+#define H_BOXMULLER
+
+/*
+ * Bit-exact software model of the boxmuller core (src/boxmuller.vhd).
+ *
+ * The polynomial coefficients are taken from src/pp_fcn_rom_pkg.vhd at build
+ * time, and every intermediate value is truncated/wrapped exactly like the
+ * corresponding register in the VHDL, so the outputs are identical to the
+ * x_0/x_1 ports of the core: signed (5,11) fixed point.
+ *
+ * Input: The core consumes a 96-bit uniform word u, which is split into
+ *   u_0 = u(48 downto 1)  (48 bit, leading zero count -> exponent of ln)
+ *   u_1 = u(64 downto 49) (16 bit, angle for sin/cos)
+ *   u_2 = u(95 downto 65) (31 bit, mantissa for ln)
+ * The batch functions take u as three little-endian uint32_t per sample, i.e.
+ * u[3*i+0] holds bits 31..0 of sample i. This is exactly the memory image of
+ * grng_16's w_xoro_data (an array of 64-bit xoroshiro outputs).
+ *
+ * Note: Inside the core the three fields travel through pipelines of different
+ * depths (u_1: 12, u_0: 24, u_2: 33 cycles), so each hardware output combines
+ * fields of three *different* input words. The functions in this header
+ * evaluate one aligned (u_0, u_1, u_2) triple.
+ */
+
+/*
+ * The decoded tables only use 32-bit fields, so that the SIMD kernels can
+ * gather them directly.
+ */
+
+/* Decoded pp_fcn_ln segment: y = C_0 + x * (C_1 + x * C_2) */
+typedef struct boxmuller_ln_seg_t {
+    int32_t c_0;    // (31 bit signed)
+    int32_t c_1;    // (23 bit unsigned)
+    int32_t c_2;    // (14 bit signed)
+    int32_t pad;
+} boxmuller_ln_seg_t;
+
+/* Decoded pp_fcn_sqrt segment: y = C_0 + x * C_1 */
+typedef struct boxmuller_sqrt_seg_t {
+    int32_t c_0;    // (19 bit), pre-shifted by 13
+    int32_t c_1;    // (13 bit signed)
+} boxmuller_sqrt_seg_t;
+
+/* Decoded pp_fcn_trig segment, sin and cos share the segment lookup */
+typedef struct boxmuller_trig_seg_t {
+    int32_t c_0_sin;    // (19 bit signed), pre-shifted by 7
+    int32_t c_1_sin;    // (12 bit signed)
+    int32_t c_0_cos;    // (19 bit signed), pre-shifted by 7
+    int32_t c_1_cos;    // (12 bit signed)
+} boxmuller_trig_seg_t;
+
+/* Instruction sets for boxmuller_generate */
+typedef enum boxmuller_isa_t {
+    BOXMULLER_ISA_SCALAR,
+    BOXMULLER_ISA_AVX2,     // 8 samples per iteration
+    BOXMULLER_ISA_AVX512    // 16 samples per iteration, requires AVX512F + AVX512CD
+} boxmuller_isa_t;
+
+typedef struct boxmuller_t {
+    boxmuller_ln_seg_t ln[256];
+    boxmuller_sqrt_seg_t sqrt[128];
+    boxmuller_trig_seg_t trig[128];
+
+    boxmuller_isa_t isa;
+} boxmuller_t;
+
+#define BOXMULLER_U_0(U) ((((uint64_t)(U)[1] << 32 | (U)[0]) >> 1) & 0xFFFFFFFFFFFFUL)
+#define BOXMULLER_U_1(U) ((((U)[1] >> 17) | ((U)[2] << 15)) & 0xFFFFU)
+#define BOXMULLER_U_2(U) ((U)[2] >> 1)
+
+/*
+ * Decodes the ROM tables and selects the widest instruction set supported by
+ * the host. Free the result with boxmuller_free.
+ */
+boxmuller_t *boxmuller_new(void);
+
+void boxmuller_free(boxmuller_t *bm);
+
+/*
+ * Overrides the instruction set used by boxmuller_generate. All kernels
+ * produce identical results. Returns false (and leaves bm untouched) if the
+ * instruction set is not available on this host or in this build.
+ */
+bool boxmuller_set_isa(boxmuller_t *bm, boxmuller_isa_t isa);
+
+bool boxmuller_isa_supported(boxmuller_isa_t isa);
+
+/*
+ * Evaluates one aligned input triple, x[0] = x_0, x[1] = x_1.
+ */
+void boxmuller_eval(const boxmuller_t *bm, uint64_t u_0, uint32_t u_1, uint32_t u_2, int16_t *x);
+
+/*
+ * The function units of the core, for error analysis (see boxmuller_errmap.h).
+ * They are evaluated exactly like inside of boxmuller_eval.
+ *
+ * ln:   pp_fcn_ln,   u_2 (0,31) -> ln(1 + u_2) (0,27)
+ * sqrt: pp_fcn_sqrt, x (1,0,19) -> sqrt(2^x(19) * (1 + x(18 downto 0))) (1,16)
+ * f:    e (7,24) -> sqrt(e) (5,13), range reduction around pp_fcn_sqrt
+ * g:    u_1 (0,16) -> g[0] = sin(2 pi u_1), g[1] = cos(2 pi u_1) (2,16)
+ */
+uint32_t boxmuller_eval_ln(const boxmuller_t *bm, uint32_t u_2);
+
+uint32_t boxmuller_eval_sqrt(const boxmuller_t *bm, uint32_t x);
+
+uint32_t boxmuller_eval_f(const boxmuller_t *bm, uint32_t e);
+
+void boxmuller_eval_g(const boxmuller_t *bm, uint32_t u_1, int32_t *g);
+
+/*
+ * Transforms n 96-bit uniforms (3 * n words, see above) into n output pairs.
+ * The results are interleaved: x[2*i] = x_0, x[2*i+1] = x_1 of sample i,
+ * which matches the lane order of grng_16.
+ */
+void boxmuller_generate(const boxmuller_t *bm, const uint32_t *u, size_t n, int16_t *x);
+
+#endif
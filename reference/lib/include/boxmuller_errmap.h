@@ -0,0 +1,75 @@
+#ifndef H_BOXMULLER_ERRMAP
+#define H_BOXMULLER_ERRMAP
+
+/*
+ * Exhaustive error analysis of the function units of the boxmuller core.
+ *
+ * The input space of every unit is small enough to be swept completely, and
+ * each output is compared against the double precision function. The inputs
+ * are grouped into bins, i.e. the polynomial segments, or the range reduction
+ * exponent for f, and every bin records its error statistics together with
+ * its worst input.
+ *
+ *   unit  input       bins                               output lsb
+ *   ln    u_2 (2^31)  256 ln segments, u_2 >> 23         2^-27
+ *   sqrt  x (2^20)    128 sqrt segments, x >> 13         2^-16
+ *   f     e (2^31)    32 exponents, bin = exp_f + 6      2^-13
+ *   sin   u_1 (2^16)  512 (quadrant, segment), u_1 >> 7  2^-16
+ *   cos   u_1 (2^16)  512 (quadrant, segment), u_1 >> 7  2^-16
+ *
+ * The complete transform depends on (exp_e, u_1, u_2), 2^53 inputs, and is
+ * not covered. Its error follows from the units above: ln for e, f and g.
+ */
+typedef enum boxmuller_unit_t {
+    BOXMULLER_UNIT_LN,
+    BOXMULLER_UNIT_SQRT,
+    BOXMULLER_UNIT_F,
+    BOXMULLER_UNIT_SIN,
+    BOXMULLER_UNIT_COS,
+    BOXMULLER_UNIT_COUNT
+} boxmuller_unit_t;
+
+typedef struct boxmuller_unit_info_t {
+    const char *name;
+    int input_bits;
+    size_t bins;
+    int lsb_log2;       // output lsb is 2^lsb_log2
+} boxmuller_unit_info_t;
+
+extern const boxmuller_unit_info_t BOXMULLER_UNITS[BOXMULLER_UNIT_COUNT];
+
+/*
+ * Error statistics of one bin, the error being y - y_ref in output units
+ * (not lsbs): mean = sum / n, mean_abs = sum_abs / n, ulp = max_abs / lsb.
+ */
+typedef struct boxmuller_err_t {
+    uint64_t n;
+    double sum;
+    double sum_abs;
+    double max_abs;
+    uint32_t worst;     // input of max_abs, the smallest one on ties
+} boxmuller_err_t;
+
+/*
+ * Bin of input x
+ */
+size_t boxmuller_errmap_bin(boxmuller_unit_t unit, uint32_t x);
+
+/*
+ * Evaluates the unit at input x, returns y - y_ref. y and y_ref may be NULL.
+ */
+double boxmuller_errmap_eval(const boxmuller_t *bm, boxmuller_unit_t unit, uint32_t x, double *y, double *y_ref);
+
+/*
+ * Accumulates the inputs [begin, end) into bins (BOXMULLER_UNITS[unit].bins
+ * entries, zeroed by the caller).
+ */
+void boxmuller_errmap_sweep(const boxmuller_t *bm, boxmuller_unit_t unit, uint64_t begin, uint64_t end,
+        boxmuller_err_t *bins);
+
+/*
+ * acc += b. max_abs and worst do not depend on the order of the merges.
+ */
+void boxmuller_err_merge(boxmuller_err_t *acc, const boxmuller_err_t *b);
+
+#endif
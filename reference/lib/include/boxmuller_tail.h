@@ -0,0 +1,75 @@
+#ifndef H_BOXMULLER_TAIL
+#define H_BOXMULLER_TAIL
+
+/*
+ * Direct sampling of the tails |x| > threshold of the boxmuller core.
+ *
+ * |x_0| and |x_1| are bounded by f, which grows with the leading zero count lz
+ * of u_0 (exp_e = lz + 1) and is largest for u_2 = 0. For every lz that can
+ * reach the threshold, the bit-exact model determines the set of angles u_1
+ * where |x_0| or |x_1| exceeds it at u_2 = 0. The tail region is the union of
+ * these strata
+ *
+ *   { u_0 with lz leading zeros } x { admissible u_1 of lz } x { any u_2 },
+ *
+ * so it contains every input that produces a tail sample. Drawing u uniformly
+ * from the region and discarding the outputs below the threshold yields
+ * exactly the tail distribution of the core, at an acceptance rate of ~1/3
+ * instead of ~2.6e-12 for a threshold of 7.
+ *
+ * The region holds count of the 2^64 (u_0, u_1) pairs, so its probability
+ * under uniform u is weight = count * 2^-64 and
+ *
+ *   P(|x| > threshold) = weight * accepted / (2 * draws).
+ */
+typedef struct boxmuller_tail_stratum_t {
+    int lz;             // leading zeros of u_0 (48 bit)
+    uint32_t n_u_1;
+    uint16_t *u_1;      // admissible u_1, ascending
+} boxmuller_tail_stratum_t;
+
+typedef struct boxmuller_tail_t {
+    double threshold;
+    int32_t threshold_code;     // smallest code of the tail, ceil(threshold * 2^11)
+
+    int n_strata;               // lz = 48, 47, ..., 49 - n_strata
+    boxmuller_tail_stratum_t strata[49];
+
+    uint64_t count;             // (u_0, u_1) pairs in the region, 0 for all 2^64
+    double weight;
+} boxmuller_tail_t;
+
+/*
+ * Returns NULL if no input of the core exceeds the threshold.
+ */
+boxmuller_tail_t *boxmuller_tail_new(const boxmuller_t *bm, double threshold);
+
+void boxmuller_tail_free(boxmuller_tail_t *tail);
+
+/*
+ * Draws n words uniformly from the region, in the layout of
+ * boxmuller_generate (3 * n uint32_t).
+ */
+void boxmuller_tail_draw(const boxmuller_tail_t *tail, urng_t *g, uint32_t *u, size_t n);
+
+/*
+ * Mirrors x to the upper tail. Codes are truncated towards -inf, so code x
+ * stands for [x, x + 1) / 2^11, and its mirror image (-x - 1, -x] / 2^11 is
+ * code ~x = -x - 1, not -x. Mirrored and positive codes are thus on the same
+ * floor grid.
+ */
+static inline int16_t boxmuller_tail_mirror(int16_t x) {
+    return x < 0 ? ~x : x;
+}
+
+/*
+ * True if the output code x is in the tail, i.e. the values of its mirror
+ * image (see boxmuller_tail_mirror) are above the threshold. For a threshold
+ * on the (5,11) grid these are exactly the codes of gaussian() samples
+ * |x| > threshold, like in the default mode of main.
+ */
+static inline bool boxmuller_tail_accept(const boxmuller_tail_t *tail, int16_t x) {
+    return boxmuller_tail_mirror(x) >= tail->threshold_code;
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef H_FXPNT_FIXED
+#define H_FXPNT_FIXED
+
+/*
+ * Fixed point formats resolved at compile time.
+ *
+ *   FXPNT_FIXED(fx8_32, 8, 32)
+ *
+ * defines fx8_32_mult, fx8_32_new, ... as static inline functions, which
+ * return exactly the same values as the corresponding fxpnt_* functions with
+ * a cfg of fxpnt_cfg(8, 32). Masks and saturation bounds are constants, so
+ * the compiler can inline and vectorize the arithmetic. Values are plain
+ * fxpnt_t in both APIs and may be mixed freely; NAME_cfg() returns a matching
+ * fxpnt_cfg_t, e.g. for fxpnt_pp_new.
+ *
+ * Requires fxpnt.h and fxpnt_piecewise_poly.h, and N_I + N_F <= 64,
+ * N_F <= 32 (like fxpnt_mult).
+ *
+ * FXPNT_FIXED_PP1/2(NAME, FORMAT, LOG2_N) define NAME(table, x) and
+ * NAME_batch(table, x, n, y), which evaluate a static degree 1 or 2 table with
+ * 2^LOG2_N segments (fxpnt_pp1/2_seg_t) in Horner form:
+ *
+ *   y = saturate(c_0 + x * (c_1 + x * c_2))
+ *
+ * Like fxpnt_pp_eval, the segment is selected by the top LOG2_N fractional
+ * bits of x and the polynomial is evaluated at the remaining bits. The
+ * products are truncated in a different order, so results may differ from
+ * fxpnt_pp_eval in the last bits.
+ */
+
+#define FXPNT_FIXED_MASK(N_I, N_F) (~(~UINT64_C(0) << ((N_I) + (N_F) - 1) << 1))
+#define FXPNT_FIXED_MASK_F(N_F) ((UINT64_C(1) << (N_F)) - 1)
+#define FXPNT_FIXED_MAX(N_I, N_F) ((fxpnt_t)(FXPNT_FIXED_MASK(N_I, N_F) >> 1))
+#define FXPNT_FIXED_MIN(N_I, N_F) (~FXPNT_FIXED_MAX(N_I, N_F))
+
+#define FXPNT_FIXED(NAME, N_I, N_F)                                                         \
+                                                                                            \
+enum { NAME##_N_I = (N_I), NAME##_N_F = (N_F) };                                            \
+                                                                                            \
+static inline fxpnt_cfg_t NAME##_cfg(void) {                                                \
+    return (fxpnt_cfg_t) {                                                                  \
+        .n_i = (N_I),                                                                       \
+        .n_f = (N_F),                                                                       \
+        .max_v = FXPNT_FIXED_MAX(N_I, N_F),                                                 \
+        .min_v = FXPNT_FIXED_MIN(N_I, N_F),                                                 \
+        .mask = FXPNT_FIXED_MASK(N_I, N_F),                                                 \
+        .mask_i = FXPNT_FIXED_MASK(N_I, N_F) & ~FXPNT_FIXED_MASK_F(N_F),                    \
+        .mask_f = FXPNT_FIXED_MASK_F(N_F)                                                   \
+    };                                                                                      \
+}                                                                                           \
+                                                                                            \
+/* Wraps x to N_I + N_F bits and sign extends it, like fxpnt_new */                         \
+static inline fxpnt_t NAME##_wrap(uint64_t x) {                                             \
+    return (fxpnt_t)(x << (64 - (N_I) - (N_F))) >> (64 - (N_I) - (N_F));                    \
+}                                                                                           \
+                                                                                            \
+static inline fxpnt_t NAME##_new(int64_t i, uint64_t f) {                                   \
+    return NAME##_wrap(((uint64_t) i << (N_F)) | (f & FXPNT_FIXED_MASK_F(N_F)));            \
+}                                                                                           \
+                                                                                            \
+static inline fxpnt_t NAME##_from_int(int n) {                                              \
+    return (fxpnt_t)((int64_t) n * (INT64_C(1) << (N_F)));                                  \
+}                                                                                           \
+                                                                                            \
+static inline fxpnt_t NAME##_from_double(double x) {                                        \
+    return (fxpnt_t)(x * (INT64_C(1) << (N_F)));                                            \
+}                                                                                           \
+                                                                                            \
+static inline double NAME##_to_double(fxpnt_t x) {                                          \
+    return (double) x / (INT64_C(1) << (N_F));                                              \
+}                                                                                           \
+                                                                                            \
+static inline fxpnt_t NAME##_saturate(fxpnt_t x) {                                          \
+    return x > FXPNT_FIXED_MAX(N_I, N_F) ? FXPNT_FIXED_MAX(N_I, N_F)                        \
+         : x < FXPNT_FIXED_MIN(N_I, N_F) ? FXPNT_FIXED_MIN(N_I, N_F) : x;                   \
+}                                                                                           \
+                                                                                            \
+/* Sign-magnitude product, truncated towards zero, like fxpnt_mult */                       \
+static inline fxpnt_t NAME##_mult(fxpnt_t a, fxpnt_t b) {                                   \
+    uint64_t sign = (uint64_t)((a ^ b) >> 63);                                              \
+    uint64_t m_a = a < 0 ? -(uint64_t) a : (uint64_t) a;                                    \
+    uint64_t m_b = b < 0 ? -(uint64_t) b : (uint64_t) b;                                    \
+    fxpnt_t y = NAME##_wrap((uint64_t)(((unsigned __int128) m_a * m_b) >> (N_F)));          \
+    return (fxpnt_t)(((uint64_t) y ^ sign) - sign);                                         \
+}                                                                                           \
+                                                                                            \
+/* Converts x from any format with n_f fractional bits, like fxpnt_to_fxpnt */              \
+static inline fxpnt_t NAME##_convert(fxpnt_t x, int n_f) {                                  \
+    uint64_t f = (uint64_t) x & ((UINT64_C(1) << n_f) - 1);                                 \
+    f = (N_F) > n_f ? f << ((N_F) - n_f) : f >> (n_f - (N_F));                              \
+    return NAME##_new(x >> n_f, f);                                                         \
+}                                                                                           \
+                                                                                            \
+/* fxpnt_pp_eval for tables in this format */                                              \
+static inline fxpnt_t NAME##_pp_eval(const fxpnt_pp_t *pp, fxpnt_t x) {                    \
+    const fxpnt_t *section = &pp->table[(((uint64_t) x & FXPNT_FIXED_MASK_F(N_F))          \
+            >> ((N_F) - pp->log2_n)) * (pp->degree + 1)];                                   \
+    x &= ~(~UINT64_C(0) << ((N_F) - pp->log2_n));                                           \
+                                                                                            \
+    fxpnt_t sum = 0;                                                                        \
+    fxpnt_t x_power = NAME##_from_int(1);                                                   \
+    for (int i = 0; i <= pp->degree; i++) {                                                 \
+        sum += NAME##_mult(section[i], x_power);                                            \
+        x_power = NAME##_mult(x_power, x);                                                  \
+    }                                                                                       \
+                                                                                            \
+    return NAME##_saturate(sum);                                                            \
+}
+
+// Segment index and offset within the segment
+#define FXPNT_FIXED_PP_SEG(FORMAT, LOG2_N, X) \
+    (((uint64_t)(X) & FXPNT_FIXED_MASK_F(FORMAT##_N_F)) >> (FORMAT##_N_F - (LOG2_N)))
+#define FXPNT_FIXED_PP_X(FORMAT, LOG2_N, X) \
+    ((X) & (fxpnt_t) FXPNT_FIXED_MASK_F(FORMAT##_N_F - (LOG2_N)))
+
+#define FXPNT_FIXED_PP1(NAME, FORMAT, LOG2_N)                                               \
+                                                                                            \
+static inline fxpnt_t NAME(const fxpnt_pp1_seg_t *table, fxpnt_t x) {                       \
+    const fxpnt_pp1_seg_t *seg = &table[FXPNT_FIXED_PP_SEG(FORMAT, LOG2_N, x)];             \
+    x = FXPNT_FIXED_PP_X(FORMAT, LOG2_N, x);                                                \
+    return FORMAT##_saturate(seg->c_0 + FORMAT##_mult(x, seg->c_1));                        \
+}                                                                                           \
+                                                                                            \
+static inline void NAME##_batch(const fxpnt_pp1_seg_t *table, const fxpnt_t *x,            \
+        size_t n, fxpnt_t *y) {                                                             \
+    for (size_t i = 0; i < n; i++)                                                          \
+        y[i] = NAME(table, x[i]);                                                           \
+}
+
+#define FXPNT_FIXED_PP2(NAME, FORMAT, LOG2_N)                                               \
+                                                                                            \
+static inline fxpnt_t NAME(const fxpnt_pp2_seg_t *table, fxpnt_t x) {                       \
+    const fxpnt_pp2_seg_t *seg = &table[FXPNT_FIXED_PP_SEG(FORMAT, LOG2_N, x)];             \
+    x = FXPNT_FIXED_PP_X(FORMAT, LOG2_N, x);                                                \
+    fxpnt_t y = seg->c_1 + FORMAT##_mult(x, seg->c_2);                                      \
+    return FORMAT##_saturate(seg->c_0 + FORMAT##_mult(x, y));                               \
+}                                                                                           \
+                                                                                            \
+static inline void NAME##_batch(const fxpnt_pp2_seg_t *table, const fxpnt_t *x,            \
+        size_t n, fxpnt_t *y) {                                                             \
+    for (size_t i = 0; i < n; i++)                                                          \
+        y[i] = NAME(table, x[i]);                                                           \
+}
+
+#endif
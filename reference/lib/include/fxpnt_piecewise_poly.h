@@ -20,4 +20,21 @@ fxpnt_t *fxpnt_pp_get_seg(fxpnt_pp_t *pp, size_t n);
 
 fxpnt_t fxpnt_pp_eval(fxpnt_pp_t *pp, fxpnt_t x);
 
+/*
+ * Segments of static degree 1 and 2 tables, for the evaluators generated by
+ * FXPNT_FIXED_PP1/2 (see fxpnt_fixed.h). The coefficients of a segment are
+ * adjacent and segments are padded to 16 or 32 bytes, so with a table aligned
+ * by FXPNT_PP_ALIGN, every lookup touches exactly one cache line.
+ */
+typedef struct fxpnt_pp1_seg_t {
+    fxpnt_t c_0, c_1;
+} fxpnt_pp1_seg_t;
+
+typedef struct fxpnt_pp2_seg_t {
+    fxpnt_t c_0, c_1, c_2;
+    fxpnt_t pad;
+} fxpnt_pp2_seg_t;
+
+#define FXPNT_PP_ALIGN _Alignas(64)
+
 #endif
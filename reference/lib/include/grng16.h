@@ -0,0 +1,149 @@
+#ifndef H_GRNG16
+#define H_GRNG16
+
+/*
+ * Cycle-accurate model of the complete grng_16 core (src/grng_16.vhd): 12
+ * xoroshiro128plus instances, 8 boxmuller pipelines and 16 output_remappers.
+ *
+ * Every register of the VHDL is modelled, with the same width, enable and
+ * reset behaviour, so the data word after each clock edge is the one the core
+ * drives on its data port, including the pipeline fill after a reset and
+ * en stalls. Like the hardware:
+ *
+ * - en gates every register. With en = 0 the core holds its state, only a
+ *   reset still takes effect.
+ * - resetn = 0 reloads the xoroshiro seeds and clears the leading zero
+ *   detectors and shifters of the boxmuller cores. All other registers have
+ *   no reset and keep clocking (with en) during the reset.
+ * - The pipelines are not flushed by a reset: the first GRNG16_LATENCY
+ *   enabled cycles after it mix old and new values.
+ *
+ * A new model starts with every register cleared, i.e. the power-up state of
+ * the FPGA, which has to be reset before use like the core.
+ *
+ * Latencies in enabled cycles: the data word after edge n holds the remapped
+ * outputs of the u_1 fields captured at edge n - GRNG16_DELAY_U_1, u_0 at
+ * n - GRNG16_DELAY_U_0 and u_2 at n - GRNG16_DELAY_U_2 (see boxmuller.h),
+ * scaled with the factor/offset captured at edge n - GRNG16_DELAY_REMAP.
+ * The xoroshiro outputs captured at an edge are those of the state before it.
+ */
+
+#define GRNG16_XORO_COUNT 12
+#define GRNG16_BM_COUNT 8
+#define GRNG16_LANES 16
+
+#define GRNG16_DELAY_U_1 18
+#define GRNG16_DELAY_U_0 30
+#define GRNG16_DELAY_U_2 39
+#define GRNG16_DELAY_REMAP 5
+
+// Enabled cycles after which no register depends on the state before a reset
+#define GRNG16_LATENCY GRNG16_DELAY_U_2
+
+/* Registers of one boxmuller instance, named like in the VHDL */
+typedef struct grng16_bm_t {
+    // Input
+    uint64_t r_i_u_0;
+    uint32_t r_i_u_1, r_i_u_2;
+
+    // pp_fcn_ln, the ROM words are kept as segment indices
+    int32_t ln_i_x, ln_r_x, ln_0_x, ln_d_x, ln_1_x, ln_2_x;
+    uint8_t ln_i_seg, ln_r_seg, ln_0_seg, ln_d_seg, ln_1_seg, ln_2_seg;
+    int64_t ln_1_y, ln_1_c_1, ln_2_y;
+    int32_t ln_3_y[4];      // mult_23_23_24
+    uint8_t ln_3_seg[4];    // w_3_c_0
+    int32_t ln_o;
+
+    // e = -2 ln(u_0)
+    uint32_t lzd_e_p;
+    int32_t r_e_exp;
+    int64_t r_e_y, r_e_exp_ln, r_e_int;
+    int32_t r_e;
+
+    // f = sqrt(e)
+    uint32_t lzd_f_p;
+    int32_t r_f_e_0, r_f_e_1;
+    int32_t r_f_exp;
+    int32_t r_f_exp_d[11];
+    uint32_t r_f_x;
+    uint32_t r_f_y;
+    int32_t r_f;
+
+    // shifter_lr f_range_red (0) and f_range_rec (1). r_data and r_data_0 are
+    // kept in input bit order, reversing them twice is the identity.
+    uint32_t sh_data[2], sh_c[2], sh_data_0[2], sh_dout[2];
+    uint8_t sh_neg[2], sh_neg_0[2];
+
+    // pp_fcn_sqrt
+    int32_t sq_i_x, sq_r_x, sq_r2_x, sq_0_x;
+    uint8_t sq_i_seg, sq_r_seg, sq_r2_seg, sq_0_seg;
+    int32_t sq_1_y, sq_1_c_0, sq_2_y;
+
+    // pp_fcn_trig
+    int32_t tr_i_x, tr_r_x, tr_r2_x, tr_0_x;
+    uint8_t tr_i_seg, tr_r_seg, tr_r2_seg, tr_0_seg;
+    int32_t tr_1_y_sin, tr_1_y_cos, tr_1_c_0_sin, tr_1_c_0_cos;
+    int32_t tr_2_y_sin, tr_2_y_cos, tr_3_y_sin, tr_3_y_cos;
+
+    // sin/cos
+    uint8_t r_t_quad[7];
+    int32_t r_t_g_0, r_t_g_1, r_b_g_0, r_b_g_1, r_b2_g_0, r_b2_g_1;
+    int64_t r_o_0, r_o_1, r_x_0, r_x_1;
+} grng16_bm_t;
+
+/* Registers of one output_remapper, factor and offset are shared */
+typedef struct grng16_remap_t {
+    int16_t r_0_din, r_1_din;
+    int32_t r_2_y, r_3_y;
+    int16_t r_4_y;
+    int8_t r_5_y;
+} grng16_remap_t;
+
+typedef struct grng16_t {
+    boxmuller_t *bm;    // decoded ROMs
+    unsigned seed_base;
+
+    xoroshiro128plus_t xoro[GRNG16_XORO_COUNT];
+    grng16_bm_t bms[GRNG16_BM_COUNT];
+    grng16_remap_t remap[GRNG16_LANES];
+
+    int16_t r_0_factor, r_1_factor;
+    int8_t r_0_offset, r_1_offset;
+    int32_t r_2_offset;
+
+    uint64_t cycle;     // clock edges, enabled or not
+} grng16_t;
+
+/*
+ * Creates a model of grng_16 with generic xoro_seed_base = seed_base, which
+ * selects XORO_SEEDS[12 * seed_base .. 12 * seed_base + 11]. Returns NULL if
+ * xoro_seeds.h has too few seeds. Free the result with grng16_free.
+ */
+grng16_t *grng16_new(unsigned seed_base);
+
+void grng16_free(grng16_t *g);
+
+/*
+ * One rising clock edge with the given port values. factor (8,8) and offset
+ * (6,2) are the raw values of the ports, see output_remapper.h.
+ */
+void grng16_clock(grng16_t *g, bool resetn, bool en, int16_t factor, int8_t offset);
+
+/*
+ * The data port after the last edge, lane i in data[i] (the little-endian
+ * memory image of the 128-bit word).
+ */
+void grng16_data(const grng16_t *g, int8_t *data);
+
+/*
+ * One edge with resetn = 0 and en = 0, e.g. after grng16_new.
+ */
+void grng16_reset(grng16_t *g);
+
+/*
+ * n enabled edges without reset, writing the data word after each of them,
+ * i.e. 16 * n bytes, to data. Equivalent to grng16_clock + grng16_data.
+ */
+void grng16_run(grng16_t *g, size_t n, int16_t factor, int8_t offset, int8_t *data);
+
+#endif
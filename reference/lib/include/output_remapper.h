@@ -0,0 +1,57 @@
+#ifndef H_OUTPUT_REMAPPER
+#define H_OUTPUT_REMAPPER
+
+/*
+ * Bit-exact model of src/output_remapper.vhd, which scales the (5,11) outputs
+ * of the boxmuller cores to the 8-bit lanes of grng_16:
+ *
+ *   dout = clamp(round(din * factor + offset), -31, 31)
+ *
+ * with din (5,11), factor (8,8), offset (6,2) and dout (6,2). Rounding adds
+ * half an LSB and truncates, i.e. ties round towards +inf.
+ */
+int8_t output_remapper_eval(int16_t din, int16_t factor, int8_t offset);
+
+/*
+ * Steady state of src/output_remapper_fixpt.vhd, the HDL Coder output of
+ * codegen/output_remapper.m. It clamps to +-7.5 like min(max(r_3, -7.5), 7.5)
+ * in the MATLAB source, and its factor is unsigned (8,8):
+ *
+ *   dout = clamp(round(din * factor + offset), -30, 30)
+ *
+ * with the same rounding. For factor < 2^15 this is output_remapper_eval
+ * clamped to +-30. grng_16 instantiates output_remapper.vhd, so that is what
+ * output_remapper_generate and the grng16 model implement.
+ */
+int8_t output_remapper_fixpt_eval(int16_t din, uint16_t factor, int8_t offset);
+
+typedef enum output_remapper_isa_t {
+    OUTPUT_REMAPPER_ISA_SCALAR,
+    OUTPUT_REMAPPER_ISA_AVX2,       // 32 values per iteration
+    OUTPUT_REMAPPER_ISA_AVX512      // 64 values per iteration, requires AVX512BW
+} output_remapper_isa_t;
+
+/*
+ * Selects the implementation of output_remapper_generate and
+ * output_remapper_unpack. All of them return the same values. Returns false
+ * (and keeps the current one) if the host does not support isa. The default
+ * is the widest supported one.
+ */
+bool output_remapper_set_isa(output_remapper_isa_t isa);
+
+bool output_remapper_isa_supported(output_remapper_isa_t isa);
+
+/*
+ * Remaps n values. Lane i of grng_16's 128-bit data word is dout[i] of the
+ * corresponding 16 inputs, so dout is the little-endian memory image of the
+ * hardware output stream.
+ */
+void output_remapper_generate(const int16_t *din, size_t n, int16_t factor, int8_t offset, int8_t *dout);
+
+/*
+ * Converts n (6,2) lanes, e.g. captured data words of grng_16, to their
+ * values: x[i] = data[i] / 4, exact in float.
+ */
+void output_remapper_unpack(const int8_t *data, size_t n, float *x);
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef H_SAMPLE_STATS
+#define H_SAMPLE_STATS
+
+/*
+ * Mergeable statistics of a stream of gaussian samples, for output files that
+ * are too large to be loaded at once. The stream is split into chunks, which
+ * can be accumulated independently (e.g. on different threads) and merged
+ * afterwards:
+ *
+ *  - sample_moments_t: count, mean, central moments and the lag-1 products,
+ *    merged in stream order.
+ *  - sample_hist_t: exact histogram of the fixed point codes, merged in any
+ *    order.
+ *
+ * sample_stats_evaluate compares both against N(mu, sigma^2), or against the
+ * mirrored tail |x| > tail that main writes.
+ */
+
+/*
+ * Code grids of the histogram. Code c covers the values
+ *   SAMPLE_GRID_5_11: [c, c + 1) * 2^-11, i.e. truncated like the x_0/x_1
+ *                     ports of boxmuller.vhd, c in [-32768, 32767]
+ *   SAMPLE_GRID_6_2:  [c - 1/2, c + 1/2) * 2^-2, i.e. rounded like the
+ *                     output remapper, c in [-31, 31]
+ * The outermost codes also hold the saturated tails.
+ */
+typedef enum sample_grid_t {
+    SAMPLE_GRID_5_11,
+    SAMPLE_GRID_6_2
+} sample_grid_t;
+
+#define SAMPLE_HIST_CODES 65536
+
+typedef struct sample_hist_t {
+    sample_grid_t grid;
+    uint64_t count[SAMPLE_HIST_CODES];  // count[c - INT16_MIN]
+} sample_hist_t;
+
+typedef struct sample_moments_t {
+    uint64_t n;
+    double mean;
+    double m2, m3, m4;  // sums of (x - mean)^k
+    double lag;         // sum of x_i * x_{i+1}
+    double first, last;
+} sample_moments_t;
+
+typedef struct sample_report_t {
+    uint64_t n;
+    double mean, variance, skewness, kurtosis;  // kurtosis is the excess kurtosis
+
+    double chi2;        // Pearson, neighbouring codes pooled to an expectation >= 5
+    uint64_t chi2_dof;
+    double chi2_p;
+
+    double ks_d, ks_p;  // Kolmogorov-Smirnov, evaluated at the code boundaries
+    double ad_a2, ad_p; // Anderson-Darling for grouped data
+
+    double serial_r;    // lag-1 autocorrelation
+    double serial_z;    // serial_r * sqrt(n), ~ N(0, 1) for independent samples
+} sample_report_t;
+
+/*
+ * Code of value x on the grid, saturated
+ */
+static inline int32_t sample_grid_code(sample_grid_t grid, double x) {
+    double c, lo, hi;
+
+    if (grid == SAMPLE_GRID_5_11) {
+        c = floor(x * 2048);
+        lo = INT16_MIN;
+        hi = INT16_MAX;
+    } else {
+        c = floor(x * 4 + 0.5);
+        lo = -31;
+        hi = 31;
+    }
+
+    return c < lo ? lo : c > hi ? hi : c;
+}
+
+static inline void sample_hist_add(sample_hist_t *h, int32_t code) {
+    h->count[code - INT16_MIN]++;
+}
+
+void sample_hist_merge(sample_hist_t *acc, const sample_hist_t *b);
+
+/*
+ * Appends n samples to the stream of m
+ */
+void sample_moments_add(sample_moments_t *m, const double *x, size_t n);
+
+/*
+ * acc = acc followed by b
+ */
+void sample_moments_merge(sample_moments_t *acc, const sample_moments_t *b);
+
+/*
+ * The histogram is compared against X ~ N(mu, sigma^2), or, unless tail is
+ * NAN, against |Z| under the condition |Z| > tail, Z = (X - mu) / sigma.
+ * mu + tail * sigma is rounded up to the (5,11) grid first, like the
+ * threshold of main -t (boxmuller_tail_t.threshold_code), since main only
+ * writes whole (5,11) codes above it.
+ */
+void sample_stats_evaluate(const sample_hist_t *h, const sample_moments_t *m, double mu, double sigma,
+        double tail, sample_report_t *r);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef H_URNG
+#define H_URNG
+
+/*
+ * Uniform 64-bit sources for gaussian() and the samplers of main. Requires
+ * xoroshiro128plus.h.
+ *
+ *   URNG_XOROSHIRO128PLUS  xoroshiro128plus_next, bit-identical. The URNG of
+ *                          the VHDL core, use it for hardware parity.
+ *   URNG_XOSHIRO256PP      xoshiro256++, sequential only
+ *   URNG_PHILOX4X32        Philox4x32-10, counter-based
+ *   URNG_THREEFRY2X64      Threefry2x64-20, counter-based
+ *
+ * Every source is a sequence of substreams of 2^64 outputs (2^128 for
+ * xoshiro256++), selected from the seed. Output i of substream s of a
+ * counter-based source is a pure function of (seed, s, i): the counter is
+ * (i / 2, s) and the key is the seed, and each block gives two outputs.
+ * urng_seek is therefore O(1), and workers need no coordination.
+ * xoroshiro128plus seeks with xoroshiro128plus_advance, which takes the same
+ * time for any distance. xoshiro256++ only supports urng_jump.
+ */
+
+typedef enum urng_kind_t {
+    URNG_XOROSHIRO128PLUS,
+    URNG_XOSHIRO256PP,
+    URNG_PHILOX4X32,
+    URNG_THREEFRY2X64
+} urng_kind_t;
+
+#define URNG_KIND_COUNT 4
+
+typedef struct urng_t {
+    urng_kind_t kind;
+    uint64_t seed;
+    union {
+        xoroshiro128plus_t xoro;
+        uint64_t s[4];          // xoshiro256++
+        struct {
+            uint64_t index;     // of the next output
+            uint64_t stream;
+            uint64_t block[2];  // outputs of the block of index & ~1
+        } ctr;
+    };
+} urng_t;
+
+/* "xoroshiro128plus", "xoshiro256pp", "philox4x32" or "threefry2x64" */
+const char *urng_name(urng_kind_t kind);
+
+/* Looks up a kind by its name, false if there is none */
+bool urng_parse(const char *name, urng_kind_t *kind);
+
+/* Substream 0 at output 0 */
+void urng_init(urng_t *, urng_kind_t kind, uint64_t seed);
+
+uint64_t urng_next(urng_t *);
+
+/* n calls to urng_next, counter-based sources compute the blocks in bulk */
+void urng_fill(urng_t *, uint64_t *out, size_t n);
+
+/*
+ * Advances to the same position in the next substream, e.g. 2^64 calls to
+ * xoroshiro128plus_next like xoroshiro128plus_jump
+ */
+void urng_jump(urng_t *);
+
+/*
+ * Moves to output index of substream stream, as if jumped stream times and
+ * advanced by index outputs from urng_init. Returns false (and leaves the
+ * state unchanged) for xoshiro256++.
+ */
+bool urng_seek(urng_t *, uint64_t stream, uint64_t index);
+
+/*
+ * One block of the counter-based generators: (x_0, x_1) of Philox4x32-10
+ * (little-endian 32-bit words) or Threefry2x64-20 for counter ctr and key.
+ */
+void urng_philox4x32(const uint64_t ctr[2], const uint64_t key[2], uint64_t out[2]);
+
+void urng_threefry2x64(const uint64_t ctr[2], const uint64_t key[2], uint64_t out[2]);
+
+#endif
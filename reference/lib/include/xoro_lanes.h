@@ -0,0 +1,60 @@
+#ifndef H_XORO_LANES
+#define H_XORO_LANES
+
+/*
+ * Independent xoroshiro128plus instances in structure-of-arrays layout, all
+ * advanced by one step per call, like the XORO_COUNT instances of grng_16.
+ * Requires xoroshiro128plus.h.
+ *
+ * xoro_lanes_fill writes the outputs step by step, lane i of step t to
+ * out[lanes * t + i]. Read as uint32_t, step t is therefore the memory image
+ * of w_xoro_data in cycle t. With 12 lanes seeded by xoro_lanes_grng16, each
+ * step holds the 8 96-bit inputs of the boxmuller cores of grng_16 in the
+ * layout of boxmuller_generate: core k of cycle t is u[24 * t + 3 * k].
+ */
+
+#define XORO_LANES_MAX 64
+
+typedef struct xoro_lanes_t {
+    size_t lanes;
+    _Alignas(64) uint64_t s_0[XORO_LANES_MAX];
+    _Alignas(64) uint64_t s_1[XORO_LANES_MAX];
+} xoro_lanes_t;
+
+typedef enum xoro_lanes_isa_t {
+    XORO_LANES_ISA_SCALAR,
+    XORO_LANES_ISA_AVX2,        // 4 lanes per vector
+    XORO_LANES_ISA_AVX512       // 8 lanes per vector
+} xoro_lanes_isa_t;
+
+/*
+ * Selects the implementation of xoro_lanes_fill, all of them return the same
+ * values. Returns false (and keeps the current one) if the host does not
+ * support isa. The default is the widest supported one.
+ */
+bool xoro_lanes_set_isa(xoro_lanes_isa_t isa);
+
+bool xoro_lanes_isa_supported(xoro_lanes_isa_t isa);
+
+/*
+ * Lane i starts at xoro[i]. Returns false if lanes is not a multiple of 4
+ * between 4 and XORO_LANES_MAX.
+ */
+bool xoro_lanes_init(xoro_lanes_t *, size_t lanes, const xoroshiro128plus_t *xoro);
+
+/* Lane i is xoroshiro128plus_init(seed) advanced by i jumps */
+bool xoro_lanes_seed(xoro_lanes_t *, size_t lanes, uint64_t seed);
+
+/*
+ * The 12 instances of grng_16 with generic xoro_seed_base = seed_base after a
+ * reset. Returns false if xoro_seeds.h has too few seeds.
+ */
+bool xoro_lanes_grng16(xoro_lanes_t *, unsigned seed_base);
+
+/* Current state of one lane, e.g. to continue it with xoroshiro128plus_next */
+void xoro_lanes_get(const xoro_lanes_t *, size_t lane, xoroshiro128plus_t *xoro);
+
+/* Advances every lane by steps, writing lanes * steps outputs */
+void xoro_lanes_fill(xoro_lanes_t *, size_t steps, uint64_t *out);
+
+#endif
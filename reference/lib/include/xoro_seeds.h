@@ -0,0 +1,273 @@
+/* Generated by xoro_seeds - do not edit! */
+#ifndef H_XORO_SEEDS
+#define H_XORO_SEEDS
+
+#include <stdint.h>
+
+/*
+ * Initial states of the xoroshiro128plus instances in src/xoroshiro128plus.vhd,
+ * { s[0], s[1] } = { seed_0, seed_1 }. Seed i is seed 0 advanced by i * 2^64 steps.
+ */
+#define XORO_SEEDS_LENGTH 256
+#define XORO_SEEDS_STRIDE_LOG2 64
+
+static const uint64_t XORO_SEEDS[XORO_SEEDS_LENGTH][2] = {
+    { 0x86114fc94d6c4ad5UL, 0x1976c51ab89a5886UL },
+    { 0x99ee2d06176445b6UL, 0xe0296ce69151a79fUL },
+    { 0xead8937999d6599eUL, 0x423716dc01d203b8UL },
+    { 0x615f334a56ed3d96UL, 0xb23bc3269b334182UL },
+    { 0xa5636f712dea8e2aUL, 0xf2ef604b534875efUL },
+    { 0xcfe05cb256d80beaUL, 0xc3691e1ed3eba4baUL },
+    { 0xfa88764aca9d7688UL, 0xbedce2c93c1ea677UL },
+    { 0x4a64bd37250b762aUL, 0x0affa462a42fde70UL },
+    { 0x7a5501e6eca23cefUL, 0xb8641e5cff3daf31UL },
+    { 0x61157fdec1979a79UL, 0x21d0edb5bbdd0eb2UL },
+    { 0xba60076ce9ae3680UL, 0xc57fcc63470849a5UL },
+    { 0xa24146171780a69cUL, 0x92e779b6933cd4f9UL },
+    { 0x08c56f09c31e7effUL, 0xa83cbdb0b9f3c874UL },
+    { 0xc86d18a5e228a7e5UL, 0x192e0dd29ad9122eUL },
+    { 0x44102a9b41b640b1UL, 0x12f62825150f4826UL },
+    { 0xfbd060f2c2c89078UL, 0xf59d7bd4f0f25b98UL },
+    { 0x17bf02e175df96f6UL, 0x72eef6ecf3ee3408UL },
+    { 0x1de6e8268186f757UL, 0x82607ac8844a0d0cUL },
+    { 0x0c08d820c93bbafcUL, 0x3276d8944cf53269UL },
+    { 0x2390edd23f68a681UL, 0xc72a56ea28195eb6UL },
+    { 0x553b6916a3621095UL, 0x615eb1af63fcc0a1UL },
+    { 0x1bee4a66f18702eeUL, 0xff7c7809d00d28caUL },
+    { 0x8fdddc3c43d88834UL, 0xaef96cc7087436d8UL },
+    { 0xca468296c56b0b55UL, 0x32e7ff4581fd9907UL },
+    { 0xc44480d6df22eb96UL, 0xa0c21eb30f847571UL },
+    { 0x4641f041c2386626UL, 0xab76330cd68023b5UL },
+    { 0x23ee7d29af119192UL, 0x29bdbf695f135db9UL },
+    { 0x402e77bd8ebd6340UL, 0xa5591829862caa8cUL },
+    { 0xfd107eb4676626f0UL, 0x1ebc9a09f306eaa3UL },
+    { 0xb57e6f5f6963fbbbUL, 0xfab275b8cceebce5UL },
+    { 0x9c47a631b3b820f9UL, 0xaf2729c08939be92UL },
+    { 0x06f15bea57b196adUL, 0xacb38a17203b0b9eUL },
+    { 0xedcf14b4d7ba8180UL, 0xfe9d5501199de618UL },
+    { 0x75bfe2cce6c283f1UL, 0x827af902cd859b23UL },
+    { 0x0b8a71febbd7962fUL, 0xd8a8c2aaa0e7b685UL },
+    { 0xf8ca4d7a4b4b9e8aUL, 0x3edd8d0cc4407d2cUL },
+    { 0xf1be90d1adb8f5f8UL, 0x7fd9c13afec846a2UL },
+    { 0x4017e5e578b2b1daUL, 0x1d57f851f1175f6fUL },
+    { 0xcb65a286ff70fe4aUL, 0x9be255cc6f3e2fd1UL },
+    { 0x874656316994f261UL, 0x4a880453f3fc658dUL },
+    { 0xfc11b5479d19150fUL, 0xfda53b04a3987612UL },
+    { 0x71b92e68c8bebd0dUL, 0x1cbb4fd27f3bd913UL },
+    { 0x1529977556d16376UL, 0x68b4c9b977d41fa0UL },
+    { 0x76b64e3d2a9f32d7UL, 0x0bdc40947b43c0b4UL },
+    { 0xbf248aa839385465UL, 0xdbf17b83845b268dUL },
+    { 0x633ca2734565881fUL, 0x9f97ed5916776b06UL },
+    { 0xefee8dd52aa378f8UL, 0xdfb91da38950ebf0UL },
+    { 0x54a14a45eace37c4UL, 0x63a48906dc1947dfUL },
+    { 0x1c6f8ab2f3292da5UL, 0xc95e4742e4814c61UL },
+    { 0x94c35440531e3f4eUL, 0xd93075a62d42b0d6UL },
+    { 0x1a45ef493a754398UL, 0x1f9e759768e597c0UL },
+    { 0x4048a269ae92d66eUL, 0x673a145a53cf94ffUL },
+    { 0x5bc3558dd9d2722bUL, 0x2c1fcaa0090e2218UL },
+    { 0x80273c525e269746UL, 0x720e06fc3ab6cf68UL },
+    { 0xcdeb6273d27f5b4fUL, 0x2a0a70d2ee437855UL },
+    { 0xf316f7880f64a1e7UL, 0xfb968ddef9bdbe5dUL },
+    { 0x9c19dd6254b4e977UL, 0xbe34002f5231d251UL },
+    { 0xbe7d9a637f9d7e35UL, 0x22de470fee383c5cUL },
+    { 0xa11a0e31a6b48a7aUL, 0xf3cf282952f67e4aUL },
+    { 0x00c6ab9a7fc14d3eUL, 0x3e04ba1ca6232edcUL },
+    { 0x711a86cff98ec788UL, 0xe3e0f332cdbc7f0eUL },
+    { 0xe16e8d5a9ee1d0c6UL, 0xd9bef4ac231d8011UL },
+    { 0x10c84e4e19166d7fUL, 0x0a499dfd2ccd6350UL },
+    { 0x4ec62875da1fec41UL, 0x42db76ef773c38ceUL },
+    { 0x1fa687abfbda4d15UL, 0x56557e5247908701UL },
+    { 0x8e847d066ae41493UL, 0xa4daf3a7c6972abaUL },
+    { 0xab58e1b571cb4391UL, 0xe7681c4b715da00cUL },
+    { 0x70a0a9af1ca59b9bUL, 0xc2d672510b812011UL },
+    { 0x3aff46b296b9a7e3UL, 0x9955064a7c598e54UL },
+    { 0xf6c530e34872be5fUL, 0x4f3e05500c6209dfUL },
+    { 0xca48773df186582dUL, 0x7539bddad3d945e4UL },
+    { 0xf0036db773c85d9aUL, 0x636287313b9b100eUL },
+    { 0x2cf2b6d7bfe5b39cUL, 0x891ac8406e42266eUL },
+    { 0x21eaebb1d2cbf83eUL, 0xe9b89414097b0014UL },
+    { 0xb212d94fc40a2540UL, 0x9b8c9bcb59801dc1UL },
+    { 0x9f97316e8396f333UL, 0x50e64abbc9ca7bb3UL },
+    { 0xbcc54502d1d12444UL, 0x6604164de712d1d6UL },
+    { 0xb47d9c9064371b45UL, 0xd1288263aca828b0UL },
+    { 0xb5f56b02d161e2c5UL, 0x6be5ac65cfd82b4dUL },
+    { 0xad2138ba1f5f0f42UL, 0xa64e54730490f2e6UL },
+    { 0x6238df14eeee3c08UL, 0xc391e47b63c7ab89UL },
+    { 0x951dbe9e9f336127UL, 0x3cc27767dde132abUL },
+    { 0xbef769855e4951a3UL, 0xb28c5444dfc6d3dbUL },
+    { 0xd1ac5e19ee0e8a80UL, 0xda42a21ccd6e59bcUL },
+    { 0x0e47a5740848c68bUL, 0x3a0a0fe6f3fccdeaUL },
+    { 0x4e4a3a3c2e25541dUL, 0x48b32eb1e7a0b6e8UL },
+    { 0x46cdcae66124d21bUL, 0xb08f925fef29cbfdUL },
+    { 0x4d24e4a46e750770UL, 0x675a59c472839109UL },
+    { 0xae3cdad581cccc98UL, 0x68b969399316d450UL },
+    { 0x05e73b4ae78c35b5UL, 0x9b982f7a114f93ffUL },
+    { 0x1d27ab8e12e7f50aUL, 0x42d899db25877d61UL },
+    { 0xdc9861a4121f7059UL, 0x7ab2e8e907c3af0aUL },
+    { 0x03811feab1488375UL, 0xc69906e08572fdeeUL },
+    { 0x12f098b7f74c0799UL, 0xa53a42e2c641a374UL },
+    { 0x8e2e893927caab0eUL, 0xc891ec0025fa9bcdUL },
+    { 0x944c4ee754bfba13UL, 0x718b1b58f2bc5fe6UL },
+    { 0xbce7c8cc9c9d3cf4UL, 0x1237c3fbb80983b8UL },
+    { 0xd8b7526b2b038ac3UL, 0xd29e66c6ecff36a1UL },
+    { 0x235e33186ad7df8dUL, 0x8151ad6f4fabdab3UL },
+    { 0x8d5f755823b09e4aUL, 0xef481c75456b4b07UL },
+    { 0x0f39e0dd8924f5acUL, 0x8c8768869a366c74UL },
+    { 0x96a018e8bf981239UL, 0x914c9f05da8228cdUL },
+    { 0x1a298ffe10615636UL, 0xf9ab13ad19280f35UL },
+    { 0x07bd4b46d23b7674UL, 0xe57f610d11879ce9UL },
+    { 0x46317e93851b943bUL, 0xebee359b46a762b3UL },
+    { 0xef16c5699faa8b64UL, 0xe905506e294e8253UL },
+    { 0xd760eb5574225f5bUL, 0x38945da34025924aUL },
+    { 0x92237ad9905f642bUL, 0x4b8a8cee2911bbbcUL },
+    { 0xb128d4f83f03aa43UL, 0xbc8aa1e206ff586eUL },
+    { 0xb9ee3c785ae35b94UL, 0x61fd28f4a3ae5d78UL },
+    { 0x92f1ca1318a2626cUL, 0x4d79f28947b773f3UL },
+    { 0x6d216bad9ddd8ff7UL, 0x153974bb7bbddee3UL },
+    { 0xed9cc8b4874a7ffaUL, 0xe1aa98eb6076d664UL },
+    { 0x7e87bf42d0e76bd6UL, 0xc06fb82079c3e045UL },
+    { 0x9663e6414d615a82UL, 0x823483bd0a62c9d3UL },
+    { 0x6620a3e39ca5619dUL, 0xc06339fd566e2e6bUL },
+    { 0x7280ef81f81a4311UL, 0xe0f3eb9abe01e0afUL },
+    { 0xb22fa7abfad22e27UL, 0x915955a637a46c3eUL },
+    { 0xe9941792efa9284bUL, 0xb3afd6a96756bc45UL },
+    { 0xe43fd9289bb4d3e2UL, 0xe09011e3958af13bUL },
+    { 0xc36876c99831f1c3UL, 0xb356aab276c7e612UL },
+    { 0x7d6aa319f30c90b4UL, 0x632a542e849d9075UL },
+    { 0x742eddd672a0b2deUL, 0xa0d6ea9cdd80fbd2UL },
+    { 0x66beeca23bb98b1aUL, 0xb25a77a19b830151UL },
+    { 0x1f7a8c48d506068eUL, 0x67d4f746deb2a406UL },
+    { 0xc051b1d8efe3b2bdUL, 0xe50df3e868361bcaUL },
+    { 0x9ba7ac12f7d241ffUL, 0xef836e90a73355a9UL },
+    { 0x1bd053e7732b54fdUL, 0x9d2a544840d4c050UL },
+    { 0x74cbcf3beb5f791fUL, 0xa273633845ae17d4UL },
+    { 0x16111d2bca923e60UL, 0x3ccb8bd0865d4d16UL },
+    { 0xf2fd7b85a7e4dd22UL, 0xe15011f34261f7d8UL },
+    { 0x7e6c1a067bd843cbUL, 0xc297433100e1ae78UL },
+    { 0xbdd92332456c3ef1UL, 0x543d2324318ad74bUL },
+    { 0x7077506c3157c9d6UL, 0x648ea461e0700a7bUL },
+    { 0x1da3896932c92483UL, 0xfd3a3578c0ef4905UL },
+    { 0x973bc33e790a13c6UL, 0x9fce7fa40c44533aUL },
+    { 0xda5b6b7509cbab95UL, 0x4caad1709cfcdc15UL },
+    { 0x145f0bc7e2d5b118UL, 0x80b93372505a4f56UL },
+    { 0x585025dae90a2c07UL, 0x5e4882c203e18413UL },
+    { 0x80b5a8c89e73e281UL, 0x1ecfb22bfbe7f700UL },
+    { 0xa9a3a5d58862ef69UL, 0xcda38ad10c8624cdUL },
+    { 0x51732dd5144650abUL, 0x86ca132e9217aac1UL },
+    { 0xc2543adbdc3d8d9aUL, 0xc00a833bd85bb049UL },
+    { 0xee2711f7283e9008UL, 0x38549b24f1bdc1e9UL },
+    { 0xfb9620e86745be19UL, 0x55071c0fcf5bdc12UL },
+    { 0xc49f542348df0f18UL, 0x8b375b15d319a1a9UL },
+    { 0xef2dfec0bea287b7UL, 0x1398f3d65e127a92UL },
+    { 0x655ed0b2b6058d59UL, 0xcc597d61b8da15e4UL },
+    { 0x7bff40d2015e3d8fUL, 0x0429e6dbf56cc635UL },
+    { 0x61e3abdf3847e6ecUL, 0xd5a6a1d1e4c275beUL },
+    { 0x37492e0a9df34df9UL, 0x681a62911a655a40UL },
+    { 0x1c96eff8259c6c07UL, 0xad1e34d963f834cdUL },
+    { 0x02094a16c5d741e3UL, 0x3baf3053810b0d5cUL },
+    { 0x84e027a241536eacUL, 0x7eb48dc3aa56a8b9UL },
+    { 0x6490f942d8220ccbUL, 0xb5c2e72a51561448UL },
+    { 0x4076ba710efc4ef9UL, 0x495d627a845e50a6UL },
+    { 0xe08393213fcb3c3dUL, 0x5322d8f92edaf8d6UL },
+    { 0xf087221eb3464403UL, 0xbd8476985f8ae9c3UL },
+    { 0x30ff01ee97a1fd08UL, 0x733b0613838f2403UL },
+    { 0x0b609841224f980dUL, 0x71ba525081733c5fUL },
+    { 0xa06bc3ad8585b211UL, 0xae84b7291b39d351UL },
+    { 0x0d43333c7000436fUL, 0xeba069f745c41e91UL },
+    { 0xec2f18886456f695UL, 0xadf25f80b6b8de4cUL },
+    { 0x75555c9d1e7ccfddUL, 0x7a036dfc09e14c6dUL },
+    { 0x4cd9e6d4bdcfc872UL, 0x883b0acde25c7c18UL },
+    { 0x922798d0b87da700UL, 0x4868e8f6d19e2aa5UL },
+    { 0xc77597ffe1232eebUL, 0x8378161f15a0fa17UL },
+    { 0x7a92c76ae0858beaUL, 0x7f15cd0929b4f37aUL },
+    { 0x38d3250733f2135eUL, 0xcdc6a6625b6a6906UL },
+    { 0xbf04af4a1dd111e8UL, 0xa16fd1c0ae7160e1UL },
+    { 0x9995859466751ef2UL, 0x4b72c11bd7c22293UL },
+    { 0xfd4c19dbd4a6cb80UL, 0x5dbbf033b8aed5a8UL },
+    { 0xb55a60175e157b54UL, 0xa2193cf6518eadc3UL },
+    { 0xa20c31592ad6c32cUL, 0x29dce38dc1901257UL },
+    { 0x10f565d7e089174eUL, 0x749ece426dca43a5UL },
+    { 0xd610ee936833b972UL, 0x88fdf085c68fada7UL },
+    { 0x234056819095d693UL, 0x7a097fb72745acb8UL },
+    { 0xd43db72b8f9d4dc8UL, 0xd7cbe2a19dfe55cdUL },
+    { 0x6f4fb2dd730ba455UL, 0x59024bae45f6a064UL },
+    { 0xb298c69a16bf387cUL, 0x6689c5efa8b4ed33UL },
+    { 0x21347219c9267bb1UL, 0x741e078acfcf74a5UL },
+    { 0xe4b9846d01c7db83UL, 0x8cb984909ea305bbUL },
+    { 0x071487aedcf22e95UL, 0xb83994ebbe9a1b42UL },
+    { 0xda3b5dca7f456b95UL, 0xa72a2b0664499a34UL },
+    { 0x9a84619ef3c8fc1aUL, 0x73a13b6c25a9b921UL },
+    { 0xd3f834e4c0b7ed78UL, 0xa0b68abfa6538c91UL },
+    { 0x7a8558d6c2565a4aUL, 0x1c03db123db07b47UL },
+    { 0xcc27f1ca5c02411eUL, 0x7bdd161a50c0a36bUL },
+    { 0x4ffa76be2c66148dUL, 0x0950335041243fc7UL },
+    { 0x0318a7f2b3e73234UL, 0x87c6b714242e3acdUL },
+    { 0x27599699bd4194a5UL, 0xe876b8c0b904ecd9UL },
+    { 0x66b9f67f7d1553a3UL, 0x13752f1e1fd14383UL },
+    { 0x12a098053f42404dUL, 0xe87b931be1767e56UL },
+    { 0xcee8e3e2a7ee3b2eUL, 0xcb8e98b861775a46UL },
+    { 0xdbada417f5a8f8c6UL, 0xa7a421b47814f6f3UL },
+    { 0x1163dff4601899fcUL, 0x59e1a963ceae454aUL },
+    { 0x7a589e9488ca47d1UL, 0x802f809221137329UL },
+    { 0x27f300a02c3e956eUL, 0x792192a7f2ba8571UL },
+    { 0xf044f3d37fd572a8UL, 0x801c7ada922385faUL },
+    { 0x9e59c6ef24403740UL, 0xffe9ac1e35dde2dfUL },
+    { 0x7dfb06a058a3a4fcUL, 0x6e622ae82ce02785UL },
+    { 0x4ea4ee1666c6dc9fUL, 0xc2f314c9e0928482UL },
+    { 0x781a807d23a4cffbUL, 0xfaa58877f29b80baUL },
+    { 0xba2c9860b48104c2UL, 0x2fdd8fa725898d12UL },
+    { 0x8ab642223e004e25UL, 0x71d10395d235cb4cUL },
+    { 0xfa0a7af8239672fdUL, 0x7c53a62918bc860bUL },
+    { 0x8fe1e8fded846994UL, 0x15afac4b39812f49UL },
+    { 0x24d8b59d42034fbeUL, 0xa4bc60c76311a359UL },
+    { 0x6a4899f49463f513UL, 0x00a4b5d9f26b4058UL },
+    { 0x1ff98bdd88d53589UL, 0x83e28516856b839bUL },
+    { 0x988a7afd852bd5a0UL, 0xe718847754d4c1edUL },
+    { 0x9d6e535c4873ea00UL, 0x4a5f3a91f3a1efe5UL },
+    { 0xe5da9b7c53d68a14UL, 0x7bdb0dd68c44f3c1UL },
+    { 0x1728dc9c81e3714cUL, 0x5f8bcc5a39b79f85UL },
+    { 0x6db77cbf46ed430cUL, 0x1f515523eb87abe3UL },
+    { 0x0b4476f234f90ed9UL, 0x71ab3e5ef18cf970UL },
+    { 0xd94cb144e88167ccUL, 0xf7ebdd942742d8ddUL },
+    { 0xf14cb28ea50fd035UL, 0x65ecdca06f28972eUL },
+    { 0xdde87b33571ed90aUL, 0x0ad9d0e2460c5107UL },
+    { 0x9e5d23494064c141UL, 0x0fc4df39da176044UL },
+    { 0x65596b68156562ceUL, 0xf58af2bec0fc9583UL },
+    { 0x15c1fbbade1a0f5aUL, 0x3168d4754d826fa4UL },
+    { 0x02816dc90cec1bcfUL, 0x0f949a5fbecd8185UL },
+    { 0x6ce71801ef47d3f5UL, 0xe3b4e2c6390a0d47UL },
+    { 0x0502437f54c3867bUL, 0x1e55fd6c8b57fb42UL },
+    { 0x8a093bcf5c04e18cUL, 0xe1f38b6267bfb38aUL },
+    { 0x13f5cf38ade0b6adUL, 0x03f65bb9a2b44991UL },
+    { 0x743e64daca567487UL, 0xfa74abc7aa914de5UL },
+    { 0x070f03a8613c8b9bUL, 0xd0e2a5fc1389a72aUL },
+    { 0x50403218e08d40a4UL, 0xf461e326b9a98239UL },
+    { 0x3d66c4727863c242UL, 0xc3061b3b9a419bbcUL },
+    { 0x5fcaef7895f8a371UL, 0x2d893a9699d255a1UL },
+    { 0x728750fdbc3ec91eUL, 0x2b78a209e5de9dd1UL },
+    { 0x8817b70bae866cc5UL, 0x37267014bf7978b1UL },
+    { 0xc18b60fc75ff0d4cUL, 0x1f107b009ee4c216UL },
+    { 0x674edd73e7285dc1UL, 0x628d66f42cdda960UL },
+    { 0x3e54989ebb05a2dbUL, 0xfe1318d97c75fc5cUL },
+    { 0x455ce4c883aebd21UL, 0xd16897f0068a9012UL },
+    { 0xd3f3311d54d5ea64UL, 0x43eb2c3af7cf053bUL },
+    { 0x0b0d1517663bb0e7UL, 0x44155f5b6de2f6aeUL },
+    { 0x7e362c54931a7f94UL, 0xa78efcc86a9c4a16UL },
+    { 0xabde482e59056093UL, 0x8877bbd4075c44bcUL },
+    { 0x7533425719f712b0UL, 0x53b095ebf1079a0cUL },
+    { 0x9f289f061ca48fefUL, 0x47778c482332817aUL },
+    { 0xc13efa4fe60f6d46UL, 0xa770ab1a665b06c9UL },
+    { 0x4b3da2240c030babUL, 0xdb8d0b95c2ccc208UL },
+    { 0x18352c69f8198de5UL, 0x7852800f89d16c16UL },
+    { 0x8e0bb64f51314914UL, 0x9e7b87581d9ed913UL },
+    { 0x1e1167d9715eaa70UL, 0x3b78d7321d7a43fbUL },
+    { 0x9a728b7d9df31383UL, 0x4f92fc82ced2937cUL },
+    { 0x420a33145969b3f7UL, 0x6fc8b7d7343b1cd4UL },
+    { 0xbe736d037e4909c3UL, 0x873acf362488c650UL },
+    { 0xeee1dea4549a84edUL, 0xf09640918320a6baUL },
+    { 0xe10b57443a616159UL, 0x17bb4df412d67f1dUL },
+    { 0x1c9b4460d589b6c7UL, 0x8e9534d8dd84356cUL },
+    { 0x2ea72747365c54e8UL, 0xeb410933c76c3e88UL }
+};
+
+#endif
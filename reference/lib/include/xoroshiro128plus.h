@@ -8,8 +8,29 @@ typedef struct xoroshiro128plus_t {
 
 uint64_t xoroshiro128plus_next(xoroshiro128plus_t *);
 
+/*
+ * Jumps are computed from precomputed powers of the characteristic
+ * polynomial; each one costs 128 calls to next(), independent of the distance.
+ */
+
+/* Advances the state by 2^64 steps */
 void xoroshiro128plus_jump(xoroshiro128plus_t *);
 
+/* Advances the state by 2^96 steps */
+void xoroshiro128plus_long_jump(xoroshiro128plus_t *);
+
+/*
+ * Advances the state by 2^k steps. Returns 0, or -1 (and leaves the state
+ * unchanged) if k >= 128, since 2^128 steps do not reduce to a shorter jump.
+ */
+int xoroshiro128plus_jump_pow2(xoroshiro128plus_t *, unsigned k);
+
+/*
+ * Advances the state by n = n_hi * 2^64 + n_lo steps, e.g. (j, 0) is the same
+ * as j calls to xoroshiro128plus_jump.
+ */
+void xoroshiro128plus_advance(xoroshiro128plus_t *, uint64_t n_hi, uint64_t n_lo);
+
 uint64_t xoroshiro128plus_next(xoroshiro128plus_t *);
 
 uint64_t splitmix64_next(xoroshiro128plus_t *);
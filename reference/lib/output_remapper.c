@@ -0,0 +1,114 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "output_remapper.h"
+#include "output_remapper_kernels.h"
+
+static output_remapper_isa_t output_remapper_isa = OUTPUT_REMAPPER_ISA_SCALAR;
+static bool output_remapper_isa_init = false;
+
+int8_t output_remapper_eval(int16_t din, int16_t factor, int8_t offset) {
+    // r_3_y (13,19), can not overflow 32 bits: |din * factor| <= 2^30
+    int32_t y = (int32_t) din * factor + (int32_t) offset * (1 << 17) + (1 << 16);
+
+    // r_4_y (13,2), saturated to 6 bits. -32 is clamped to -31 as well.
+    y >>= 17;
+    if (y > 31)
+        return 31;
+    if (y < -31)
+        return -31;
+    return (int8_t) y;
+}
+
+int8_t output_remapper_fixpt_eval(int16_t din, uint16_t factor, int8_t offset) {
+    // tmp (13,19), |din * factor| < 2^31. r_2 (14,2) adds bit 16 to bits 31..17.
+    int32_t y = (int32_t) din * factor;
+    y = (y >> 17) + ((y >> 16) & 1) + offset;
+
+    // r_3 can't saturate, r_4 and r_5 clamp to 0x1E
+    if (y > 30)
+        return 30;
+    if (y < -30)
+        return -30;
+    return (int8_t) y;
+}
+
+bool output_remapper_isa_supported(output_remapper_isa_t isa) {
+    switch (isa) {
+    case OUTPUT_REMAPPER_ISA_SCALAR:
+        return true;
+#ifdef OUTPUT_REMAPPER_HAVE_AVX2
+    case OUTPUT_REMAPPER_ISA_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+#ifdef OUTPUT_REMAPPER_HAVE_AVX512
+    case OUTPUT_REMAPPER_ISA_AVX512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+    default:
+        return false;
+    }
+}
+
+bool output_remapper_set_isa(output_remapper_isa_t isa) {
+    if (!output_remapper_isa_supported(isa))
+        return false;
+
+    output_remapper_isa = isa;
+    output_remapper_isa_init = true;
+    return true;
+}
+
+static output_remapper_isa_t current_isa(void) {
+    if (!output_remapper_isa_init && !output_remapper_set_isa(OUTPUT_REMAPPER_ISA_AVX512)
+            && !output_remapper_set_isa(OUTPUT_REMAPPER_ISA_AVX2))
+        output_remapper_set_isa(OUTPUT_REMAPPER_ISA_SCALAR);
+    return output_remapper_isa;
+}
+
+void output_remapper_generate_scalar(const int16_t *din, size_t n, int16_t factor, int8_t offset, int8_t *dout) {
+    for (size_t i = 0; i < n; i++)
+        dout[i] = output_remapper_eval(din[i], factor, offset);
+}
+
+void output_remapper_unpack_scalar(const int8_t *data, size_t n, float *x) {
+    for (size_t i = 0; i < n; i++)
+        x[i] = data[i] * 0.25f;
+}
+
+void output_remapper_generate(const int16_t *din, size_t n, int16_t factor, int8_t offset, int8_t *dout) {
+    switch (current_isa()) {
+#ifdef OUTPUT_REMAPPER_HAVE_AVX512
+    case OUTPUT_REMAPPER_ISA_AVX512:
+        output_remapper_generate_avx512(din, n, factor, offset, dout);
+        return;
+#endif
+#ifdef OUTPUT_REMAPPER_HAVE_AVX2
+    case OUTPUT_REMAPPER_ISA_AVX2:
+        output_remapper_generate_avx2(din, n, factor, offset, dout);
+        return;
+#endif
+    default:
+        output_remapper_generate_scalar(din, n, factor, offset, dout);
+        return;
+    }
+}
+
+void output_remapper_unpack(const int8_t *data, size_t n, float *x) {
+    switch (current_isa()) {
+#ifdef OUTPUT_REMAPPER_HAVE_AVX512
+    case OUTPUT_REMAPPER_ISA_AVX512:
+        output_remapper_unpack_avx512(data, n, x);
+        return;
+#endif
+#ifdef OUTPUT_REMAPPER_HAVE_AVX2
+    case OUTPUT_REMAPPER_ISA_AVX2:
+        output_remapper_unpack_avx2(data, n, x);
+        return;
+#endif
+    default:
+        output_remapper_unpack_scalar(data, n, x);
+        return;
+    }
+}
@@ -0,0 +1,51 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <immintrin.h>
+
+#include "output_remapper.h"
+#include "output_remapper_kernels.h"
+
+/*
+ * AVX2 implementation of output_remapper_generate and output_remapper_unpack,
+ * 32 values per iteration. See output_remapper_kernels.h for the 16-bit form
+ * of the remapper.
+ */
+
+// 16 values, r_4_y saturated to 16 bits
+static inline __m256i remap16(const int16_t *din, __m256i factor, __m256i c) {
+    __m256i x = _mm256_loadu_si256((const __m256i *) din);
+    return _mm256_srai_epi16(_mm256_add_epi16(_mm256_mulhi_epi16(x, factor), c), 1);
+}
+
+void output_remapper_generate_avx2(const int16_t *din, size_t n, int16_t factor, int8_t offset, int8_t *dout) {
+    __m256i f = _mm256_set1_epi16(factor);
+    __m256i c = _mm256_set1_epi16(2 * offset + 1);
+    __m256i max = _mm256_set1_epi8(31);
+    __m256i min = _mm256_set1_epi8(-31);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        // packs interleaves the 128-bit halves of both operands, permute restores the order
+        __m256i y = _mm256_packs_epi16(remap16(din + i, f, c), remap16(din + i + 16, f, c));
+        y = _mm256_permute4x64_epi64(y, _MM_SHUFFLE(3, 1, 2, 0));
+        y = _mm256_max_epi8(_mm256_min_epi8(y, max), min);
+        _mm256_storeu_si256((__m256i *)(dout + i), y);
+    }
+
+    output_remapper_generate_scalar(din + i, n - i, factor, offset, dout + i);
+}
+
+void output_remapper_unpack_avx2(const int8_t *data, size_t n, float *x) {
+    __m256 lsb = _mm256_set1_ps(0.25f);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        for (int j = 0; j < 32; j += 8) {
+            __m256i v = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(data + i + j)));
+            _mm256_storeu_ps(x + i + j, _mm256_mul_ps(_mm256_cvtepi32_ps(v), lsb));
+        }
+    }
+
+    output_remapper_unpack_scalar(data + i, n - i, x + i);
+}
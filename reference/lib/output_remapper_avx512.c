@@ -0,0 +1,50 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <immintrin.h>
+
+#include "output_remapper.h"
+#include "output_remapper_kernels.h"
+
+/*
+ * AVX512BW implementation of output_remapper_generate and
+ * output_remapper_unpack, 64 values per iteration. Same steps as
+ * output_remapper_avx2.c.
+ */
+
+static inline __m512i remap32(const int16_t *din, __m512i factor, __m512i c) {
+    __m512i x = _mm512_loadu_si512(din);
+    return _mm512_srai_epi16(_mm512_add_epi16(_mm512_mulhi_epi16(x, factor), c), 1);
+}
+
+void output_remapper_generate_avx512(const int16_t *din, size_t n, int16_t factor, int8_t offset, int8_t *dout) {
+    __m512i f = _mm512_set1_epi16(factor);
+    __m512i c = _mm512_set1_epi16(2 * offset + 1);
+    __m512i max = _mm512_set1_epi8(31);
+    __m512i min = _mm512_set1_epi8(-31);
+    __m512i order = _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0);
+    size_t i = 0;
+
+    for (; i + 64 <= n; i += 64) {
+        __m512i y = _mm512_packs_epi16(remap32(din + i, f, c), remap32(din + i + 32, f, c));
+        y = _mm512_permutexvar_epi64(order, y);
+        y = _mm512_max_epi8(_mm512_min_epi8(y, max), min);
+        _mm512_storeu_si512(dout + i, y);
+    }
+
+    output_remapper_generate_scalar(din + i, n - i, factor, offset, dout + i);
+}
+
+void output_remapper_unpack_avx512(const int8_t *data, size_t n, float *x) {
+    __m512 lsb = _mm512_set1_ps(0.25f);
+    size_t i = 0;
+
+    for (; i + 64 <= n; i += 64) {
+        for (int j = 0; j < 64; j += 16) {
+            __m512i v = _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *)(data + i + j)));
+            _mm512_storeu_ps(x + i + j, _mm512_mul_ps(_mm512_cvtepi32_ps(v), lsb));
+        }
+    }
+
+    output_remapper_unpack_scalar(data + i, n - i, x + i);
+}
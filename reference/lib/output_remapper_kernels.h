@@ -0,0 +1,28 @@
+#ifndef H_OUTPUT_REMAPPER_KERNELS
+#define H_OUTPUT_REMAPPER_KERNELS
+
+/*
+ * Instruction set specific implementations of output_remapper_generate and
+ * output_remapper_unpack, like boxmuller_kernels.h. The SIMD kernels must
+ * only be called after checking output_remapper_isa_supported and fall back
+ * to the scalar kernels for the remainder of n.
+ *
+ * The SIMD kernels remap in 16 bits: with c = 2 offset + 1, r_3_y >> 17 of
+ * output_remapper_eval equals (hi + c) >> 1, where hi = (din * factor) >> 16
+ * (the low half of the product can not carry into bit 17). |hi| <= 2^14 and
+ * |c| <= 255, so the sum does not overflow.
+ */
+
+void output_remapper_generate_scalar(const int16_t *din, size_t n, int16_t factor, int8_t offset, int8_t *dout);
+
+void output_remapper_generate_avx2(const int16_t *din, size_t n, int16_t factor, int8_t offset, int8_t *dout);
+
+void output_remapper_generate_avx512(const int16_t *din, size_t n, int16_t factor, int8_t offset, int8_t *dout);
+
+void output_remapper_unpack_scalar(const int8_t *data, size_t n, float *x);
+
+void output_remapper_unpack_avx2(const int8_t *data, size_t n, float *x);
+
+void output_remapper_unpack_avx512(const int8_t *data, size_t n, float *x);
+
+#endif
@@ -0,0 +1,247 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "sample_stats.h"
+
+void sample_hist_merge(sample_hist_t *acc, const sample_hist_t *b) {
+    for (size_t i = 0; i < SAMPLE_HIST_CODES; i++)
+        acc->count[i] += b->count[i];
+}
+
+void sample_moments_add(sample_moments_t *m, const double *x, size_t n) {
+    if (!n)
+        return;
+
+    // Two passes over the chunk, then a pairwise merge
+    sample_moments_t b = { .n = n, .first = x[0], .last = x[n - 1] };
+
+    double sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += x[i];
+    b.mean = sum / n;
+
+    for (size_t i = 0; i < n; i++) {
+        double d = x[i] - b.mean;
+        double d_2 = d * d;
+        b.m2 += d_2;
+        b.m3 += d_2 * d;
+        b.m4 += d_2 * d_2;
+    }
+
+    for (size_t i = 1; i < n; i++)
+        b.lag += x[i - 1] * x[i];
+
+    sample_moments_merge(m, &b);
+}
+
+void sample_moments_merge(sample_moments_t *acc, const sample_moments_t *b) {
+    if (!b->n)
+        return;
+
+    if (!acc->n) {
+        *acc = *b;
+        return;
+    }
+
+    // Pebay, "Formulas for robust, one-pass parallel computation of covariances
+    // and arbitrary-order statistical moments", 2008
+    double n_a = acc->n, n_b = b->n, n = n_a + n_b;
+    double delta = b->mean - acc->mean;
+    double delta_n = delta / n;
+
+    double m2 = acc->m2 + b->m2 + delta * delta_n * n_a * n_b;
+    double m3 = acc->m3 + b->m3 + delta * delta_n * delta_n * n_a * n_b * (n_a - n_b)
+        + 3 * delta_n * (n_a * b->m2 - n_b * acc->m2);
+    double m4 = acc->m4 + b->m4
+        + delta * delta_n * delta_n * delta_n * n_a * n_b * (n_a * n_a - n_a * n_b + n_b * n_b)
+        + 6 * delta_n * delta_n * (n_a * n_a * b->m2 + n_b * n_b * acc->m2)
+        + 4 * delta_n * (n_a * b->m3 - n_b * acc->m3);
+
+    acc->mean += delta_n * n_b;
+    acc->m2 = m2;
+    acc->m3 = m3;
+    acc->m4 = m4;
+
+    acc->lag += b->lag + acc->last * b->first;
+    acc->last = b->last;
+    acc->n += b->n;
+}
+
+// Regularized upper incomplete gamma function Q(a, x)
+static double gamma_q(double a, double x) {
+    if (x <= 0)
+        return 1;
+
+    double prefix = exp(a * log(x) - x - lgamma(a));
+
+    if (x < a + 1) {
+        double term = 1 / a, sum = term;
+        for (double ap = a + 1; term > sum * 1e-16; ap++) {
+            term *= x / ap;
+            sum += term;
+        }
+        return fmax(0, 1 - prefix * sum);
+    }
+
+    // Continued fraction, modified Lentz
+    double b = x + 1 - a, c = 1 / 1e-300, d = 1 / b, h = d;
+    for (int i = 1; i < 100000; i++) {
+        double an = -i * (i - a);
+        b += 2;
+        d = an * d + b;
+        c = b + an / c;
+        d = 1 / (fabs(d) < 1e-300 ? 1e-300 : d);
+        c = fabs(c) < 1e-300 ? 1e-300 : c;
+
+        double del = d * c;
+        h *= del;
+        if (fabs(del - 1) < 1e-16)
+            break;
+    }
+    return prefix * h;
+}
+
+// P(K > lambda) of the Kolmogorov distribution
+static double kolmogorov_q(double lambda) {
+    if (lambda < 0.2)
+        return 1;
+
+    double sum = 0;
+    for (int j = 1; j < 100; j++) {
+        double term = exp(-2 * j * j * lambda * lambda);
+        sum += (j & 1) ? term : -term;
+        if (term < 1e-17)
+            break;
+    }
+    return fmin(1, fmax(0, 2 * sum));
+}
+
+// P(A^2 > z) of the asymptotic Anderson-Darling distribution, Marsaglia & Marsaglia, 2004
+static double anderson_darling_q(double z) {
+    if (z <= 0)
+        return 1;
+
+    if (z < 2)
+        return 1 - exp(-1.2337141 / z) / sqrt(z)
+            * (2.00012 + (.247105 - (.0649821 - (.0347962 - (.0116720 - .00168691 * z) * z) * z) * z) * z);
+
+    return 1 - exp(-exp(1.0776 - (2.30695 - (.43424 - (.082433 - (.008056 - .0003146 * z) * z) * z) * z) * z));
+}
+
+// Upper boundary of code c, standardized
+static double code_edge(sample_grid_t grid, int32_t c, double mu, double sigma) {
+    double x = grid == SAMPLE_GRID_5_11 ? ldexp(c + 1, -11) : ldexp(c + 0.5, -2);
+    return (x - mu) / sigma;
+}
+
+// P(Z < z) and P(Z >= z) of the reference, each accurate in its own tail.
+// For tail >= 0, the reference is |Z| under the condition |Z| > tail.
+static void reference_cdf(double z, double tail, double *lower, double *upper) {
+    if (isnan(tail)) {
+        *lower = 0.5 * erfc(-z * M_SQRT1_2);
+        *upper = 0.5 * erfc(z * M_SQRT1_2);
+    } else if (z <= tail) {
+        *lower = 0;
+        *upper = 1;
+    } else {
+        double q_t = erfc(tail * M_SQRT1_2);
+        double q_z = erfc(z * M_SQRT1_2);
+        *lower = (q_t - q_z) / q_t;
+        *upper = q_z / q_t;
+    }
+}
+
+void sample_stats_evaluate(const sample_hist_t *h, const sample_moments_t *m, double mu, double sigma,
+        double tail, sample_report_t *r) {
+    memset(r, 0, sizeof(*r));
+
+    double n = m->n;
+    r->n = m->n;
+    r->mean = m->mean;
+    if (m->n > 1)
+        r->variance = m->m2 / (n - 1);
+    if (m->m2 > 0) {
+        r->skewness = sqrt(n) * m->m3 / pow(m->m2, 1.5);
+        r->kurtosis = n * m->m4 / (m->m2 * m->m2) - 3;
+        if (m->n > 1)
+            r->serial_r = (m->lag / (n - 1) - m->mean * m->mean) / (m->m2 / n);
+        r->serial_z = r->serial_r * sqrt(n);
+    }
+
+    // The cut of main -t, on the (5,11) grid for both histogram grids
+    if (!isnan(tail))
+        tail = (ceil((mu + tail * sigma) * 2048) / 2048 - mu) / sigma;
+
+    int32_t lo = h->grid == SAMPLE_GRID_5_11 ? INT16_MIN : -31;
+    int32_t hi = h->grid == SAMPLE_GRID_5_11 ? INT16_MAX : 31;
+
+    uint64_t total = 0;
+    for (int32_t c = lo; c <= hi; c++)
+        total += h->count[c - INT16_MIN];
+    if (!total)
+        return;
+
+    // below: observations under the current upper edge, lower/upper: expected
+    // fractions under/above it
+    uint64_t below = 0;
+    double lower = 0, upper = 1;
+    double split = isnan(tail) ? 0 : -INFINITY;     // edges above use the upper tail
+    double pool_obs = 0, pool_exp = 0, last_obs = 0, last_exp = 0;
+    double chi2 = 0, ks_d = 0, a2 = 0;
+    uint64_t groups = 0;
+
+    for (int32_t c = lo; c <= hi; c++) {
+        uint64_t obs = h->count[c - INT16_MIN];
+        below += obs;
+
+        double z = code_edge(h->grid, c, mu, sigma);
+        double next_lower = 1, next_upper = 0;
+        if (c < hi)
+            reference_cdf(z, tail, &next_lower, &next_upper);
+        double p = z <= split ? next_lower - lower : upper - next_upper;
+        lower = next_lower;
+        upper = next_upper;
+
+        // Pearson, pooling neighbours until the expectation reaches 5
+        pool_obs += obs;
+        pool_exp += p * total;
+        if (pool_exp >= 5) {
+            chi2 += (pool_obs - pool_exp) * (pool_obs - pool_exp) / pool_exp;
+            last_obs = pool_obs;
+            last_exp = pool_exp;
+            pool_obs = pool_exp = 0;
+            groups++;
+        }
+
+        if (c == hi || lower <= 0 || upper <= 0)
+            continue;
+
+        // Empirical minus expected CDF at the edge, from the nearer tail
+        double diff = z <= split ? (double) below / total - lower : upper - (double)(total - below) / total;
+        ks_d = fmax(ks_d, fabs(diff));
+        a2 += diff * diff * p / (lower * upper);
+    }
+
+    // The remainder of the upper tail joins the last group
+    if (groups && pool_exp > 0) {
+        chi2 -= (last_obs - last_exp) * (last_obs - last_exp) / last_exp;
+        last_obs += pool_obs;
+        last_exp += pool_exp;
+        chi2 += (last_obs - last_exp) * (last_obs - last_exp) / last_exp;
+    }
+
+    double sqrt_n = sqrt((double) total);
+
+    r->chi2 = chi2;
+    r->chi2_dof = groups > 1 ? groups - 1 : 0;
+    r->chi2_p = r->chi2_dof ? gamma_q(r->chi2_dof / 2.0, chi2 / 2) : 1;
+
+    r->ks_d = ks_d;
+    r->ks_p = kolmogorov_q((sqrt_n + 0.12 + 0.11 / sqrt_n) * ks_d);
+
+    r->ad_a2 = total * a2;
+    r->ad_p = anderson_darling_q(r->ad_a2);
+}
@@ -0,0 +1,246 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "xoroshiro128plus.h"
+#include "urng.h"
+
+// Philox4x32 multipliers and Weyl key increments
+#define PHILOX_M0 UINT32_C(0xD2511F53)
+#define PHILOX_M1 UINT32_C(0xCD9E8D57)
+#define PHILOX_W0 UINT32_C(0x9E3779B9)
+#define PHILOX_W1 UINT32_C(0xBB67AE85)
+#define PHILOX_ROUNDS 10
+
+// Threefry2x64 key schedule parity
+#define THREEFRY_PARITY UINT64_C(0x1BD11BDAA9FC1A22)
+
+// xoshiro256++ jump polynomial, 2^128 steps
+static const uint64_t XOSHIRO_JUMP[4] = {
+    0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c
+};
+
+static const char *URNG_NAMES[URNG_KIND_COUNT] = {
+    "xoroshiro128plus", "xoshiro256pp", "philox4x32", "threefry2x64"
+};
+
+// Outputs per call of the bulk kernels of the counter-based generators
+#define FILL_BLOCKS 64
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+const char *urng_name(urng_kind_t kind) {
+    return (unsigned) kind < URNG_KIND_COUNT ? URNG_NAMES[kind] : "unknown";
+}
+
+bool urng_parse(const char *name, urng_kind_t *kind) {
+    for (int i = 0; i < URNG_KIND_COUNT; i++) {
+        if (!strcmp(name, URNG_NAMES[i])) {
+            *kind = (urng_kind_t) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void urng_philox4x32(const uint64_t ctr[2], const uint64_t key[2], uint64_t out[2]) {
+    uint32_t c0 = (uint32_t) ctr[0], c1 = (uint32_t)(ctr[0] >> 32);
+    uint32_t c2 = (uint32_t) ctr[1], c3 = (uint32_t)(ctr[1] >> 32);
+    uint32_t k0 = (uint32_t) key[0], k1 = (uint32_t)(key[0] >> 32);
+
+    for (int r = 0; r < PHILOX_ROUNDS; r++) {
+        uint64_t p0 = (uint64_t) PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t) PHILOX_M1 * c2;
+        c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (uint32_t) p1;
+        c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (uint32_t) p0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    out[0] = c0 | (uint64_t) c1 << 32;
+    out[1] = c2 | (uint64_t) c3 << 32;
+}
+
+#define THREEFRY_ROUND(R) do { x0 += x1; x1 = rotl(x1, R) ^ x0; } while (0)
+
+// Four rounds, then the key injection s
+#define THREEFRY_QUAD(R0, R1, R2, R3, S) do { \
+    THREEFRY_ROUND(R0); THREEFRY_ROUND(R1); THREEFRY_ROUND(R2); THREEFRY_ROUND(R3); \
+    x0 += ks[(S) % 3]; \
+    x1 += ks[((S) + 1) % 3] + (S); \
+} while (0)
+
+void urng_threefry2x64(const uint64_t ctr[2], const uint64_t key[2], uint64_t out[2]) {
+    const uint64_t ks[3] = { key[0], key[1], THREEFRY_PARITY ^ key[0] ^ key[1] };
+    uint64_t x0 = ctr[0] + ks[0], x1 = ctr[1] + ks[1];
+
+    // 20 rounds, rotations 16, 42, 12, 31 and 16, 32, 24, 21 alternating
+    THREEFRY_QUAD(16, 42, 12, 31, 1);
+    THREEFRY_QUAD(16, 32, 24, 21, 2);
+    THREEFRY_QUAD(16, 42, 12, 31, 3);
+    THREEFRY_QUAD(16, 32, 24, 21, 4);
+    THREEFRY_QUAD(16, 42, 12, 31, 5);
+
+    out[0] = x0;
+    out[1] = x1;
+}
+
+static inline void ctr_block(const urng_t *g, uint64_t index, uint64_t out[2]) {
+    const uint64_t ctr[2] = { index >> 1, g->ctr.stream };
+    const uint64_t key[2] = { g->seed, 0 };
+
+    if (g->kind == URNG_PHILOX4X32)
+        urng_philox4x32(ctr, key, out);
+    else
+        urng_threefry2x64(ctr, key, out);
+}
+
+static uint64_t xoshiro256pp_next(uint64_t *s) {
+    const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+void urng_init(urng_t *g, urng_kind_t kind, uint64_t seed) {
+    memset(g, 0, sizeof(*g));
+    g->kind = kind;
+    g->seed = seed;
+
+    switch (kind) {
+    case URNG_XOROSHIRO128PLUS:
+        xoroshiro128plus_init(&g->xoro, seed);
+        break;
+    case URNG_XOSHIRO256PP: {
+        // Seeded from splitmix64 like xoroshiro128plus_init
+        xoroshiro128plus_t sm = { .x = seed };
+        for (int i = 0; i < 4; i++)
+            g->s[i] = splitmix64_next(&sm);
+        break;
+    }
+    case URNG_PHILOX4X32:
+    case URNG_THREEFRY2X64:
+        ctr_block(g, 0, g->ctr.block);
+        break;
+    }
+}
+
+uint64_t urng_next(urng_t *g) {
+    switch (g->kind) {
+    case URNG_XOROSHIRO128PLUS:
+        return xoroshiro128plus_next(&g->xoro);
+    case URNG_XOSHIRO256PP:
+        return xoshiro256pp_next(g->s);
+    default: {
+        uint64_t i = g->ctr.index++;
+        uint64_t x = g->ctr.block[i & 1];
+        if (i & 1)
+            ctr_block(g, i + 1, g->ctr.block);
+        return x;
+    }
+    }
+}
+
+/*
+ * Whole blocks for the counter-based generators, in a loop without
+ * dependencies between the iterations
+ */
+static void ctr_fill(urng_t *g, uint64_t *out, size_t blocks) {
+    const uint64_t key[2] = { g->seed, 0 };
+    uint64_t first = g->ctr.index >> 1;
+
+    if (g->kind == URNG_PHILOX4X32) {
+        for (size_t b = 0; b < blocks; b++) {
+            const uint64_t ctr[2] = { first + b, g->ctr.stream };
+            urng_philox4x32(ctr, key, out + 2 * b);
+        }
+    } else {
+        for (size_t b = 0; b < blocks; b++) {
+            const uint64_t ctr[2] = { first + b, g->ctr.stream };
+            urng_threefry2x64(ctr, key, out + 2 * b);
+        }
+    }
+
+    g->ctr.index += 2 * blocks;
+}
+
+void urng_fill(urng_t *g, uint64_t *out, size_t n) {
+    size_t i = 0;
+
+    switch (g->kind) {
+    case URNG_XOROSHIRO128PLUS:
+        for (; i < n; i++)
+            out[i] = xoroshiro128plus_next(&g->xoro);
+        return;
+    case URNG_XOSHIRO256PP:
+        for (; i < n; i++)
+            out[i] = xoshiro256pp_next(g->s);
+        return;
+    default:
+        // Up to the next block boundary, whole blocks, then the remainder
+        if (g->ctr.index & 1 && i < n)
+            out[i++] = urng_next(g);
+        if (n - i >= 2) {
+            size_t blocks = (n - i) / 2;
+            ctr_fill(g, out + i, blocks);
+            i += 2 * blocks;
+            ctr_block(g, g->ctr.index, g->ctr.block);
+        }
+        for (; i < n; i++)
+            out[i] = urng_next(g);
+        return;
+    }
+}
+
+void urng_jump(urng_t *g) {
+    switch (g->kind) {
+    case URNG_XOROSHIRO128PLUS:
+        xoroshiro128plus_jump(&g->xoro);
+        break;
+    case URNG_XOSHIRO256PP: {
+        uint64_t s[4] = { 0 };
+        for (int i = 0; i < 4; i++) {
+            for (int b = 0; b < 64; b++) {
+                if (XOSHIRO_JUMP[i] & UINT64_C(1) << b)
+                    for (int k = 0; k < 4; k++)
+                        s[k] ^= g->s[k];
+                xoshiro256pp_next(g->s);
+            }
+        }
+        memcpy(g->s, s, sizeof(s));
+        break;
+    }
+    default:
+        g->ctr.stream++;
+        ctr_block(g, g->ctr.index, g->ctr.block);
+        break;
+    }
+}
+
+bool urng_seek(urng_t *g, uint64_t stream, uint64_t index) {
+    switch (g->kind) {
+    case URNG_XOROSHIRO128PLUS:
+        xoroshiro128plus_init(&g->xoro, g->seed);
+        xoroshiro128plus_advance(&g->xoro, stream, index);
+        return true;
+    case URNG_XOSHIRO256PP:
+        return false;
+    default:
+        g->ctr.stream = stream;
+        g->ctr.index = index;
+        ctr_block(g, index, g->ctr.block);
+        return true;
+    }
+}
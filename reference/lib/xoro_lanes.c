@@ -0,0 +1,135 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "xoroshiro128plus.h"
+#include "xoro_seeds.h"
+#include "boxmuller.h"
+#include "grng16.h"
+#include "xoro_lanes.h"
+#include "xoro_lanes_kernels.h"
+
+static xoro_lanes_isa_t xoro_lanes_isa = XORO_LANES_ISA_SCALAR;
+static bool xoro_lanes_isa_init = false;
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+bool xoro_lanes_isa_supported(xoro_lanes_isa_t isa) {
+    switch (isa) {
+    case XORO_LANES_ISA_SCALAR:
+        return true;
+#ifdef XORO_LANES_HAVE_AVX2
+    case XORO_LANES_ISA_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+#ifdef XORO_LANES_HAVE_AVX512
+    case XORO_LANES_ISA_AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+bool xoro_lanes_set_isa(xoro_lanes_isa_t isa) {
+    if (!xoro_lanes_isa_supported(isa))
+        return false;
+
+    xoro_lanes_isa = isa;
+    xoro_lanes_isa_init = true;
+    return true;
+}
+
+static xoro_lanes_isa_t current_isa(void) {
+    if (!xoro_lanes_isa_init && !xoro_lanes_set_isa(XORO_LANES_ISA_AVX512)
+            && !xoro_lanes_set_isa(XORO_LANES_ISA_AVX2))
+        xoro_lanes_set_isa(XORO_LANES_ISA_SCALAR);
+    return xoro_lanes_isa;
+}
+
+static bool valid_lanes(size_t lanes) {
+    return lanes >= 4 && lanes <= XORO_LANES_MAX && lanes % 4 == 0;
+}
+
+bool xoro_lanes_init(xoro_lanes_t *x, size_t lanes, const xoroshiro128plus_t *xoro) {
+    if (!valid_lanes(lanes))
+        return false;
+
+    x->lanes = lanes;
+    for (size_t i = 0; i < lanes; i++) {
+        x->s_0[i] = xoro[i].s[0];
+        x->s_1[i] = xoro[i].s[1];
+    }
+    return true;
+}
+
+bool xoro_lanes_seed(xoro_lanes_t *x, size_t lanes, uint64_t seed) {
+    if (!valid_lanes(lanes))
+        return false;
+
+    xoroshiro128plus_t xoro;
+    xoroshiro128plus_init(&xoro, seed);
+
+    x->lanes = lanes;
+    for (size_t i = 0; i < lanes; i++) {
+        x->s_0[i] = xoro.s[0];
+        x->s_1[i] = xoro.s[1];
+        xoroshiro128plus_jump(&xoro);
+    }
+    return true;
+}
+
+bool xoro_lanes_grng16(xoro_lanes_t *x, unsigned seed_base) {
+    if ((uint64_t) seed_base * GRNG16_XORO_COUNT + GRNG16_XORO_COUNT > XORO_SEEDS_LENGTH)
+        return false;
+
+    x->lanes = GRNG16_XORO_COUNT;
+    for (int i = 0; i < GRNG16_XORO_COUNT; i++) {
+        x->s_0[i] = XORO_SEEDS[seed_base * GRNG16_XORO_COUNT + i][0];
+        x->s_1[i] = XORO_SEEDS[seed_base * GRNG16_XORO_COUNT + i][1];
+    }
+    return true;
+}
+
+void xoro_lanes_get(const xoro_lanes_t *x, size_t lane, xoroshiro128plus_t *xoro) {
+    xoro->s[0] = x->s_0[lane];
+    xoro->s[1] = x->s_1[lane];
+    xoro->x = 0;
+}
+
+void xoro_lanes_fill_scalar(xoro_lanes_t *x, size_t steps, uint64_t *out) {
+    for (size_t i = 0; i < x->lanes; i++) {
+        uint64_t s_0 = x->s_0[i], s_1 = x->s_1[i];
+
+        // xoroshiro128plus_next with the (24, 16, 37) constants
+        for (size_t t = 0; t < steps; t++) {
+            out[x->lanes * t + i] = s_0 + s_1;
+            s_1 ^= s_0;
+            s_0 = rotl(s_0, 24) ^ s_1 ^ (s_1 << 16);
+            s_1 = rotl(s_1, 37);
+        }
+
+        x->s_0[i] = s_0;
+        x->s_1[i] = s_1;
+    }
+}
+
+void xoro_lanes_fill(xoro_lanes_t *x, size_t steps, uint64_t *out) {
+    switch (current_isa()) {
+#ifdef XORO_LANES_HAVE_AVX512
+    case XORO_LANES_ISA_AVX512:
+        xoro_lanes_fill_avx512(x, steps, out);
+        return;
+#endif
+#ifdef XORO_LANES_HAVE_AVX2
+    case XORO_LANES_ISA_AVX2:
+        xoro_lanes_fill_avx2(x, steps, out);
+        return;
+#endif
+    default:
+        xoro_lanes_fill_scalar(x, steps, out);
+        return;
+    }
+}
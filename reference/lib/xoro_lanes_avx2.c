@@ -0,0 +1,60 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <immintrin.h>
+
+#include "xoroshiro128plus.h"
+#include "xoro_lanes.h"
+#include "xoro_lanes_kernels.h"
+
+/*
+ * AVX2 implementation of xoro_lanes_fill, 4 lanes per vector. Two vectors
+ * are advanced together where possible, so their dependency chains overlap.
+ */
+
+static inline __m256i rotl(__m256i x, int k) {
+    return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+}
+
+// xoroshiro128plus_next of 4 lanes
+static inline __m256i next(__m256i *s_0, __m256i *s_1) {
+    __m256i result = _mm256_add_epi64(*s_0, *s_1);
+    __m256i s = _mm256_xor_si256(*s_1, *s_0);
+    *s_0 = _mm256_xor_si256(_mm256_xor_si256(rotl(*s_0, 24), s), _mm256_slli_epi64(s, 16));
+    *s_1 = rotl(s, 37);
+    return result;
+}
+
+void xoro_lanes_fill_avx2(xoro_lanes_t *x, size_t steps, uint64_t *out) {
+    const size_t lanes = x->lanes;
+    size_t i = 0;
+
+    for (; i + 8 <= lanes; i += 8) {
+        __m256i a_0 = _mm256_load_si256((const __m256i *)(x->s_0 + i));
+        __m256i a_1 = _mm256_load_si256((const __m256i *)(x->s_1 + i));
+        __m256i b_0 = _mm256_load_si256((const __m256i *)(x->s_0 + i + 4));
+        __m256i b_1 = _mm256_load_si256((const __m256i *)(x->s_1 + i + 4));
+
+        for (size_t t = 0; t < steps; t++) {
+            _mm256_storeu_si256((__m256i *)(out + lanes * t + i), next(&a_0, &a_1));
+            _mm256_storeu_si256((__m256i *)(out + lanes * t + i + 4), next(&b_0, &b_1));
+        }
+
+        _mm256_store_si256((__m256i *)(x->s_0 + i), a_0);
+        _mm256_store_si256((__m256i *)(x->s_1 + i), a_1);
+        _mm256_store_si256((__m256i *)(x->s_0 + i + 4), b_0);
+        _mm256_store_si256((__m256i *)(x->s_1 + i + 4), b_1);
+    }
+
+    // lanes is a multiple of 4, at most one vector is left
+    if (i < lanes) {
+        __m256i a_0 = _mm256_load_si256((const __m256i *)(x->s_0 + i));
+        __m256i a_1 = _mm256_load_si256((const __m256i *)(x->s_1 + i));
+
+        for (size_t t = 0; t < steps; t++)
+            _mm256_storeu_si256((__m256i *)(out + lanes * t + i), next(&a_0, &a_1));
+
+        _mm256_store_si256((__m256i *)(x->s_0 + i), a_0);
+        _mm256_store_si256((__m256i *)(x->s_1 + i), a_1);
+    }
+}
@@ -0,0 +1,62 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <immintrin.h>
+
+#include "xoroshiro128plus.h"
+#include "xoro_lanes.h"
+#include "xoro_lanes_kernels.h"
+
+/*
+ * AVX-512 implementation of xoro_lanes_fill, 8 lanes per vector with native
+ * rotates (vprolq) and a three-way XOR (vpternlogq). Lane counts that are not
+ * a multiple of 8 end with a masked vector of 4 lanes.
+ */
+
+// a ^ b ^ c
+#define XOR3 0x96
+
+// xoroshiro128plus_next of 8 lanes
+static inline __m512i next(__m512i *s_0, __m512i *s_1) {
+    __m512i result = _mm512_add_epi64(*s_0, *s_1);
+    __m512i s = _mm512_xor_si512(*s_1, *s_0);
+    *s_0 = _mm512_ternarylogic_epi64(_mm512_rol_epi64(*s_0, 24), s, _mm512_slli_epi64(s, 16), XOR3);
+    *s_1 = _mm512_rol_epi64(s, 37);
+    return result;
+}
+
+void xoro_lanes_fill_avx512(xoro_lanes_t *x, size_t steps, uint64_t *out) {
+    const size_t lanes = x->lanes;
+    size_t i = 0;
+
+    for (; i + 16 <= lanes; i += 16) {
+        __m512i a_0 = _mm512_load_si512(x->s_0 + i);
+        __m512i a_1 = _mm512_load_si512(x->s_1 + i);
+        __m512i b_0 = _mm512_load_si512(x->s_0 + i + 8);
+        __m512i b_1 = _mm512_load_si512(x->s_1 + i + 8);
+
+        for (size_t t = 0; t < steps; t++) {
+            _mm512_storeu_si512(out + lanes * t + i, next(&a_0, &a_1));
+            _mm512_storeu_si512(out + lanes * t + i + 8, next(&b_0, &b_1));
+        }
+
+        _mm512_store_si512(x->s_0 + i, a_0);
+        _mm512_store_si512(x->s_1 + i, a_1);
+        _mm512_store_si512(x->s_0 + i + 8, b_0);
+        _mm512_store_si512(x->s_1 + i + 8, b_1);
+    }
+
+    // At most 12 lanes are left, i.e. up to two vectors, the last one masked
+    while (i < lanes) {
+        __mmask8 m = lanes - i >= 8 ? 0xFF : 0x0F;
+        __m512i a_0 = _mm512_maskz_load_epi64(m, x->s_0 + i);
+        __m512i a_1 = _mm512_maskz_load_epi64(m, x->s_1 + i);
+
+        for (size_t t = 0; t < steps; t++)
+            _mm512_mask_storeu_epi64(out + lanes * t + i, m, next(&a_0, &a_1));
+
+        _mm512_mask_store_epi64(x->s_0 + i, m, a_0);
+        _mm512_mask_store_epi64(x->s_1 + i, m, a_1);
+        i += lanes - i >= 8 ? 8 : 4;
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef H_XORO_LANES_KERNELS
+#define H_XORO_LANES_KERNELS
+
+/*
+ * Instruction set specific implementations of xoro_lanes_fill, like
+ * output_remapper_kernels.h. The SIMD kernels must only be called after
+ * checking xoro_lanes_isa_supported. Each one advances a group of lanes in
+ * registers for all steps before it moves on to the next group, since the
+ * lanes are independent.
+ */
+
+void xoro_lanes_fill_scalar(xoro_lanes_t *x, size_t steps, uint64_t *out);
+
+void xoro_lanes_fill_avx2(xoro_lanes_t *x, size_t steps, uint64_t *out);
+
+void xoro_lanes_fill_avx512(xoro_lanes_t *x, size_t steps, uint64_t *out);
+
+#endif
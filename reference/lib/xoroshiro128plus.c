@@ -6,14 +6,179 @@ static inline uint64_t rotl(const uint64_t x, int k) {
 	return (x << k) | (x >> (64 - k));
 }
 
-void xoroshiro128plus_jump(xoroshiro128plus_t *state) {
-	static const uint64_t JUMP[] = { 0xdf900294d8f554a5, 0x170865df4b3201fc };
+/*
+ * Characteristic polynomial of the xoroshiro128+ (24, 16, 37) transition
+ * matrix, without the leading x^128 term. Bit i of { lo, hi } is the
+ * coefficient of x^i.
+ */
+static const uint64_t CHAR_POLY[] = { 0x095b8f76579aa001, 0x0008828e513b43d5 };
+
+/*
+ * x^(2^k) mod CHAR_POLY for k = 0..127. Advancing the generator by n steps is
+ * the same as evaluating x^n mod CHAR_POLY at the transition matrix, and x^n
+ * is the product of the entries selected by the bits of n. Entries 64 and 96
+ * are the well-known JUMP and LONG_JUMP polynomials.
+ */
+static const uint64_t JUMP_POW2[128][2] = {
+	{ 0x0000000000000002, 0x0000000000000000 }, // 2^0
+	{ 0x0000000000000004, 0x0000000000000000 }, // 2^1
+	{ 0x0000000000000010, 0x0000000000000000 }, // 2^2
+	{ 0x0000000000000100, 0x0000000000000000 }, // 2^3
+	{ 0x0000000000010000, 0x0000000000000000 }, // 2^4
+	{ 0x0000000100000000, 0x0000000000000000 }, // 2^5
+	{ 0x0000000000000000, 0x0000000000000001 }, // 2^6
+	{ 0x095b8f76579aa001, 0x0008828e513b43d5 }, // 2^7
+	{ 0x162ad6ec01b26eae, 0x7a8ff5b1c465a931 }, // 2^8
+	{ 0xb4fbaa5c54ee8b8f, 0xb18b0d36cd81a8f5 }, // 2^9
+	{ 0x1207a1706bebb202, 0x23ac5e0ba1cecb29 }, // 2^10
+	{ 0x2c88ef71166bc53d, 0xbb18e9c8d463bb1b }, // 2^11
+	{ 0xc3865bb154e9be10, 0xe3fbe606ef4e8e09 }, // 2^12
+	{ 0x1a9fc99fa7818274, 0x28faaaebb31ee2db }, // 2^13
+	{ 0x588abd4c2ce2ba80, 0x30a7c4eef203c7eb }, // 2^14
+	{ 0x9c90debc053e8cef, 0xa425003f3220a91d }, // 2^15
+	{ 0xb82ca99a09a4e71e, 0x81e1dd96586cf985 }, // 2^16
+	{ 0x35d69e118698a31d, 0x4f7fd3dfbb820bfb }, // 2^17
+	{ 0x49613606c466efd3, 0xfee2760ef3a900b3 }, // 2^18
+	{ 0xbd031d011900a9e5, 0xf0df0531f434c57d }, // 2^19
+	{ 0x235e761b3b378590, 0x442576715266740c }, // 2^20
+	{ 0x3710a7ae7945df77, 0x1e8bae8f680d2b35 }, // 2^21
+	{ 0x75d8e7dbceda609c, 0xfd7027fe6d2f6764 }, // 2^22
+	{ 0xde2cba60cd3332b5, 0x28eff231ad438124 }, // 2^23
+	{ 0x377e64c4e80a06fa, 0x1808760d0a0909a1 }, // 2^24
+	{ 0x0cf0a2225da7fb95, 0xb9a362fafedfe9d2 }, // 2^25
+	{ 0x2bab58a3cadfc0a3, 0xf57881ab117349fd }, // 2^26
+	{ 0x8d51ecdb9ed82455, 0x849272241425c996 }, // 2^27
+	{ 0x521b29d0a57326c1, 0xf1ccb8898cbc07cd }, // 2^28
+	{ 0xfbe65017abec72dd, 0x61179e44214caafa }, // 2^29
+	{ 0x6c446b9bc95c267b, 0xd9aa6b1e93fbb6e4 }, // 2^30
+	{ 0x64f80248d23655c6, 0x86e3772194563f6d }, // 2^31
+	{ 0xfad843622b252c78, 0xd4e95eef9edbdbc6 }, // 2^32
+	{ 0x598742bbfddde630, 0x05667023c584a68a }, // 2^33
+	{ 0x3a9d7dce072134a6, 0x401aacf87a5e21ee }, // 2^34
+	{ 0xf0cc32eaf522f0e0, 0xe114b1e65a950e43 }, // 2^35
+	{ 0xeb2beaa80d3fd8a7, 0x905dff85834fb8d1 }, // 2^36
+	{ 0x61f29536e1bb6b99, 0xc449c069734817cb }, // 2^37
+	{ 0x390cd235d35187da, 0x1e5bc0fe7032f3df }, // 2^38
+	{ 0x744e5f1168ba3345, 0x3f399e6f1ea22dbc }, // 2^39
+	{ 0x8cc9aa88a153f5f8, 0xd47a02636f041cca }, // 2^40
+	{ 0x08d037056c80b9e0, 0xf83c06b106d3b7ab }, // 2^41
+	{ 0x4ce3c123d196bf7a, 0x14223eedae116a83 }, // 2^42
+	{ 0xb1b206870da4e89a, 0x24bfd164204335ae }, // 2^43
+	{ 0x207bb2453717cf67, 0x4a5953c8f4bc2a51 }, // 2^44
+	{ 0xa14e342bb11ff7e6, 0xf6b3f196dc551ccf }, // 2^45
+	{ 0x5422bca5015dd3b7, 0x5b6233b76fa214d7 }, // 2^46
+	{ 0xede7341c00c65b85, 0xf20d7136458bd924 }, // 2^47
+	{ 0xd769cfc9028deb78, 0x9b19ba6b3752065a }, // 2^48
+	{ 0xc7b0e531abe7e4bd, 0x4f27796502238c48 }, // 2^49
+	{ 0x1c6d3ba4bb94182a, 0xb7b17dcd25003305 }, // 2^50
+	{ 0x3ae9471d0e2d0bcf, 0xaaae579366147d07 }, // 2^51
+	{ 0x8f9cd3794ca46fbf, 0x0d56bb288c661ccf }, // 2^52
+	{ 0xdb2ad4e9c15a9d4e, 0x0402342eedff424c }, // 2^53
+	{ 0x79e061af5be21395, 0x4e71559e6d0e7f00 }, // 2^54
+	{ 0x96e7d88c0794e785, 0x8367af1c9d6c1406 }, // 2^55
+	{ 0xccdda809db64b3e7, 0x0dbfcd2453d1d33f }, // 2^56
+	{ 0x6c64681c21cd0286, 0x3309e57f180d4ff6 }, // 2^57
+	{ 0xacb8d4c6ba67113e, 0xb439f330ab3b9715 }, // 2^58
+	{ 0xbad04ca5d96e2cd3, 0xc58f079d0205bcf3 }, // 2^59
+	{ 0xebfbc2723a906760, 0x09417d8c80a37aa7 }, // 2^60
+	{ 0x38ac01316167183d, 0x52f51ac639e09712 }, // 2^61
+	{ 0x7a134006d4efa484, 0xf37ead6ea53b96ba }, // 2^62
+	{ 0x351561e58f8572d4, 0xdc1c01799cb8d734 }, // 2^63
+	{ 0xdf900294d8f554a5, 0x170865df4b3201fc }, // 2^64
+	{ 0x2992ead4972eaed2, 0xb2a7b279a8cb1f50 }, // 2^65
+	{ 0xc026a7d9e04a7700, 0xe7859c665be57882 }, // 2^66
+	{ 0xb4cb6197dea2b1fe, 0x4b4a7aa8c389701c }, // 2^67
+	{ 0x0dcfc5b909e7df4d, 0xadb7753d55646eef }, // 2^68
+	{ 0x468431669864f789, 0xc80926301806a352 }, // 2^69
+	{ 0x22b6c1736285fcc8, 0xc05da051ec96af1d }, // 2^70
+	{ 0x74c1daac8729d8bb, 0xf88f6bac8fd30448 }, // 2^71
+	{ 0x847757c126b23e45, 0x752b98d002c408f7 }, // 2^72
+	{ 0x0f9eaa62d0c9e2a3, 0x1aa7bc96dbace110 }, // 2^73
+	{ 0x7475d71b98314377, 0xc469b29353a4984b }, // 2^74
+	{ 0xbbb7d266d61c85ea, 0x4b6dd41bce3bb499 }, // 2^75
+	{ 0xc419b3742570e16f, 0xe023777e70b3a2f8 }, // 2^76
+	{ 0x2a71db3a3ce8b968, 0x131e94fb35203d80 }, // 2^77
+	{ 0x2897bb8961b4dce9, 0x9240c95b1e7fa08b }, // 2^78
+	{ 0xf0fc3553d7881d5f, 0xb879fca0915f893f }, // 2^79
+	{ 0xe754db3fbc7536bc, 0x2adca86fbefe1366 }, // 2^80
+	{ 0x0a9e201adfe7baa9, 0x0a40a688d77855ba }, // 2^81
+	{ 0x1d0d601e49c35837, 0x17771c905e0775a8 }, // 2^82
+	{ 0x9b031395aec7b584, 0x2cf775e419a607e0 }, // 2^83
+	{ 0x79ead2eeddf66699, 0x93a7cf27dec9b306 }, // 2^84
+	{ 0xe1b9805c107679fc, 0x93615189fe85b7d5 }, // 2^85
+	{ 0x2c3925dcd790e3d6, 0x466421124b50fbfb }, // 2^86
+	{ 0xdca9b0fa4e95600e, 0x1cda7bd04e3bb94b }, // 2^87
+	{ 0xefc7905e1cbb5ffb, 0x5ec431d73bbfe49f }, // 2^88
+	{ 0x854414811d534483, 0x31a1f85fd532f302 }, // 2^89
+	{ 0xadb9ba2958f30b6e, 0xed9b991c09177e2f }, // 2^90
+	{ 0x76f8fdf26b0d1cbb, 0x38d9e87dffdfca70 }, // 2^91
+	{ 0x51f21cddcebdb8c7, 0xd8e9e7254052af4d }, // 2^92
+	{ 0xa03f796efb295305, 0x62769780d13fbc08 }, // 2^93
+	{ 0x4f2083f6b19e628a, 0x66e5456c2eaedbff }, // 2^94
+	{ 0x8b2be9cd79734bed, 0xace8d6ce8e3fba17 }, // 2^95
+	{ 0xd2a98b26625eee7b, 0xdddf9b1090aa7ac1 }, // 2^96
+	{ 0x4fff128094edd94c, 0x00d67dc46ad28695 }, // 2^97
+	{ 0x726438e9a1d3c6ea, 0xf9540570703e7cf3 }, // 2^98
+	{ 0x92cc6a0937c9d34e, 0x066a9599766619b5 }, // 2^99
+	{ 0xc5730de058e1047f, 0xa4e540c7ac49aa1b }, // 2^100
+	{ 0xe408bbecda066551, 0xc2edfc1ab51c00ad }, // 2^101
+	{ 0xc5477ea8821ce588, 0xf11753a4339e78c3 }, // 2^102
+	{ 0x3c6058e633063180, 0xbb42e906efb12540 }, // 2^103
+	{ 0xbec40e0518086e21, 0x4e86f36c495eeedb }, // 2^104
+	{ 0x465276434fd98954, 0xe8345a7c487fefd6 }, // 2^105
+	{ 0x3adaea5cdfe12e3b, 0x688b762874221434 }, // 2^106
+	{ 0xc9dffa95904e99b1, 0x833801923a05f253 }, // 2^107
+	{ 0xa10c3fb0b18df787, 0x58a00d23a8086646 }, // 2^108
+	{ 0xa4e41f760281c3d0, 0xec69708d487dbfc4 }, // 2^109
+	{ 0xb8880fff0e41261c, 0x47176f17de7ff0e9 }, // 2^110
+	{ 0x58ee3b30f542767e, 0x4f40c533643920ea }, // 2^111
+	{ 0x15f2d25b60c5acd7, 0x83fd48d6b9620584 }, // 2^112
+	{ 0xe448c83950a687ea, 0x0ce303c7d3aabbc8 }, // 2^113
+	{ 0xa6ff7863c363cfd4, 0x1746715df0dd8fe3 }, // 2^114
+	{ 0x7e9d8517b195d9c9, 0xc00185964caef8bb }, // 2^115
+	{ 0x40ddb4daf3fbdda8, 0xb6bde02bd004b144 }, // 2^116
+	{ 0x7a794b820672a49b, 0xba43c63ec5a9f187 }, // 2^117
+	{ 0xc1be31e7536236fb, 0x2467071b1d261621 }, // 2^118
+	{ 0xf0eec34daea486fb, 0x5a6fc0435f011daa }, // 2^119
+	{ 0xf42c01a2a3815db4, 0xa5af34331c044d81 }, // 2^120
+	{ 0xdf7964c343b312de, 0xdb43b553cd16ea44 }, // 2^121
+	{ 0x8454182464c29903, 0x432c2bbcd03e65f6 }, // 2^122
+	{ 0x7b6c0ecc6cb5adbb, 0xcdf56412d1e7ba6e }, // 2^123
+	{ 0x380b97764c9f7748, 0xac13c8b2ff838036 }, // 2^124
+	{ 0x1868a9f5a4fd4d64, 0x71d208cc2e5c56e9 }, // 2^125
+	{ 0xe89f5fe075d74a79, 0xd1d08a01b73de005 }, // 2^126
+	{ 0x25aa87f3c2704c69, 0xa9495c12936ad0fd }, // 2^127
+};
+
+// r = a * b mod CHAR_POLY, all polynomials in { lo, hi } form
+static void poly_mulmod(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+	uint64_t lo = 0, hi = 0;
+	for (int i = 127; i >= 0; i--) {
+		uint64_t carry = hi >> 63;
+		hi = (hi << 1) | (lo >> 63);
+		lo <<= 1;
+		if (carry) {
+			lo ^= CHAR_POLY[0];
+			hi ^= CHAR_POLY[1];
+		}
+
+		if (b[i / 64] & UINT64_C(1) << (i % 64)) {
+			lo ^= a[0];
+			hi ^= a[1];
+		}
+	}
 
+	r[0] = lo;
+	r[1] = hi;
+}
+
+// Replaces the state by poly(T) * state, T being the transition matrix
+static void apply_poly(xoroshiro128plus_t *state, const uint64_t *poly) {
 	uint64_t s0 = 0;
 	uint64_t s1 = 0;
-	for(uint64_t i = 0; i < sizeof JUMP / sizeof *JUMP; i++)
+	for(int i = 0; i < 2; i++)
 		for(int b = 0; b < 64; b++) {
-			if (JUMP[i] & UINT64_C(1) << b) {
+			if (poly[i] & UINT64_C(1) << b) {
 				s0 ^= state->s[0];
 				s1 ^= state->s[1];
 			}
@@ -24,6 +189,41 @@ void xoroshiro128plus_jump(xoroshiro128plus_t *state) {
 	state->s[1] = s1;
 }
 
+void xoroshiro128plus_jump(xoroshiro128plus_t *state) {
+	apply_poly(state, JUMP_POW2[64]);
+}
+
+void xoroshiro128plus_long_jump(xoroshiro128plus_t *state) {
+	apply_poly(state, JUMP_POW2[96]);
+}
+
+int xoroshiro128plus_jump_pow2(xoroshiro128plus_t *state, unsigned k) {
+	if (k >= 128)
+		return -1;
+
+	apply_poly(state, JUMP_POW2[k]);
+	return 0;
+}
+
+void xoroshiro128plus_advance(xoroshiro128plus_t *state, uint64_t n_hi, uint64_t n_lo) {
+	const uint64_t n[] = { n_lo, n_hi };
+	uint64_t poly[] = { 1, 0 };
+	int terms = 0;
+
+	for (int k = 0; k < 128; k++)
+		if (n[k / 64] & UINT64_C(1) << (k % 64)) {
+			if (terms++)
+				poly_mulmod(poly, poly, JUMP_POW2[k]);
+			else {
+				poly[0] = JUMP_POW2[k][0];
+				poly[1] = JUMP_POW2[k][1];
+			}
+		}
+
+	if (terms)
+		apply_poly(state, poly);
+}
+
 uint64_t xoroshiro128plus_next(xoroshiro128plus_t *state) {
 	const uint64_t s0 = state->s[0];
 	uint64_t s1 = state->s[1];
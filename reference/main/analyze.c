@@ -0,0 +1,319 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sample_stats.h"
+
+#include "output.h"
+
+/*
+ * Streaming statistical analysis of the sample files written by main (any
+ * format) or verify_trace (double). Regular files are mapped, everything else
+ * is read sequentially. The input is split into chunks of CHUNK_BYTES: every
+ * worker thread accumulates its own histogram, the moments are kept per chunk
+ * and merged in file order, so the report does not depend on the number of
+ * threads.
+ */
+
+#define CHUNK_BYTES (16 << 20)
+#define BATCH_VALUES 4096
+
+typedef struct analyze_t {
+    pthread_mutex_t lock;
+    output_format_t format;
+    size_t sample_size;
+
+    const uint8_t *map;         // mapped input, or NULL
+    size_t size;
+    FILE *file;                 // streamed input, if map is NULL
+    bool eof, failed;
+    size_t trailing_bytes;      // after the last whole sample, only the last chunk has any
+
+    size_t next_chunk;
+    sample_moments_t **chunks;  // moments of chunk i, in file order
+    size_t chunks_cap;
+} analyze_t;
+
+typedef struct worker_t {
+    analyze_t *ctx;
+    pthread_t thread;
+    uint8_t *buffer;            // streamed input only
+    sample_hist_t hist;
+} worker_t;
+
+static void analyze_chunk(const analyze_t *ctx, const uint8_t *data, size_t n, sample_hist_t *hist,
+        sample_moments_t *moments) {
+    double x[BATCH_VALUES];
+
+    for (size_t i = 0; i < n; i += BATCH_VALUES) {
+        size_t k = n - i < BATCH_VALUES ? n - i : BATCH_VALUES;
+
+        switch (ctx->format) {
+        case OUTPUT_DOUBLE:
+            memcpy(x, data + i * sizeof(double), k * sizeof(double));
+            for (size_t j = 0; j < k; j++)
+                sample_hist_add(hist, sample_grid_code(SAMPLE_GRID_5_11, x[j]));
+            break;
+        case OUTPUT_FLOAT32:
+            for (size_t j = 0; j < k; j++) {
+                float f;
+                memcpy(&f, data + (i + j) * sizeof(float), sizeof(float));
+                x[j] = f;
+                sample_hist_add(hist, sample_grid_code(SAMPLE_GRID_5_11, x[j]));
+            }
+            break;
+        case OUTPUT_INT16:
+            for (size_t j = 0; j < k; j++) {
+                int16_t c;
+                memcpy(&c, data + (i + j) * sizeof(int16_t), sizeof(int16_t));
+                x[j] = ldexp(c, -11);
+                sample_hist_add(hist, c);
+            }
+            break;
+        case OUTPUT_INT8:
+            for (size_t j = 0; j < k; j++) {
+                int8_t c = ((const int8_t *) data)[i + j];
+                x[j] = ldexp(c, -2);
+                sample_hist_add(hist, c);
+            }
+            break;
+        }
+
+        sample_moments_add(moments, x, k);
+    }
+}
+
+static void *worker(void *p) {
+    worker_t *w = p;
+    analyze_t *ctx = w->ctx;
+
+    pthread_mutex_lock(&ctx->lock);
+    for (;;) {
+        const uint8_t *data;
+        size_t len;
+
+        if (ctx->map) {
+            if (ctx->next_chunk * CHUNK_BYTES >= ctx->size)
+                break;
+
+            size_t offset = ctx->next_chunk * (size_t) CHUNK_BYTES;
+            data = ctx->map + offset;
+            len = ctx->size - offset < CHUNK_BYTES ? ctx->size - offset : CHUNK_BYTES;
+        } else {
+            if (ctx->eof || ctx->failed)
+                break;
+
+            // Reads are serialized, chunks are numbered in file order
+            len = fread(w->buffer, 1, CHUNK_BYTES, ctx->file);
+            if (len < CHUNK_BYTES) {
+                ctx->eof = true;
+                ctx->failed = ferror(ctx->file);
+            }
+            if (!len)
+                break;
+            data = w->buffer;
+        }
+
+        ctx->trailing_bytes += len % ctx->sample_size;
+        size_t i = ctx->next_chunk++;
+        if (i >= ctx->chunks_cap) {
+            ctx->chunks_cap = ctx->chunks_cap ? 2 * ctx->chunks_cap : 1024;
+            ctx->chunks = realloc(ctx->chunks, ctx->chunks_cap * sizeof(sample_moments_t *));
+        }
+        sample_moments_t *moments = ctx->chunks[i] = calloc(1, sizeof(sample_moments_t));
+        pthread_mutex_unlock(&ctx->lock);
+
+        analyze_chunk(ctx, data, len / ctx->sample_size, &w->hist, moments);
+
+        pthread_mutex_lock(&ctx->lock);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    return NULL;
+}
+
+static void print_report(FILE *out, const char *format, size_t trailing_bytes, const sample_report_t *r) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"format\": \"%s\",\n", format);
+    fprintf(out, "  \"samples\": %lu,\n", r->n);
+    fprintf(out, "  \"trailing_bytes\": %zu,\n", trailing_bytes);
+    fprintf(out, "  \"mean\": %.10g,\n", r->mean);
+    fprintf(out, "  \"variance\": %.10g,\n", r->variance);
+    fprintf(out, "  \"skewness\": %.10g,\n", r->skewness);
+    fprintf(out, "  \"excess_kurtosis\": %.10g,\n", r->kurtosis);
+    fprintf(out, "  \"chi2\": { \"statistic\": %.10g, \"dof\": %lu, \"p\": %.6g },\n", r->chi2, r->chi2_dof, r->chi2_p);
+    fprintf(out, "  \"ks\": { \"d\": %.10g, \"p\": %.6g },\n", r->ks_d, r->ks_p);
+    fprintf(out, "  \"anderson_darling\": { \"a2\": %.10g, \"p\": %.6g },\n", r->ad_a2, r->ad_p);
+    fprintf(out, "  \"serial\": { \"r\": %.10g, \"z\": %.6g }\n", r->serial_r, r->serial_z);
+    fprintf(out, "}\n");
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-j THREADS] [-f FORMAT] [-n MU:SIGMA] [-t THRESHOLD] [-H HISTFILE] <INFILE>\n", prog);
+    fprintf(stderr, "  -j THREADS    Worker threads, default: number of online cores\n");
+    fprintf(stderr, "  -f FORMAT     double (default), float32, int16 or int8, see main\n");
+    fprintf(stderr, "  -n MU:SIGMA   Parameters of the reference distribution, default 0:1\n");
+    fprintf(stderr, "  -t THRESHOLD  The samples are the mirrored tail |x| > THRESHOLD, e.g. 7 for main's\n");
+    fprintf(stderr, "                default mode, or the threshold passed to main -t. It is rounded up\n");
+    fprintf(stderr, "                to the (5,11) grid like in main -t.\n");
+    fprintf(stderr, "  -H HISTFILE   Also write the histogram of the codes as \"<code> <count>\" lines\n");
+    fprintf(stderr, "INFILE may be - for stdin. The report is written to stdout as JSON.\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *prog = argv[0];
+    const char *format_name = "double";
+    const char *hist_path = NULL;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cores > 0 ? (int) cores : 1;
+    double mu = 0, sigma = 1, tail = NAN;
+    analyze_t ctx = { .format = OUTPUT_DOUBLE };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "j:f:n:t:H:")) != -1) {
+        switch (opt) {
+        case 'j':
+            if (sscanf(optarg, "%d", &threads) < 1 || threads < 1) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as thread count!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'f':
+            if (!output_format_parse(optarg, &ctx.format)) {
+                fprintf(stderr, "%s: Unknown output format \"%s\"!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            format_name = optarg;
+            break;
+        case 'n':
+            if (sscanf(optarg, "%lf:%lf", &mu, &sigma) < 2 || !(sigma > 0)) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as MU:SIGMA!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            if (sscanf(optarg, "%lf", &tail) < 1 || !(tail >= 0)) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as threshold!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'H':
+            hist_path = optarg;
+            break;
+        default:
+            usage(prog);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind != 1) {
+        usage(prog);
+        return EXIT_FAILURE;
+    }
+
+    const char *path = argv[optind];
+    int fd = strcmp(path, "-") ? open(path, O_RDONLY) : STDIN_FILENO;
+    if (fd < 0) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    ctx.sample_size = output_format_size(ctx.format);
+
+    struct stat st;
+    if (!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+            ctx.map = map;
+            ctx.size = st.st_size;
+        }
+    }
+
+    if (!ctx.map && !(ctx.file = fdopen(fd, "rb"))) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    worker_t *workers = calloc(threads, sizeof(worker_t));
+    int started = 0;
+    for (; started < threads; started++) {
+        worker_t *w = &workers[started];
+        w->ctx = &ctx;
+        w->hist.grid = ctx.format == OUTPUT_INT8 ? SAMPLE_GRID_6_2 : SAMPLE_GRID_5_11;
+        if (!ctx.map && !(w->buffer = malloc(CHUNK_BYTES)))
+            break;
+        if (pthread_create(&w->thread, NULL, worker, w)) {
+            free(w->buffer);
+            break;
+        }
+    }
+
+    for (int i = 0; i < started; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    int ret = 0;
+    if (!started) {
+        fprintf(stderr, "%s: Failed to start worker threads!\n", prog);
+        ret = EXIT_FAILURE;
+    } else if (ctx.failed) {
+        fprintf(stderr, "%s: Failed to read input file: %s\n", prog, strerror(errno));
+        ret = EXIT_FAILURE;
+    }
+
+    sample_hist_t *hist = &workers[0].hist;
+    sample_moments_t moments = { 0 };
+    for (int i = 1; i < started; i++)
+        sample_hist_merge(hist, &workers[i].hist);
+    for (size_t i = 0; i < ctx.next_chunk; i++) {
+        sample_moments_merge(&moments, ctx.chunks[i]);
+        free(ctx.chunks[i]);
+    }
+
+    if (!ret && ctx.trailing_bytes)
+        fprintf(stderr, "%s: Ignoring %zu trailing bytes, the input is not a whole number of %s samples\n", prog,
+                ctx.trailing_bytes, format_name);
+
+    if (!ret) {
+        sample_report_t report;
+        sample_stats_evaluate(hist, &moments, mu, sigma, tail, &report);
+        print_report(stdout, format_name, ctx.trailing_bytes, &report);
+
+        FILE *hist_file = hist_path ? fopen(hist_path, "w") : NULL;
+        if (hist_path && !hist_file) {
+            perror(hist_path);
+            ret = EXIT_FAILURE;
+        }
+        for (size_t i = 0; hist_file && i < SAMPLE_HIST_CODES; i++)
+            if (hist->count[i])
+                fprintf(hist_file, "%ld %lu\n", (long) i + INT16_MIN, hist->count[i]);
+        if (hist_file)
+            fclose(hist_file);
+    }
+
+    for (int i = 0; i < started; i++)
+        free(workers[i].buffer);
+    free(workers);
+    free(ctx.chunks);
+    pthread_mutex_destroy(&ctx.lock);
+
+    if (ctx.map)
+        munmap((void *) ctx.map, ctx.size);
+    if (ctx.file)
+        fclose(ctx.file);
+    else
+        close(fd);
+
+    return ret;
+}
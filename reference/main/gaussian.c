@@ -0,0 +1,132 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "fxpnt.h"
+#include "fxpnt_piecewise_poly.h"
+#include "fxpnt_fixed.h"
+
+#include "main.h"
+#include "gaussian.h"
+
+#define CONST_LN2 0.6931471805599453
+#define CONST_SQRT2 1.4142135623730951
+
+int count_leading_zeros(int len, uint64_t x) {
+    uint64_t mask = 1UL << (len - 1);
+    for (int i = 0; i < len; ++i) {
+        if (x & mask)
+            return i;
+        else
+            mask >>= 1;
+    }
+    return len;
+}
+
+#define RIGHT_SHIFT(x, d) (((d) >= 0) ? ((x) >> (d)) : ((x) << -(d)))
+
+// Fraction bits of pp_fx and of the 14-bit angle
+#define PP_N_F 32
+#define TRIG_N_F 14
+
+// Degree 2 evaluators for the tables in main.h
+FXPNT_FIXED_PP2(log_eval, pp_fx, 8)
+FXPNT_FIXED_PP2(sqrt_eval, pp_fx, 4)
+FXPNT_FIXED_PP2(cos_eval, pp_fx, 4)
+
+gaussian_ctx_t *setup(void) {
+    gaussian_ctx_t *ctx = calloc(1, sizeof(gaussian_ctx_t));
+
+    ctx->log_pp = FXPNT_PP_LOG;
+    ctx->sqrt_pp = FXPNT_PP_SQRT;
+    ctx->cos_pp = FXPNT_PP_COS;
+    
+    ctx->fxpnt_ln2 = pp_fx_from_double(CONST_LN2);
+    ctx->fxpnt_sqrt2 = pp_fx_from_double(CONST_SQRT2);
+
+    return ctx;
+}
+
+void teardown(gaussian_ctx_t *ctx) {
+    free(ctx);
+}
+
+/*
+ * Computes two samples in (8,32). All arithmetic uses the compile-time
+ * pp_fx format, so the whole datapath can be inlined.
+ */
+void gaussian(const gaussian_ctx_t *ctx, uint64_t rand, fxpnt_t *out) {
+    const fxpnt_pp2_seg_t *log_pp = ctx->log_pp;
+    const fxpnt_pp2_seg_t *sqrt_pp = ctx->sqrt_pp;
+    const fxpnt_pp2_seg_t *cos_pp = ctx->cos_pp;
+
+    uint64_t u_0 = 0xFFFFFFFFFFFFUL & rand; // 48 bit uniform random
+    uint64_t u_1 = 0xFFFFUL & (rand >> 48); // 16 bit uniform random
+
+    u_0 &= 0xFFFFUL;
+
+    //
+    // Operation: e = -2 * ln(u_0)  
+    //
+    
+    // Calculate mantissa of u_0, with implicit leading 1-bit
+    int exp_e = count_leading_zeros(48, u_0) + 1;
+    uint64_t x_e = 0xFFFFFFFFFFFFUL & (u_0 << exp_e);
+
+    // Shift "mantissa" to fill fraction
+    x_e = x_e >> (48 - PP_N_F);
+
+    // Evaluate mantissa ( \in [1,2) )
+    fxpnt_t y_e = log_eval(log_pp, x_e);
+    // e = -2 ln(x) = 2 * (exp_e * ln(2) - ln(mantissa))
+    fxpnt_t e = (ctx->fxpnt_ln2 * exp_e - y_e) << 1;
+
+    //
+    // Operation: f = sqrt(e)
+    //
+
+    // Range Reduction
+    int exp_f = 5 - count_leading_zeros(6 + PP_N_F, e);
+    fxpnt_t x_f = RIGHT_SHIFT(e, exp_f);
+
+    // Evaluate sqrt(M_x) (Where M_x is [1,2))
+    fxpnt_t y_f = sqrt_eval(sqrt_pp, x_f);
+
+    if (exp_f & 1) // Compensate odd exponents
+        y_f = pp_fx_mult(y_f, ctx->fxpnt_sqrt2);
+
+    fxpnt_t f = RIGHT_SHIFT(y_f, -(exp_f>>1)); // Reconstruct range
+
+    //
+    // Operation: g_0 = sin(tau * u_1), g_1 = cos(tau * u_1)
+    //
+
+    int quad = (u_1 >> 14) & 0b11;
+    fxpnt_t x_g = (fxpnt_t) (u_1 & 0x3fff);
+    fxpnt_t x_g_i = (fxpnt_t) FXPNT_FIXED_MASK_F(TRIG_N_F) - x_g;
+
+    fxpnt_t y_g_a = cos_eval(cos_pp, pp_fx_convert(x_g, TRIG_N_F));
+    fxpnt_t y_g_b = cos_eval(cos_pp, pp_fx_convert(x_g_i, TRIG_N_F));
+
+    fxpnt_t g_0, g_1;
+    switch (quad) {
+    case 0:
+        g_0 = y_g_b;
+        g_1 = y_g_a;
+        break;
+    case 1:
+        g_0 = y_g_a;
+        g_1 = -y_g_b;
+        break;
+    case 2:
+        g_0 = -y_g_b;
+        g_1 = -y_g_a;
+        break;
+    case 3:
+        g_0 = -y_g_a;
+        g_1 = y_g_b;
+        break;
+    }
+    
+    out[0] = pp_fx_mult(f, g_0);
+    out[1] = pp_fx_mult(f, g_1);
+}
@@ -0,0 +1,36 @@
+#ifndef H_GAUSSIAN
+#define H_GAUSSIAN
+
+/*
+ * Fixed point model of the boxmuller datapath that predates the current VHDL
+ * implementation (see lib/include/boxmuller.h for the bit-exact one), built
+ * from the polynomial tables in main.h. Samples are in pp_fx, (8,32).
+ *
+ * Requires fxpnt.h, fxpnt_piecewise_poly.h and fxpnt_fixed.h.
+ */
+FXPNT_FIXED(pp_fx, 8, 32)
+
+/*
+ * All state required by gaussian(). It is only read after setup(), so one
+ * context can be shared by all worker threads.
+ */
+typedef struct gaussian_ctx_t {
+    const fxpnt_pp2_seg_t *log_pp;      // 256 segments
+    const fxpnt_pp2_seg_t *sqrt_pp;     // 16 segments
+    const fxpnt_pp2_seg_t *cos_pp;      // 16 segments
+
+    fxpnt_t fxpnt_sqrt2, fxpnt_ln2;
+} gaussian_ctx_t;
+
+gaussian_ctx_t *setup(void);
+
+void teardown(gaussian_ctx_t *ctx);
+
+/*
+ * Computes two samples from 64 uniform bits
+ */
+void gaussian(const gaussian_ctx_t *ctx, uint64_t rand, fxpnt_t *out);
+
+int count_leading_zeros(int len, uint64_t x);
+
+#endif
@@ -3,214 +3,277 @@
 #include <string.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <stdbool.h>
+#include <math.h>
+#include <unistd.h>
+#include <stdatomic.h>
 
 #include "xoroshiro128plus.h"
+#include "urng.h"
 #include "fxpnt.h"
 #include "fxpnt_piecewise_poly.h"
-
-#include "main.h"
-
-#define CONST_LN2 0.6931471805599453
-#define CONST_SQRT2 1.4142135623730951
-
-int count_leading_zeros(int len, uint64_t x) {
-    uint64_t mask = 1UL << (len - 1);
-    for (int i = 0; i < len; ++i) {
-        if (x & mask)
-            return i;
-        else
-            mask >>= 1;
+#include "fxpnt_fixed.h"
+#include "output_remapper.h"
+#include "boxmuller.h"
+#include "boxmuller_tail.h"
+
+#include "gaussian.h"
+#include "output.h"
+#include "parallel.h"
+
+#define BLOCK_VALUES 1024 // doubles per block
+#define TAIL_CHUNK 64     // inputs per boxmuller_generate call in tail mode
+
+/*
+ * Draw counts of the tail mode, summed over all blocks
+ */
+typedef struct tail_stats_t {
+    atomic_uint_fast64_t draws;     // inputs drawn from the tail region
+    atomic_uint_fast64_t hits;      // outputs above the threshold, including discarded ones
+} tail_stats_t;
+
+/*
+ * Sample format of the blocks, shared read-only by all workers
+ */
+typedef struct block_cfg_t {
+    const gaussian_ctx_t *ctx;
+    const boxmuller_t *bm;              // tail mode only
+    const boxmuller_tail_t *tail;       // tail mode only
+    tail_stats_t *stats;                // tail mode only
+    output_format_t format;
+    int16_t factor;     // OUTPUT_INT8 only, (8,8)
+    int8_t offset;      // OUTPUT_INT8 only, (6,2)
+} block_cfg_t;
+
+static inline void store_sample(const block_cfg_t *cfg, void *block, size_t j, double x) {
+    // x has 32 fractional bits, so flooring is exact, like the truncation in hardware
+    double code = floor(x * 2048);
+    int16_t x_16 = code > INT16_MAX ? INT16_MAX : code < INT16_MIN ? INT16_MIN : (int16_t) code;
+
+    switch (cfg->format) {
+    case OUTPUT_DOUBLE:
+        ((double *) block)[j] = x;
+        break;
+    case OUTPUT_FLOAT32:
+        ((float *) block)[j] = (float) x;
+        break;
+    case OUTPUT_INT16:
+        ((int16_t *) block)[j] = x_16;
+        break;
+    case OUTPUT_INT8:
+        ((int8_t *) block)[j] = output_remapper_eval(x_16, cfg->factor, cfg->offset);
+        break;
     }
-    return len;
 }
 
-#define RIGHT_SHIFT(x, d) (((d) >= 0) ? ((x) >> (d)) : ((x) << -(d)))
-
-static fxpnt_pp_t *log_pp;
-static fxpnt_pp_t *sqrt_pp;
-static fxpnt_pp_t *cos_pp;
-
-static fxpnt_cfg_t *trig_cfg;
-
-fxpnt_t fxpnt_sqrt2, fxpnt_ln2;
-
-void setup(void) {
-    fxpnt_cfg_t *cfg = fxpnt_cfg(8, 32);
-    
-    log_pp = fxpnt_pp_new(cfg, 8, 2); // 2^4 == 16 segments, degree 2
-    memcpy(log_pp->table, FXPNT_PP_LOG, sizeof(FXPNT_PP_LOG));
-
-    sqrt_pp = fxpnt_pp_new(cfg, 4, 2);
-    memcpy(sqrt_pp->table, FXPNT_PP_SQRT, sizeof(FXPNT_PP_SQRT));
+/*
+ * Fills one block of BLOCK_VALUES tail samples (|x| > 7, mirrored to x > 7).
+ */
+void generate_block(void *arg, urng_t *g, void *block) {
+    const block_cfg_t *cfg = arg;
+    const gaussian_ctx_t *ctx = cfg->ctx;
+    fxpnt_t gaussians[2];
 
-    cos_pp = fxpnt_pp_new(cfg, 4, 2);
-    memcpy(cos_pp->table, FXPNT_PP_COS, sizeof(FXPNT_PP_COS));
-    
-    fxpnt_free(cfg);
+    for (size_t j = 0; j < BLOCK_VALUES;) {
+        uint64_t u = urng_next(g);
+        gaussian(ctx, u, gaussians);
 
-    trig_cfg = fxpnt_cfg(8, 14);
-    
-    fxpnt_ln2 = fxpnt_from_double(log_pp->cfg, CONST_LN2);
-    fxpnt_sqrt2 = fxpnt_from_double(sqrt_pp->cfg, CONST_SQRT2);
+        for (int k = 0; k < 2 && j < BLOCK_VALUES; k++) {
+            double x = pp_fx_to_double(gaussians[k]);
+            if (x > 7)
+                store_sample(cfg, block, j++, x);
+            else if (x < -7)
+                store_sample(cfg, block, j++, -x);
+        }
+    }
 }
 
-void teardown(void) {
-    fxpnt_pp_free(log_pp);
-    fxpnt_pp_free(sqrt_pp);
-    fxpnt_pp_free(cos_pp);
+/*
+ * Fills one block of BLOCK_VALUES tail samples (|x| > threshold, mirrored
+ * with boxmuller_tail_mirror) of the bit-exact model, drawing the inputs
+ * directly from the tail region.
+ */
+void generate_tail_block(void *arg, urng_t *g, void *block) {
+    const block_cfg_t *cfg = arg;
+    uint32_t u[3 * TAIL_CHUNK];
+    int16_t x[2 * TAIL_CHUNK];
+    uint64_t draws = 0, hits = 0;
+
+    for (size_t j = 0; j < BLOCK_VALUES;) {
+        boxmuller_tail_draw(cfg->tail, g, u, TAIL_CHUNK);
+        boxmuller_generate(cfg->bm, u, TAIL_CHUNK, x);
+        draws += TAIL_CHUNK;
+
+        // Count the whole chunk, so that hits / draws stays unbiased
+        for (size_t k = 0; k < 2 * TAIL_CHUNK; k++) {
+            if (!boxmuller_tail_accept(cfg->tail, x[k]))
+                continue;
+
+            hits++;
+            if (j < BLOCK_VALUES)
+                store_sample(cfg, block, j++, boxmuller_tail_mirror(x[k]) / 2048.0);
+        }
+    }
 
-    fxpnt_free(trig_cfg);
+    atomic_fetch_add(&cfg->stats->draws, draws);
+    atomic_fetch_add(&cfg->stats->hits, hits);
 }
 
-void gaussian(uint64_t rand, fxpnt_cfg_t *cfg, fxpnt_t *out) {
-    uint64_t u_0 = 0xFFFFFFFFFFFFUL & rand; // 48 bit uniform random
-    uint64_t u_1 = 0xFFFFUL & (rand >> 48); // 16 bit uniform random
-
-    u_0 &= 0xFFFFUL;
-
-    //
-    // Operation: e = -2 * ln(u_0)  
-    //
-    
-    // Calculate mantissa of u_0, with implicit leading 1-bit
-    int exp_e = count_leading_zeros(48, u_0) + 1;
-    uint64_t x_e = 0xFFFFFFFFFFFFUL & (u_0 << exp_e);
-
-    // Shift "mantissa" to fill fraction
-    x_e = x_e >> (48 - log_pp->cfg->n_f);
-
-    // Evaluate mantissa ( \in [1,2) )
-    fxpnt_t y_e = fxpnt_pp_eval(log_pp, x_e);
-    // e = -2 ln(x) = 2 * (exp_e * ln(2) - ln(mantissa))
-    fxpnt_t e = (fxpnt_ln2 * exp_e - y_e) << 1;
-
-    //
-    // Operation: f = sqrt(e)
-    //
-
-    // Convert if log_pp and sqrt_pp differ!
-    if (log_pp->cfg->n_f != sqrt_pp->cfg->n_f)
-        e = fxpnt_to_fxpnt(log_pp->cfg, e, sqrt_pp->cfg);
-
-    // Range Reduction
-    int exp_f = 5 - count_leading_zeros(6 + log_pp->cfg->n_f, e);
-    fxpnt_t x_f = RIGHT_SHIFT(e, exp_f);
-
-    // Evaluate sqrt(M_x) (Where M_x is [1,2))
-    fxpnt_t y_f = fxpnt_pp_eval(sqrt_pp, x_f);
-
-    if (exp_f & 1) // Compensate odd exponents
-        y_f = fxpnt_mult(sqrt_pp->cfg, y_f, fxpnt_sqrt2);
-
-    fxpnt_t f = RIGHT_SHIFT(y_f, -(exp_f>>1)); // Reconstruct range
-
-    //
-    // Operation: g_0 = sin(tau * u_1), g_1 = cos(tau * u_1)
-    //
-
-    int quad = (u_1 >> 14) & 0b11;
-    fxpnt_t x_g = (fxpnt_t) (u_1 & 0x3fff);
-    fxpnt_t x_g_i = (fxpnt_t)(trig_cfg->mask_f) - x_g;
-
-    fxpnt_t y_g_a = fxpnt_pp_eval(cos_pp, fxpnt_to_fxpnt(trig_cfg, x_g, cos_pp->cfg));
-    fxpnt_t y_g_b = fxpnt_pp_eval(cos_pp, fxpnt_to_fxpnt(trig_cfg, x_g_i, cos_pp->cfg));
-
-    fxpnt_t g_0, g_1;
-    switch (quad) {
-    case 0:
-        g_0 = y_g_b;
-        g_1 = y_g_a;
-        break;
-    case 1:
-        g_0 = y_g_a;
-        g_1 = -y_g_b;
-        break;
-    case 2:
-        g_0 = -y_g_b;
-        g_1 = -y_g_a;
-        break;
-    case 3:
-        g_0 = -y_g_a;
-        g_1 = y_g_b;
-        break;
-    }
-    
-    out[0] = fxpnt_to_fxpnt(sqrt_pp->cfg, fxpnt_mult(cos_pp->cfg, f, g_0), cfg);
-    out[1] = fxpnt_to_fxpnt(sqrt_pp->cfg, fxpnt_mult(cos_pp->cfg, f, g_1), cfg);
+static void usage(const char *prog) {
+    printf("Usage: %s [-j THREADS] [-g GENERATOR] [-f FORMAT] [-r FACTOR:OFFSET] [-t THRESHOLD] <OUTFILE> <SEED[:JUMPS]> <MAX_ITERATIONS>\n", prog);
+    printf("  -j THREADS        Parallel mode: iteration i uses its own substream, the seed state\n");
+    printf("                    advanced by i jumps. The output does not depend on THREADS.\n");
+    printf("  -g GENERATOR      Uniform source: xoroshiro128plus (default, like the VHDL core),\n");
+    printf("                    xoshiro256pp, philox4x32 or threefry2x64\n");
+    printf("  -f FORMAT         double (default), float32, int16 (5,11) or int8 (6,2, see -r)\n");
+    printf("  -r FACTOR:OFFSET  Parameters of the int8 output remapper as raw (8,8) and (6,2)\n");
+    printf("                    values, default 256:0 (sigma = 1, mu = 0)\n");
+    printf("  -t THRESHOLD      Tail mode: samples |x| > THRESHOLD of the bit-exact boxmuller model,\n");
+    printf("                    drawn directly from the inputs that can reach it\n");
 }
 
 int main(int argc, char *argv[]) {
-    if (argc < 4) {
-        printf("%s: Not enough arguments!\n", argv[0]);
-        printf("Usage: %s <OUTFILE> <SEED> <MAX_ITERATIONS>\n", argv[0]);
-        return 1;
+    const char *prog = argv[0];
+    int threads = 0;
+    urng_kind_t kind = URNG_XOROSHIRO128PLUS;
+    double threshold = NAN;
+    block_cfg_t cfg = { .format = OUTPUT_DOUBLE, .factor = 256, .offset = 0 };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "j:g:f:r:t:")) != -1) {
+        switch (opt) {
+        case 'j':
+            if (sscanf(optarg, "%d", &threads) < 1 || threads < 1) {
+                printf("%s: Invalid argument, failed to interpret \"%s\" as thread count!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'g':
+            if (!urng_parse(optarg, &kind)) {
+                printf("%s: Invalid argument, unknown generator \"%s\"!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'f':
+            if (!output_format_parse(optarg, &cfg.format)) {
+                printf("%s: Invalid argument, unknown output format \"%s\"!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'r':
+            if (sscanf(optarg, "%hd:%hhd", &cfg.factor, &cfg.offset) < 2) {
+                printf("%s: Invalid argument, failed to interpret \"%s\" as FACTOR:OFFSET!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            if (sscanf(optarg, "%lf", &threshold) < 1 || !(threshold >= 0)) {
+                printf("%s: Invalid argument, failed to interpret \"%s\" as threshold!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            usage(prog);
+            return EXIT_FAILURE;
+        }
     }
-    
-    FILE *outfile = fopen(argv[1], "wb");
-    if (!outfile && errno) {
-        printf("%s: Failed to open output file: %s\n", argv[0], strerror(errno));
-        return EXIT_FAILURE;
+
+    if (argc - optind < 3) {
+        printf("%s: Not enough arguments!\n", prog);
+        usage(prog);
+        return 1;
     }
+    argv += optind - 1;
 
     uint64_t seed;
     size_t seed_jumps = 0;
     if (sscanf(argv[2], "%lx:%ld", &seed, &seed_jumps) < 1) {
-        printf("%s: Invalid argument, failed to interpret \"%s\" as hex-long!\n", argv[0], argv[2]);
+        printf("%s: Invalid argument, failed to interpret \"%s\" as hex-long!\n", prog, argv[2]);
         return EXIT_FAILURE;
     }
 
     int max_iterations;
-    if (sscanf(argv[3], "%d", &max_iterations) < 1) {
-        printf("%s: Invalid argument, failed to interpret \"%s\" as int!\n", argv[0], argv[3]);
+    if (sscanf(argv[3], "%d", &max_iterations) < 1 || max_iterations < 0) {
+        printf("%s: Invalid argument, failed to interpret \"%s\" as int!\n", prog, argv[3]);
         return EXIT_FAILURE;
     }
-    
-    xoroshiro128plus_t xoro;
-    xoroshiro128plus_init(&xoro, seed);
 
-    for (size_t i = 0; i < seed_jumps; i++)
-        xoroshiro128plus_jump(&xoro);
-
-    setup();
+    parallel_block_fn block_fn = generate_block;
+    tail_stats_t stats = { 0 };
+    if (!isnan(threshold)) {
+        cfg.bm = boxmuller_new();
+        cfg.tail = boxmuller_tail_new(cfg.bm, threshold);
+        cfg.stats = &stats;
+        block_fn = generate_tail_block;
+
+        if (!cfg.tail) {
+            printf("%s: No output of the boxmuller core exceeds %g!\n", prog, threshold);
+            return EXIT_FAILURE;
+        }
+    }
 
-    fxpnt_cfg_t *cfg = fxpnt_cfg(8, 32);
-    fxpnt_t gaussians[2];
+    size_t block_size = BLOCK_VALUES * output_format_size(cfg.format);
+    output_t *out = output_open(argv[1], block_size * max_iterations);
+    if (!out) {
+        printf("%s: Failed to open output file: %s\n", prog, strerror(errno));
+        return EXIT_FAILURE;
+    }
+    
+    urng_t g;
+    urng_init(&g, kind, seed);
 
-    double buffer[1024];
-
-    for (int i = 0; i < max_iterations; i++) {
-        for (size_t j = 0; j < (sizeof(buffer) / sizeof(*buffer));) {
-            uint64_t u = xoroshiro128plus_next(&xoro);
-            gaussian(u, cfg, gaussians);
-            
-            buffer[j] = fxpnt_to_double(cfg, gaussians[0]);
-            if (buffer[j] > 7)
-                j++;
-            else if (buffer[j] < -7) {
-                buffer[j] = -buffer[j];
-                j++;
-            }
+    // O(1) for all generators but xoshiro256++
+    if (!urng_seek(&g, seed_jumps, 0))
+        for (size_t i = 0; i < seed_jumps; i++)
+            urng_jump(&g);
 
-            if (j >= (sizeof(buffer) / sizeof(*buffer)))
-                break;
+    cfg.ctx = setup();
+    int ret = 0;
 
-            buffer[j] = fxpnt_to_double(cfg, gaussians[1]);
-            if (buffer[j] > 7)
-                j++;
-            else if (buffer[j] < -7) {
-                buffer[j] = -buffer[j];
-                j++;
+    if (threads) {
+        if (parallel_generate(out, &g, max_iterations, block_size, threads, block_fn, &cfg)) {
+            printf("%s: Failed to write output file: %s\n", prog, strerror(errno));
+            ret = EXIT_FAILURE;
+        }
+    } else if (out->map) {
+        // Sequential mode, all iterations share one stream
+        for (int i = 0; i < max_iterations; i++)
+            block_fn(&cfg, &g, out->map + i * block_size);
+    } else {
+        uint8_t buffer[BLOCK_VALUES * sizeof(double)];
+
+        for (int i = 0; i < max_iterations && !ret; i++) {
+            block_fn(&cfg, &g, buffer);
+
+            if (fwrite(buffer, 1, block_size, out->file) != block_size) {
+                printf("%s: Failed to write output file: %s\n", prog, strerror(errno));
+                ret = EXIT_FAILURE;
             }
         }
-
-        for (size_t w = 0; w < sizeof(buffer) / sizeof(*buffer);)
-            w += fwrite(buffer, sizeof(*buffer), sizeof(buffer)/sizeof(*buffer) - w, outfile);
     }
     
-    fclose(outfile);
+    if (output_close(out) && !ret) {
+        printf("%s: Failed to write output file: %s\n", prog, strerror(errno));
+        ret = EXIT_FAILURE;
+    }
 
-    teardown();
-    fxpnt_free(cfg);
+    teardown((gaussian_ctx_t *) cfg.ctx);
+
+    if (cfg.tail) {
+        // stderr, the samples may go to stdout
+        uint64_t draws = stats.draws, hits = stats.hits;
+        const boxmuller_tail_t *t = cfg.tail;
+        fprintf(stderr, "Tail region |x| > %g: %d leading zeros or more, weight %.6e\n",
+                threshold, t->strata[t->n_strata - 1].lz, t->weight);
+        for (int i = 0; i < t->n_strata; i++)
+            fprintf(stderr, "  lz = %2d: %5u of 65536 u_1\n", t->strata[i].lz, t->strata[i].n_u_1);
+        if (draws)
+            fprintf(stderr, "%lu of %lu outputs in the tail, P(|x| > %g) = %.6e\n",
+                    hits, 2 * draws, threshold, cfg.tail->weight * hits / (2.0 * draws));
+
+        boxmuller_tail_free((boxmuller_tail_t *) cfg.tail);
+        boxmuller_free((boxmuller_t *) cfg.bm);
+    }
     
-    return 0;
+    return ret;
 }
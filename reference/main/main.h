@@ -1,184 +1,301 @@
 #ifndef H_MAIN
 #define H_MAIN
 
-const fxpnt_t FXPNT_PP_LOG[] = {
-                 4,  4294954253, -2139123042,    16744537,  4278242469,
-       -2122540729,    33424042,  4261660233, -2106150488,    50039024,
-        4245206044, -2089949364,    66589978,  4228878425, -2073934460,
-          83077396,  4212675920, -2058102933,    99501765,  4196597098,
-       -2042451992,   115863565,  4180640547, -2026978903,   132163271,
-        4164804877, -2011680980,   148401352,  4149088722, -1996555590,
-         164578272,  4133490731, -1981600147,   180694491,  4118009579,
-       -1966812116,   196750462,  4102643957, -1952189006,   212746635,
-        4087392576, -1937728375,   228683452,  4072254168, -1923427825,
-         244561352,  4057227481, -1909285001,   260380771,  4042311284,
-       -1895297592,   276142137,  4027504362, -1881463329,   291845874,
-        4012805519, -1867779985,   307492402,  3998213576, -1854245373,
-         323082137,  3983727370, -1840857345,   338615489,  3969345758,
-       -1827613791,   354092866,  3955067609, -1814512641,   369514668,
-        3940891812, -1801551860,   384881294,  3926817270, -1788729450,
-         400193136,  3912842902, -1776043449,   415450585,  3898967642,
-       -1763491927,   430654025,  3885190439, -1751072992,   445803837,
-        3871510259, -1738784782,   460900398,  3857926079, -1726625470,
-         475944082,  3844436892, -1714593257,   490935257,  3831041707,
-       -1702686380,   505874289,  3817739542, -1690903103,   520761539,
-        3804529434, -1679241722,   535597364,  3791410429, -1667700562,
-         550382120,  3778381588, -1656277974,   565116156,  3765441986,
-       -1644972342,   579799819,  3752590708, -1633782072,   594433453,
-        3739826852, -1622705602,   609017396,  3727149531, -1611741393,
-         623551986,  3714557867, -1600887933,   638037556,  3702050995,
-       -1590143736,   652474434,  3689628061, -1579507340,   666862948,
-        3677288222, -1568977308,   681203420,  3665030649, -1558552226,
-         695496169,  3652854521, -1548230704,   709741513,  3640759029,
-       -1538011375,   723939765,  3628743375, -1527892895,   738091235,
-        3616806770, -1517873941,   752196231,  3604948438, -1507953211,
-         766255056,  3593167611, -1498129427,   780268012,  3581463532,
-       -1488401328,   794235398,  3569835452, -1478767677,   808157508,
-        3558282635, -1469227255,   822034636,  3546804351, -1459778862,
-         835867071,  3535399883, -1450421319,   849655100,  3524068519,
-       -1441153465,   863399007,  3512809560, -1431974156,   877099074,
-        3501622314, -1422882270,   890755579,  3490506097, -1413876699,
-         904368799,  3479460236, -1404956354,   917939007,  3468484064,
-       -1396120163,   931466474,  3457576924, -1387367071,   944951469,
-        3446738167, -1378696039,   958394257,  3435967153, -1370106044,
-         971795102,  3425263246, -1361596080,   985154264,  3414625824,
-       -1353165157,   998472003,  3404054267, -1344812297,  1011748574,
-        3393547967, -1336536540,  1024984231,  3383106320, -1328336940,
-        1038179225,  3372728732, -1320212566,  1051333806,  3362414615,
-       -1312162500,  1064448220,  3352163389, -1304185839,  1077522712,
-        3341974480, -1296281693,  1090557524,  3331847322, -1288449185,
-        1103552897,  3321781355, -1280687453,  1116509067,  3311776025,
-       -1272995647,  1129426272,  3301830788, -1265372928,  1142304744,
-        3291945102, -1257818472,  1155144716,  3282118435, -1250331468,
-        1167946416,  3272350260, -1242911112,  1180710073,  3262640056,
-       -1235556617,  1193435911,  3252987308, -1228267207,  1206124154,
-        3243391509, -1221042114,  1218775025,  3233852155, -1213880586,
-        1231388741,  3224368750, -1206781878,  1243965521,  3214940803,
-       -1199745257,  1256505580,  3205567830, -1192770003,  1269009133,
-        3196249350, -1185855402,  1281476391,  3186984890, -1179000755,
-        1293907564,  3177773982, -1172205370,  1306302860,  3168616162,
-       -1165468565,  1318662487,  3159510973, -1158789670,  1330986648,
-        3150457963, -1152168023,  1343275547,  3141456683, -1145602970,
-        1355529385,  3132506693, -1139093870,  1367748362,  3123607555,
-       -1132640088,  1379932674,  3114758837, -1126240998,  1392082519,
-        3105960111, -1119895986,  1404198091,  3097210955, -1113604442,
-        1416279582,  3088510952, -1107365769,  1428327184,  3079859688,
-       -1101179375,  1440341086,  3071256754, -1095044678,  1452321477,
-        3062701748, -1088961103,  1464268542,  3054194269, -1082928084,
-        1476182468,  3045733923, -1076945062,  1488063436,  3037320319,
-       -1071011488,  1499911629,  3028953071, -1065126815,  1511727227,
-        3020631796, -1059290510,  1523510410,  3012356118, -1053502044,
-        1535261354,  3004125661, -1047760894,  1546980235,  2995940057,
-       -1042066548,  1558667228,  2987798939, -1036418496,  1570322506,
-        2979701947, -1030816240,  1581946240,  2971648722, -1025259285,
-        1593538602,  2963638910, -1019747144,  1605099759,  2955672162,
-       -1014279336,  1616629879,  2947748130, -1008855388,  1628129129,
-        2939866473, -1003474832,  1639597674,  2932026852,  -998137205,
-        1651035676,  2924228930,  -992842053,  1662443298,  2916472376,
-        -987588925,  1673820702,  2908756862,  -982377380,  1685168046,
-        2901082063,  -977206977,  1696485489,  2893447658,  -972077287,
-        1707773189,  2885853328,  -966987882,  1719031301,  2878298759,
-        -961938342,  1730259980,  2870783639,  -956928251,  1741459380,
-        2863307660,  -951957200,  1752629652,  2855870517,  -947024784,
-        1763770948,  2848471909,  -942130604,  1774883418,  2841111536,
-        -937274265,  1785967211,  2833789103,  -932455379,  1797022474,
-        2826504317,  -927673561,  1808049354,  2819256889,  -922928433,
-        1819047996,  2812046532,  -918219618,  1830018544,  2804872963,
-        -913546749,  1840961142,  2797735900,  -908909460,  1851875931,
-        2790635065,  -904307391,  1862763053,  2783570185,  -899740186,
-        1873622647,  2776540985,  -895207494,  1884454853,  2769547197,
-        -890708968,  1895259808,  2762588553,  -886244266,  1906037649,
-        2755664789,  -881813048,  1916788511,  2748775644,  -877414982,
-        1927512530,  2741920859,  -873049737,  1938209839,  2735100177,
-        -868716988,  1948880570,  2728313345,  -864416412,  1959524857,
-        2721560111,  -860147694,  1970142828,  2714840226,  -855910516,
-        1980734615,  2708153443,  -851704571,  1991300345,  2701499519,
-        -847529552,  2001840148,  2694878213,  -843385157,  2012354149,
-        2688289284,  -839271087,  2022842474,  2681732497,  -835187046,
-        2033305250,  2675207616,  -831132744,  2043742600,  2668714408,
-        -827107891,  2054154647,  2662252645,  -823112204,  2064541514,
-        2655822098,  -819145401,  2074903322,  2649422542,  -815207206,
-        2085240191,  2643053752,  -811297342,  2095552242,  2636715508,
-        -807415540,  2105839594,  2630407591,  -803561531,  2116102364,
-        2624129783,  -799735051,  2126340670,  2617881869,  -795935837,
-        2136554628,  2611663636,  -792163633,  2146744354,  2605474874,
-        -788418181,  2156909962,  2599315372,  -784699230,  2167051566,
-        2593184925,  -781006530,  2177169279,  2587083327,  -777339837,
-        2187263214,  2581010375,  -773698904,  2197333482,  2574965867,
-        -770083491,  2207380193,  2568949605,  -766493361,  2217403459,
-        2562961390,  -762928278,  2227403387,  2557001028,  -759388010,
-        2237380087,  2551068324,  -755872328,  2247333666,  2545163085,
-        -752381003,  2257264230,  2539285123,  -748913812,  2267171887,
-        2533434248,  -745470533,  2277056741,  2527610274,  -742050946,
-        2286918898,  2521813015,  -738654834,  2296758461,  2516042287,
-        -735281984,  2306575533,  2510297911,  -731932182,  2316370217,
-        2504579704,  -728605220,  2326142616,  2498887489,  -725300891,
-        2335892830,  2493221089,  -722018989,  2345620959,  2487580329,
-        -718759311,  2355327104,  2481965035,  -715521659,  2365011364,
-        2476375035,  -712305834,  2374673836,  2470810158,  -709111640,
-        2384314620,  2465270236,  -705938883,  2393933812,  2459755101,
-        -702787372,  2403531508,  2454264588,  -699656919,  2413107805,
-        2448798530,  -696547334,  2422662797,  2443356766,  -693458435,
-        2432196579,  2437939135,  -690390037,  2441709246,  2432545474,
-        -687341960,  2451200891,  2427175627,  -684314023,  2460671605,
-        2421829436,  -681306052,  2470121482,  2416506744,  -678317869,
-        2479550613,  2411207397,  -675349302,  2488959088,  2405931242,
-        -672400182,  2498346998,  2400678127,  -669470336,  2507714433,
-        2395447902,  -666559596,  2517061482,  2390240416,  -663667800,
-        2526388234,  2385055523,  -660794781,  2535694775,  2379893074,
-        -657940378,  2544981195,  2374752926,  -655104429,  2554247579,
-        2369634934,  -652286778,  2563494013,  2364538954,  -649487266,
-        2572720585,  2359464845,  -646705737,  2581927378,  2354412467,
-        -643942039,  2591114477,  2349381680,  -641196020,  2600281967,
-        2344372347,  -638467528,  2609429930,  2339384330,  -635756414,
-        2618558451,  2334417493,  -633062534,  2627667611,  2329471702,
-        -630385738,  2636757492,  2324546823,  -627725884,  2645828176,
-        2319642725,  -625082830,  2654879744,  2314759275,  -622456433,
-        2663912276,  2309896344,  -619846554,  2672925852,  2305053803,
-        -617253057,  2681920551,  2300231523,  -614675800,  2690896452,
-        2295429378,  -612114653,  2699853634,  2290647241,  -609569479,
-        2708792175,  2285884989,  -607040147,  2717712152,  2281142497,
-        -604526524,  2726613642,  2276419643,  -602028482,  2735496721,
-        2271716305,  -599545892,  2744361466,  2267032362,  -597078627,
-        2753207951,  2262367694,  -594626560,  2762036253,  2257722183,
-        -592189567,  2770846446,  2253095711,  -589767525,  2779638603,
-        2248488161,  -587360313,  2788412799,  2243899417,  -584967808,
-        2797169106,  2239329364,  -582589890,  2805907598,  2234777889,
-        -580226445,  2814628347,  2230244879,  -577877351,  2823331424,
-        2225730221,  -575542494,  2832016902,  2221233803,  -573221760,
-        2840684851,  2216755516,  -570915034,  2849335342,  2212295251,
-        -568622203,  2857968445,  2207852898,  -566343158,  2866584230,
-        2203428350,  -564077787,  2875182766,  2199021501,  -561825980,
-        2883764122,  2194632243,  -559587631,  2892328366,  2190260473,
-        -557362631,  2900875568,  2185906085,  -555150877,  2909405794,
-        2181568977,  -552952260,  2917919111,  2177249045,  -550766680,
-        2926415587,  2172946188,  -548594031,  2934895289,  2168660304,
-        -546434214,  2943358281,  2164391295,  -544287125,  2951804631,
-        2160139059,  -542152668,  2960234402,  2155903499,  -540030740,
-        2968647661,  2151684516,  -537921246};
+static const FXPNT_PP_ALIGN fxpnt_pp2_seg_t FXPNT_PP_LOG[256] = {
+    {            4,   4294954253,  -2139123042, 0 },
+    {     16744537,   4278242469,  -2122540729, 0 },
+    {     33424042,   4261660233,  -2106150488, 0 },
+    {     50039024,   4245206044,  -2089949364, 0 },
+    {     66589978,   4228878425,  -2073934460, 0 },
+    {     83077396,   4212675920,  -2058102933, 0 },
+    {     99501765,   4196597098,  -2042451992, 0 },
+    {    115863565,   4180640547,  -2026978903, 0 },
+    {    132163271,   4164804877,  -2011680980, 0 },
+    {    148401352,   4149088722,  -1996555590, 0 },
+    {    164578272,   4133490731,  -1981600147, 0 },
+    {    180694491,   4118009579,  -1966812116, 0 },
+    {    196750462,   4102643957,  -1952189006, 0 },
+    {    212746635,   4087392576,  -1937728375, 0 },
+    {    228683452,   4072254168,  -1923427825, 0 },
+    {    244561352,   4057227481,  -1909285001, 0 },
+    {    260380771,   4042311284,  -1895297592, 0 },
+    {    276142137,   4027504362,  -1881463329, 0 },
+    {    291845874,   4012805519,  -1867779985, 0 },
+    {    307492402,   3998213576,  -1854245373, 0 },
+    {    323082137,   3983727370,  -1840857345, 0 },
+    {    338615489,   3969345758,  -1827613791, 0 },
+    {    354092866,   3955067609,  -1814512641, 0 },
+    {    369514668,   3940891812,  -1801551860, 0 },
+    {    384881294,   3926817270,  -1788729450, 0 },
+    {    400193136,   3912842902,  -1776043449, 0 },
+    {    415450585,   3898967642,  -1763491927, 0 },
+    {    430654025,   3885190439,  -1751072992, 0 },
+    {    445803837,   3871510259,  -1738784782, 0 },
+    {    460900398,   3857926079,  -1726625470, 0 },
+    {    475944082,   3844436892,  -1714593257, 0 },
+    {    490935257,   3831041707,  -1702686380, 0 },
+    {    505874289,   3817739542,  -1690903103, 0 },
+    {    520761539,   3804529434,  -1679241722, 0 },
+    {    535597364,   3791410429,  -1667700562, 0 },
+    {    550382120,   3778381588,  -1656277974, 0 },
+    {    565116156,   3765441986,  -1644972342, 0 },
+    {    579799819,   3752590708,  -1633782072, 0 },
+    {    594433453,   3739826852,  -1622705602, 0 },
+    {    609017396,   3727149531,  -1611741393, 0 },
+    {    623551986,   3714557867,  -1600887933, 0 },
+    {    638037556,   3702050995,  -1590143736, 0 },
+    {    652474434,   3689628061,  -1579507340, 0 },
+    {    666862948,   3677288222,  -1568977308, 0 },
+    {    681203420,   3665030649,  -1558552226, 0 },
+    {    695496169,   3652854521,  -1548230704, 0 },
+    {    709741513,   3640759029,  -1538011375, 0 },
+    {    723939765,   3628743375,  -1527892895, 0 },
+    {    738091235,   3616806770,  -1517873941, 0 },
+    {    752196231,   3604948438,  -1507953211, 0 },
+    {    766255056,   3593167611,  -1498129427, 0 },
+    {    780268012,   3581463532,  -1488401328, 0 },
+    {    794235398,   3569835452,  -1478767677, 0 },
+    {    808157508,   3558282635,  -1469227255, 0 },
+    {    822034636,   3546804351,  -1459778862, 0 },
+    {    835867071,   3535399883,  -1450421319, 0 },
+    {    849655100,   3524068519,  -1441153465, 0 },
+    {    863399007,   3512809560,  -1431974156, 0 },
+    {    877099074,   3501622314,  -1422882270, 0 },
+    {    890755579,   3490506097,  -1413876699, 0 },
+    {    904368799,   3479460236,  -1404956354, 0 },
+    {    917939007,   3468484064,  -1396120163, 0 },
+    {    931466474,   3457576924,  -1387367071, 0 },
+    {    944951469,   3446738167,  -1378696039, 0 },
+    {    958394257,   3435967153,  -1370106044, 0 },
+    {    971795102,   3425263246,  -1361596080, 0 },
+    {    985154264,   3414625824,  -1353165157, 0 },
+    {    998472003,   3404054267,  -1344812297, 0 },
+    {   1011748574,   3393547967,  -1336536540, 0 },
+    {   1024984231,   3383106320,  -1328336940, 0 },
+    {   1038179225,   3372728732,  -1320212566, 0 },
+    {   1051333806,   3362414615,  -1312162500, 0 },
+    {   1064448220,   3352163389,  -1304185839, 0 },
+    {   1077522712,   3341974480,  -1296281693, 0 },
+    {   1090557524,   3331847322,  -1288449185, 0 },
+    {   1103552897,   3321781355,  -1280687453, 0 },
+    {   1116509067,   3311776025,  -1272995647, 0 },
+    {   1129426272,   3301830788,  -1265372928, 0 },
+    {   1142304744,   3291945102,  -1257818472, 0 },
+    {   1155144716,   3282118435,  -1250331468, 0 },
+    {   1167946416,   3272350260,  -1242911112, 0 },
+    {   1180710073,   3262640056,  -1235556617, 0 },
+    {   1193435911,   3252987308,  -1228267207, 0 },
+    {   1206124154,   3243391509,  -1221042114, 0 },
+    {   1218775025,   3233852155,  -1213880586, 0 },
+    {   1231388741,   3224368750,  -1206781878, 0 },
+    {   1243965521,   3214940803,  -1199745257, 0 },
+    {   1256505580,   3205567830,  -1192770003, 0 },
+    {   1269009133,   3196249350,  -1185855402, 0 },
+    {   1281476391,   3186984890,  -1179000755, 0 },
+    {   1293907564,   3177773982,  -1172205370, 0 },
+    {   1306302860,   3168616162,  -1165468565, 0 },
+    {   1318662487,   3159510973,  -1158789670, 0 },
+    {   1330986648,   3150457963,  -1152168023, 0 },
+    {   1343275547,   3141456683,  -1145602970, 0 },
+    {   1355529385,   3132506693,  -1139093870, 0 },
+    {   1367748362,   3123607555,  -1132640088, 0 },
+    {   1379932674,   3114758837,  -1126240998, 0 },
+    {   1392082519,   3105960111,  -1119895986, 0 },
+    {   1404198091,   3097210955,  -1113604442, 0 },
+    {   1416279582,   3088510952,  -1107365769, 0 },
+    {   1428327184,   3079859688,  -1101179375, 0 },
+    {   1440341086,   3071256754,  -1095044678, 0 },
+    {   1452321477,   3062701748,  -1088961103, 0 },
+    {   1464268542,   3054194269,  -1082928084, 0 },
+    {   1476182468,   3045733923,  -1076945062, 0 },
+    {   1488063436,   3037320319,  -1071011488, 0 },
+    {   1499911629,   3028953071,  -1065126815, 0 },
+    {   1511727227,   3020631796,  -1059290510, 0 },
+    {   1523510410,   3012356118,  -1053502044, 0 },
+    {   1535261354,   3004125661,  -1047760894, 0 },
+    {   1546980235,   2995940057,  -1042066548, 0 },
+    {   1558667228,   2987798939,  -1036418496, 0 },
+    {   1570322506,   2979701947,  -1030816240, 0 },
+    {   1581946240,   2971648722,  -1025259285, 0 },
+    {   1593538602,   2963638910,  -1019747144, 0 },
+    {   1605099759,   2955672162,  -1014279336, 0 },
+    {   1616629879,   2947748130,  -1008855388, 0 },
+    {   1628129129,   2939866473,  -1003474832, 0 },
+    {   1639597674,   2932026852,   -998137205, 0 },
+    {   1651035676,   2924228930,   -992842053, 0 },
+    {   1662443298,   2916472376,   -987588925, 0 },
+    {   1673820702,   2908756862,   -982377380, 0 },
+    {   1685168046,   2901082063,   -977206977, 0 },
+    {   1696485489,   2893447658,   -972077287, 0 },
+    {   1707773189,   2885853328,   -966987882, 0 },
+    {   1719031301,   2878298759,   -961938342, 0 },
+    {   1730259980,   2870783639,   -956928251, 0 },
+    {   1741459380,   2863307660,   -951957200, 0 },
+    {   1752629652,   2855870517,   -947024784, 0 },
+    {   1763770948,   2848471909,   -942130604, 0 },
+    {   1774883418,   2841111536,   -937274265, 0 },
+    {   1785967211,   2833789103,   -932455379, 0 },
+    {   1797022474,   2826504317,   -927673561, 0 },
+    {   1808049354,   2819256889,   -922928433, 0 },
+    {   1819047996,   2812046532,   -918219618, 0 },
+    {   1830018544,   2804872963,   -913546749, 0 },
+    {   1840961142,   2797735900,   -908909460, 0 },
+    {   1851875931,   2790635065,   -904307391, 0 },
+    {   1862763053,   2783570185,   -899740186, 0 },
+    {   1873622647,   2776540985,   -895207494, 0 },
+    {   1884454853,   2769547197,   -890708968, 0 },
+    {   1895259808,   2762588553,   -886244266, 0 },
+    {   1906037649,   2755664789,   -881813048, 0 },
+    {   1916788511,   2748775644,   -877414982, 0 },
+    {   1927512530,   2741920859,   -873049737, 0 },
+    {   1938209839,   2735100177,   -868716988, 0 },
+    {   1948880570,   2728313345,   -864416412, 0 },
+    {   1959524857,   2721560111,   -860147694, 0 },
+    {   1970142828,   2714840226,   -855910516, 0 },
+    {   1980734615,   2708153443,   -851704571, 0 },
+    {   1991300345,   2701499519,   -847529552, 0 },
+    {   2001840148,   2694878213,   -843385157, 0 },
+    {   2012354149,   2688289284,   -839271087, 0 },
+    {   2022842474,   2681732497,   -835187046, 0 },
+    {   2033305250,   2675207616,   -831132744, 0 },
+    {   2043742600,   2668714408,   -827107891, 0 },
+    {   2054154647,   2662252645,   -823112204, 0 },
+    {   2064541514,   2655822098,   -819145401, 0 },
+    {   2074903322,   2649422542,   -815207206, 0 },
+    {   2085240191,   2643053752,   -811297342, 0 },
+    {   2095552242,   2636715508,   -807415540, 0 },
+    {   2105839594,   2630407591,   -803561531, 0 },
+    {   2116102364,   2624129783,   -799735051, 0 },
+    {   2126340670,   2617881869,   -795935837, 0 },
+    {   2136554628,   2611663636,   -792163633, 0 },
+    {   2146744354,   2605474874,   -788418181, 0 },
+    {   2156909962,   2599315372,   -784699230, 0 },
+    {   2167051566,   2593184925,   -781006530, 0 },
+    {   2177169279,   2587083327,   -777339837, 0 },
+    {   2187263214,   2581010375,   -773698904, 0 },
+    {   2197333482,   2574965867,   -770083491, 0 },
+    {   2207380193,   2568949605,   -766493361, 0 },
+    {   2217403459,   2562961390,   -762928278, 0 },
+    {   2227403387,   2557001028,   -759388010, 0 },
+    {   2237380087,   2551068324,   -755872328, 0 },
+    {   2247333666,   2545163085,   -752381003, 0 },
+    {   2257264230,   2539285123,   -748913812, 0 },
+    {   2267171887,   2533434248,   -745470533, 0 },
+    {   2277056741,   2527610274,   -742050946, 0 },
+    {   2286918898,   2521813015,   -738654834, 0 },
+    {   2296758461,   2516042287,   -735281984, 0 },
+    {   2306575533,   2510297911,   -731932182, 0 },
+    {   2316370217,   2504579704,   -728605220, 0 },
+    {   2326142616,   2498887489,   -725300891, 0 },
+    {   2335892830,   2493221089,   -722018989, 0 },
+    {   2345620959,   2487580329,   -718759311, 0 },
+    {   2355327104,   2481965035,   -715521659, 0 },
+    {   2365011364,   2476375035,   -712305834, 0 },
+    {   2374673836,   2470810158,   -709111640, 0 },
+    {   2384314620,   2465270236,   -705938883, 0 },
+    {   2393933812,   2459755101,   -702787372, 0 },
+    {   2403531508,   2454264588,   -699656919, 0 },
+    {   2413107805,   2448798530,   -696547334, 0 },
+    {   2422662797,   2443356766,   -693458435, 0 },
+    {   2432196579,   2437939135,   -690390037, 0 },
+    {   2441709246,   2432545474,   -687341960, 0 },
+    {   2451200891,   2427175627,   -684314023, 0 },
+    {   2460671605,   2421829436,   -681306052, 0 },
+    {   2470121482,   2416506744,   -678317869, 0 },
+    {   2479550613,   2411207397,   -675349302, 0 },
+    {   2488959088,   2405931242,   -672400182, 0 },
+    {   2498346998,   2400678127,   -669470336, 0 },
+    {   2507714433,   2395447902,   -666559596, 0 },
+    {   2517061482,   2390240416,   -663667800, 0 },
+    {   2526388234,   2385055523,   -660794781, 0 },
+    {   2535694775,   2379893074,   -657940378, 0 },
+    {   2544981195,   2374752926,   -655104429, 0 },
+    {   2554247579,   2369634934,   -652286778, 0 },
+    {   2563494013,   2364538954,   -649487266, 0 },
+    {   2572720585,   2359464845,   -646705737, 0 },
+    {   2581927378,   2354412467,   -643942039, 0 },
+    {   2591114477,   2349381680,   -641196020, 0 },
+    {   2600281967,   2344372347,   -638467528, 0 },
+    {   2609429930,   2339384330,   -635756414, 0 },
+    {   2618558451,   2334417493,   -633062534, 0 },
+    {   2627667611,   2329471702,   -630385738, 0 },
+    {   2636757492,   2324546823,   -627725884, 0 },
+    {   2645828176,   2319642725,   -625082830, 0 },
+    {   2654879744,   2314759275,   -622456433, 0 },
+    {   2663912276,   2309896344,   -619846554, 0 },
+    {   2672925852,   2305053803,   -617253057, 0 },
+    {   2681920551,   2300231523,   -614675800, 0 },
+    {   2690896452,   2295429378,   -612114653, 0 },
+    {   2699853634,   2290647241,   -609569479, 0 },
+    {   2708792175,   2285884989,   -607040147, 0 },
+    {   2717712152,   2281142497,   -604526524, 0 },
+    {   2726613642,   2276419643,   -602028482, 0 },
+    {   2735496721,   2271716305,   -599545892, 0 },
+    {   2744361466,   2267032362,   -597078627, 0 },
+    {   2753207951,   2262367694,   -594626560, 0 },
+    {   2762036253,   2257722183,   -592189567, 0 },
+    {   2770846446,   2253095711,   -589767525, 0 },
+    {   2779638603,   2248488161,   -587360313, 0 },
+    {   2788412799,   2243899417,   -584967808, 0 },
+    {   2797169106,   2239329364,   -582589890, 0 },
+    {   2805907598,   2234777889,   -580226445, 0 },
+    {   2814628347,   2230244879,   -577877351, 0 },
+    {   2823331424,   2225730221,   -575542494, 0 },
+    {   2832016902,   2221233803,   -573221760, 0 },
+    {   2840684851,   2216755516,   -570915034, 0 },
+    {   2849335342,   2212295251,   -568622203, 0 },
+    {   2857968445,   2207852898,   -566343158, 0 },
+    {   2866584230,   2203428350,   -564077787, 0 },
+    {   2875182766,   2199021501,   -561825980, 0 },
+    {   2883764122,   2194632243,   -559587631, 0 },
+    {   2892328366,   2190260473,   -557362631, 0 },
+    {   2900875568,   2185906085,   -555150877, 0 },
+    {   2909405794,   2181568977,   -552952260, 0 },
+    {   2917919111,   2177249045,   -550766680, 0 },
+    {   2926415587,   2172946188,   -548594031, 0 },
+    {   2934895289,   2168660304,   -546434214, 0 },
+    {   2943358281,   2164391295,   -544287125, 0 },
+    {   2951804631,   2160139059,   -542152668, 0 },
+    {   2960234402,   2155903499,   -540030740, 0 },
+    {   2968647661,   2151684516,   -537921246, 0 }
+};
 
-const fxpnt_t FXPNT_PP_SQRT[] = {
-       4294970355, 2146890423, -512779898, 4427153594, 2082853641,
-       -469448490, 4555503045, 2024222266, -431894241, 4680334113,
-       1970276598, -399093429, 4801921191, 1920424269, -370244321,
-       4920504759, 1874172681, -344711050, 5036296977, 1831108399,
-       -321983515, 5149486146, 1790881512, -301648261, 5260240303,
-       1753193617, -283367000, 5368710146, 1717788463, -266860561,
-       5475031445, 1684444596, -251896733, 5579327029, 1652969511,
-       -238280960, 5681708453, 1623194962, -225849137, 5782277394,
-       1594973169, -214461979, 5881126834, 1568173724, -204000586,
-       5978342066, 1542681052, -194362907};
+static const FXPNT_PP_ALIGN fxpnt_pp2_seg_t FXPNT_PP_SQRT[16] = {
+    {   4294970355,   2146890423,   -512779898, 0 },
+    {   4427153594,   2082853641,   -469448490, 0 },
+    {   4555503045,   2024222266,   -431894241, 0 },
+    {   4680334113,   1970276598,   -399093429, 0 },
+    {   4801921191,   1920424269,   -370244321, 0 },
+    {   4920504759,   1874172681,   -344711050, 0 },
+    {   5036296977,   1831108399,   -321983515, 0 },
+    {   5149486146,   1790881512,   -301648261, 0 },
+    {   5260240303,   1753193617,   -283367000, 0 },
+    {   5368710146,   1717788463,   -266860561, 0 },
+    {   5475031445,   1684444596,   -251896733, 0 },
+    {   5579327029,   1652969511,   -238280960, 0 },
+    {   5681708453,   1623194962,   -225849137, 0 },
+    {   5782277394,   1594973169,   -214461979, 0 },
+    {   5881126834,   1568173724,   -204000586, 0 },
+    {   5978342066,   1542681052,   -194362907, 0 }
+};
 
-const fxpnt_t FXPNT_PP_COS[] = {
-        4294968716,     -243050, -5291408405,  4274290574,  -662152860,
-       -5240449250,  4212448678, -1317685776, -5139021703,  4110038598,
-       -1960528658, -4988102568,  3968046599, -2584490577, -4789145279,
-        3787840142, -3183562439, -4544065903,  3571154714, -3751974854,
-       -4255224687,  3320077114, -4284253701, -3925403333,  3037025357,
-       -4775272842, -3557778198,  2724725385, -5220303496, -3155889714,
-        2386184818, -5615059773, -2723608287,  2024663987, -5955739955,
-       -2265097023,  1643644535, -6239063105, -1784771637,  1246795888,
-       -6462300667, -1287257924,   837939914, -6623302742,  -777347214,
-         421014121, -6720518789,  -259950225};
+static const FXPNT_PP_ALIGN fxpnt_pp2_seg_t FXPNT_PP_COS[16] = {
+    {   4294968716,      -243050,  -5291408405, 0 },
+    {   4274290574,   -662152860,  -5240449250, 0 },
+    {   4212448678,  -1317685776,  -5139021703, 0 },
+    {   4110038598,  -1960528658,  -4988102568, 0 },
+    {   3968046599,  -2584490577,  -4789145279, 0 },
+    {   3787840142,  -3183562439,  -4544065903, 0 },
+    {   3571154714,  -3751974854,  -4255224687, 0 },
+    {   3320077114,  -4284253701,  -3925403333, 0 },
+    {   3037025357,  -4775272842,  -3557778198, 0 },
+    {   2724725385,  -5220303496,  -3155889714, 0 },
+    {   2386184818,  -5615059773,  -2723608287, 0 },
+    {   2024663987,  -5955739955,  -2265097023, 0 },
+    {   1643644535,  -6239063105,  -1784771637, 0 },
+    {   1246795888,  -6462300667,  -1287257924, 0 },
+    {    837939914,  -6623302742,   -777347214, 0 },
+    {    421014121,  -6720518789,   -259950225, 0 }
+};
 
 #endif
@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "output.h"
+
+static const struct {
+    const char *name;
+    size_t size;
+} FORMATS[] = {
+    [OUTPUT_DOUBLE] = { "double", sizeof(double) },
+    [OUTPUT_FLOAT32] = { "float32", sizeof(float) },
+    [OUTPUT_INT16] = { "int16", sizeof(int16_t) },
+    [OUTPUT_INT8] = { "int8", sizeof(int8_t) }
+};
+
+bool output_format_parse(const char *name, output_format_t *format) {
+    for (size_t i = 0; i < sizeof(FORMATS) / sizeof(*FORMATS); i++)
+        if (!strcmp(name, FORMATS[i].name)) {
+            *format = i;
+            return true;
+        }
+
+    return false;
+}
+
+size_t output_format_size(output_format_t format) {
+    return FORMATS[format].size;
+}
+
+output_t *output_open(const char *path, size_t size) {
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0)
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0)
+        return NULL;
+
+    output_t *out = calloc(1, sizeof(output_t));
+    out->size = size;
+
+    struct stat st;
+    if (size && !fstat(fd, &st) && S_ISREG(st.st_mode)) {
+        // Reserve the blocks as well, a full disk would otherwise only show up
+        // as SIGBUS while writing to the mapping
+        int err = ftruncate(fd, size) ? errno : posix_fallocate(fd, 0, size);
+        if (err && err != EINVAL && err != EOPNOTSUPP) {
+            close(fd);
+            free(out);
+            errno = err;
+            return NULL;
+        }
+
+        void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, size, MADV_SEQUENTIAL);
+            out->map = map;
+        }
+    }
+
+    // The mapping stays valid after closing the descriptor
+    if (out->map) {
+        close(fd);
+        return out;
+    }
+
+    out->file = fdopen(fd, "wb");
+    if (!out->file) {
+        close(fd);
+        free(out);
+        return NULL;
+    }
+
+    return out;
+}
+
+int output_close(output_t *out) {
+    int ret = 0;
+
+    if (out->map) {
+        // Write back before unmapping, so that I/O errors are reported
+        if (msync(out->map, out->size, MS_SYNC))
+            ret = -1;
+        if (munmap(out->map, out->size))
+            ret = -1;
+    }
+    if (out->file && fclose(out->file))
+        ret = -1;
+
+    free(out);
+    return ret;
+}
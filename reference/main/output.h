@@ -0,0 +1,39 @@
+#ifndef H_OUTPUT
+#define H_OUTPUT
+
+/* Sample formats of the output file, all in host byte order */
+typedef enum output_format_t {
+    OUTPUT_DOUBLE,      // IEEE-754 double
+    OUTPUT_FLOAT32,     // IEEE-754 single
+    OUTPUT_INT16,       // (5,11) fixed point, like the x_0/x_1 ports of boxmuller.vhd
+    OUTPUT_INT8         // (6,2), remapped like the data lanes of grng_16
+} output_format_t;
+
+bool output_format_parse(const char *name, output_format_t *format);
+
+size_t output_format_size(output_format_t format);
+
+/*
+ * Output file of a known size. Regular files are pre-sized and mapped, so
+ * samples can be generated directly into map. Everything else (pipes,
+ * character devices) is written sequentially through file, map is NULL then.
+ */
+typedef struct output_t {
+    FILE *file;
+    uint8_t *map;
+    size_t size;
+} output_t;
+
+/*
+ * Returns NULL with errno set if the file can not be opened or a regular file
+ * can not be resized to size bytes.
+ */
+output_t *output_open(const char *path, size_t size);
+
+/*
+ * Writes back the mapping, unmaps and closes the file. Returns 0 on success,
+ * or -1 with errno set.
+ */
+int output_close(output_t *out);
+
+#endif
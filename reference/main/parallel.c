@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "xoroshiro128plus.h"
+#include "urng.h"
+
+#include "output.h"
+#include "parallel.h"
+
+/*
+ * Every thread owns two slots, so workers can run ahead while the previous
+ * block is written. Block i always goes to slot i % slots.
+ */
+#define SLOTS_PER_THREAD 2
+
+typedef struct parallel_t {
+    pthread_mutex_t lock;
+    pthread_cond_t slot_free;   // signalled by the writer
+    pthread_cond_t slot_done;   // signalled by the workers
+
+    size_t blocks, block_size, slots;
+    size_t next_block;          // next block to be claimed by a worker
+    size_t next_write;          // next block to be written
+    bool abort;
+
+    urng_t next_g;              // substream of next_block
+
+    uint8_t *map;               // mapped output file, or NULL
+    uint8_t *buffer;            // one block per slot, if map is NULL
+    bool *done;
+
+    parallel_block_fn fn;
+    void *arg;
+} parallel_t;
+
+static void *worker(void *p) {
+    parallel_t *ctx = p;
+
+    pthread_mutex_lock(&ctx->lock);
+    for (;;) {
+        while (!ctx->abort && !ctx->map && ctx->next_block < ctx->blocks
+                && ctx->next_block - ctx->next_write >= ctx->slots)
+            pthread_cond_wait(&ctx->slot_free, &ctx->lock);
+
+        if (ctx->abort || ctx->next_block >= ctx->blocks)
+            break;
+
+        // Substreams are handed out in block order, one jump per block
+        size_t i = ctx->next_block++;
+        urng_t g = ctx->next_g;
+        urng_jump(&ctx->next_g);
+        pthread_mutex_unlock(&ctx->lock);
+
+        if (ctx->map) {
+            ctx->fn(ctx->arg, &g, ctx->map + i * ctx->block_size);
+            pthread_mutex_lock(&ctx->lock);
+            continue;
+        }
+
+        ctx->fn(ctx->arg, &g, ctx->buffer + (i % ctx->slots) * ctx->block_size);
+
+        pthread_mutex_lock(&ctx->lock);
+        ctx->done[i % ctx->slots] = true;
+        pthread_cond_broadcast(&ctx->slot_done);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    return NULL;
+}
+
+int parallel_generate(output_t *out, const urng_t *base, size_t blocks, size_t block_size,
+        int threads, parallel_block_fn fn, void *arg) {
+    if (threads < 1)
+        threads = 1;
+
+    parallel_t ctx = {
+        .blocks = blocks,
+        .block_size = block_size,
+        .slots = (size_t) threads * SLOTS_PER_THREAD,
+        .next_g = *base,
+        .map = out->map,
+        .fn = fn,
+        .arg = arg
+    };
+
+    if (!ctx.map) {
+        ctx.buffer = malloc(ctx.slots * block_size);
+        ctx.done = calloc(ctx.slots, sizeof(bool));
+    }
+    pthread_t *pool = malloc(threads * sizeof(pthread_t));
+    if ((!ctx.map && (!ctx.buffer || !ctx.done)) || !pool) {
+        free(ctx.buffer);
+        free(ctx.done);
+        free(pool);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    pthread_mutex_init(&ctx.lock, NULL);
+    pthread_cond_init(&ctx.slot_free, NULL);
+    pthread_cond_init(&ctx.slot_done, NULL);
+
+    int started = 0;
+    for (; started < threads; started++)
+        if (pthread_create(&pool[started], NULL, worker, &ctx))
+            break;
+
+    int ret = started ? 0 : -1;
+    int err = started ? 0 : EAGAIN;
+
+    // The calling thread writes the finished blocks in order
+    for (size_t i = 0; i < blocks && !ret && !ctx.map; i++) {
+        size_t slot = i % ctx.slots;
+
+        pthread_mutex_lock(&ctx.lock);
+        while (!ctx.done[slot])
+            pthread_cond_wait(&ctx.slot_done, &ctx.lock);
+        pthread_mutex_unlock(&ctx.lock);
+
+        if (fwrite(ctx.buffer + slot * block_size, 1, block_size, out->file) != block_size) {
+            ret = -1;
+            err = errno;
+        }
+
+        pthread_mutex_lock(&ctx.lock);
+        ctx.done[slot] = false;
+        ctx.next_write++;
+        ctx.abort = ret != 0;
+        pthread_cond_broadcast(&ctx.slot_free);
+        pthread_mutex_unlock(&ctx.lock);
+    }
+
+    for (int t = 0; t < started; t++)
+        pthread_join(pool[t], NULL);
+
+    pthread_cond_destroy(&ctx.slot_done);
+    pthread_cond_destroy(&ctx.slot_free);
+    pthread_mutex_destroy(&ctx.lock);
+
+    free(pool);
+    free(ctx.done);
+    free(ctx.buffer);
+
+    if (ret)
+        errno = err;
+    return ret;
+}
@@ -0,0 +1,26 @@
+#ifndef H_PARALLEL
+#define H_PARALLEL
+
+/*
+ * Ordered block generation on a pool of worker threads.
+ *
+ * The output is split into blocks of block_size bytes. Block i is generated
+ * by fn from its own substream: the base state advanced by i urng_jump, e.g.
+ * i * 2^64 calls to xoroshiro128plus_next. The blocks are written to out in
+ * order, so the file only depends on base and the block count, not on the
+ * number of threads or the scheduling. If out is mapped, the blocks are
+ * generated in place and the order of completion does not matter at all.
+ *
+ * fn is called concurrently from several threads, arg must therefore only be
+ * read. fn may advance g freely, as long as one block consumes less than
+ * 2^64 numbers.
+ */
+typedef void (*parallel_block_fn)(void *arg, urng_t *g, void *block);
+
+/*
+ * Returns 0 on success, or -1 with errno set if writing to out failed.
+ */
+int parallel_generate(output_t *out, const urng_t *base, size_t blocks, size_t block_size,
+        int threads, parallel_block_fn fn, void *arg);
+
+#endif
@@ -0,0 +1,172 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <check.h>
+
+#include <xoroshiro128plus.h>
+#include <boxmuller.h>
+
+static boxmuller_t *bm;
+
+void setup(void) {
+    bm = boxmuller_new();
+}
+
+void teardown(void) {
+    boxmuller_free(bm);
+}
+
+// Double precision model, see verification/main/verify_trace.c
+static void gaussian_double(uint64_t u_0, uint32_t u_1, uint32_t u_2, double *out) {
+    double exp_e = (u_0 ? __builtin_clzll(u_0) - 16 : 48) + 1.0;
+    double e = 2 * (log(2.0) * exp_e - log(1.0 + u_2 * 4.656612873077393e-10));
+    double f = sqrt(e);
+
+    out[0] = sin(2 * M_PI * u_1 * 1.52587890625e-05) * f;
+    out[1] = cos(2 * M_PI * u_1 * 1.52587890625e-05) * f;
+}
+
+START_TEST(test_boxmuller_simulation_sample) {
+    // Taken from a behavioural simulation of boxmuller.vhd
+    int16_t x[2];
+    boxmuller_eval(bm, 0x000013c5e6ea2661, 0x3c2f, 0x3b5efd17, x);
+
+    ck_assert_int_eq(x[0], 4458); // 2.17676
+    ck_assert_int_eq(x[1], 418);  // 0.20410
+}
+END_TEST
+
+START_TEST(test_boxmuller_field_split) {
+    uint32_t u[3];
+    uint64_t u_0 = 0x8badbeefcafeUL;
+    uint32_t u_1 = 0xa5c3;
+    uint32_t u_2 = 0x5eadbeef;
+
+    // u = u_2 & u_1 & u_0 & '0'
+    uint64_t lo = (u_0 << 1) | ((uint64_t) u_1 << 49);
+    u[0] = (uint32_t) lo;
+    u[1] = (uint32_t)(lo >> 32);
+    u[2] = (u_2 << 1) | (u_1 >> 15);
+
+    ck_assert_uint_eq(BOXMULLER_U_0(u), u_0);
+    ck_assert_uint_eq(BOXMULLER_U_1(u), u_1);
+    ck_assert_uint_eq(BOXMULLER_U_2(u), u_2);
+}
+END_TEST
+
+START_TEST(test_boxmuller_accuracy) {
+    xoroshiro128plus_t xoro;
+    xoroshiro128plus_init(&xoro, 0xcafebabe8badbeef);
+
+    double ulp = 1.0 / (1 << 11);
+
+    for (size_t i = 0; i < (1 << 20); i++) {
+        uint64_t a = xoroshiro128plus_next(&xoro);
+        uint64_t b = xoroshiro128plus_next(&xoro);
+
+        // Also cover the rarely hit large exponents
+        uint64_t u_0 = (a & 0xFFFFFFFFFFFFUL) >> (b % 48);
+        uint32_t u_1 = a >> 48;
+        uint32_t u_2 = b >> 33;
+
+        int16_t x[2];
+        double y[2];
+        boxmuller_eval(bm, u_0, u_1, u_2, x);
+        gaussian_double(u_0, u_1, u_2, y);
+
+        ck_assert_double_eq_tol(x[0] * ulp, y[0], 2 * ulp);
+        ck_assert_double_eq_tol(x[1] * ulp, y[1], 2 * ulp);
+    }
+}
+END_TEST
+
+START_TEST(test_boxmuller_generate) {
+    xoroshiro128plus_t xoro;
+    xoroshiro128plus_init(&xoro, 0x0123456789abcdef);
+
+    uint32_t u[3 * 64];
+    for (size_t i = 0; i < sizeof(u) / sizeof(*u); i++)
+        u[i] = (uint32_t) xoroshiro128plus_next(&xoro);
+
+    int16_t x[2 * 64];
+    boxmuller_generate(bm, u, 64, x);
+
+    for (size_t i = 0; i < 64; i++) {
+        int16_t y[2];
+        boxmuller_eval(bm, BOXMULLER_U_0(&u[3 * i]), BOXMULLER_U_1(&u[3 * i]), BOXMULLER_U_2(&u[3 * i]), y);
+        ck_assert_int_eq(x[2 * i + 0], y[0]);
+        ck_assert_int_eq(x[2 * i + 1], y[1]);
+    }
+}
+END_TEST
+
+START_TEST(test_boxmuller_isa) {
+    xoroshiro128plus_t xoro;
+    xoroshiro128plus_init(&xoro, 0xfedcba9876543210);
+
+    // Odd length to cover the scalar remainder of the SIMD kernels
+    size_t n = 4096 + 13;
+    uint32_t *u = malloc(3 * n * sizeof(*u));
+    int16_t *x_ref = malloc(2 * n * sizeof(*x_ref));
+    int16_t *x = malloc(2 * n * sizeof(*x));
+
+    for (size_t i = 0; i < 3 * n; i++)
+        u[i] = (uint32_t) xoroshiro128plus_next(&xoro);
+
+    // Large exponents on both lzd halves
+    for (size_t i = 0; i < n; i += 7) {
+        u[3 * i + 1] &= 0xFFFF0000;
+        u[3 * i + 0] >>= i % 32;
+    }
+
+    ck_assert(boxmuller_set_isa(bm, BOXMULLER_ISA_SCALAR));
+    boxmuller_generate(bm, u, n, x_ref);
+
+    boxmuller_isa_t isas[] = { BOXMULLER_ISA_AVX2, BOXMULLER_ISA_AVX512 };
+    for (size_t j = 0; j < sizeof(isas) / sizeof(*isas); j++) {
+        if (!boxmuller_set_isa(bm, isas[j]))
+            continue;
+
+        boxmuller_generate(bm, u, n, x);
+        for (size_t i = 0; i < 2 * n; i++)
+            ck_assert_int_eq(x[i], x_ref[i]);
+    }
+
+    free(u);
+    free(x_ref);
+    free(x);
+}
+END_TEST
+
+Suite *make_boxmuller_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Boxmuller Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_boxmuller_simulation_sample);
+    tcase_add_test(tc_core, test_boxmuller_field_split);
+    tcase_add_test(tc_core, test_boxmuller_accuracy);
+    tcase_add_test(tc_core, test_boxmuller_generate);
+    tcase_add_test(tc_core, test_boxmuller_isa);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_boxmuller_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_boxmuller.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
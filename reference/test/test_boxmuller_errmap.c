@@ -0,0 +1,143 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <check.h>
+
+#include <boxmuller.h>
+#include <boxmuller_errmap.h>
+
+static boxmuller_t *bm;
+
+void setup(void) {
+    bm = boxmuller_new();
+}
+
+void teardown(void) {
+    boxmuller_free(bm);
+}
+
+static boxmuller_err_t *sweep(boxmuller_unit_t unit, uint64_t begin, uint64_t end) {
+    boxmuller_err_t *bins = calloc(BOXMULLER_UNITS[unit].bins, sizeof(boxmuller_err_t));
+    boxmuller_errmap_sweep(bm, unit, begin, end, bins);
+    return bins;
+}
+
+START_TEST(test_boxmuller_errmap_units) {
+    double y, y_ref;
+
+    // e = 4.0 -> f = 2.0, exact
+    ck_assert_double_eq(boxmuller_errmap_eval(bm, BOXMULLER_UNIT_F, 4 << 24, &y, &y_ref), 0.0);
+    ck_assert_double_eq(y, 2.0);
+
+    // x(19) selects sqrt(2 * (1 + x))
+    boxmuller_errmap_eval(bm, BOXMULLER_UNIT_SQRT, 0xC0000, &y, &y_ref);
+    ck_assert_double_eq_tol(y_ref, sqrt(3.0), 1e-15);
+    ck_assert_double_eq_tol(y, y_ref, ldexp(2, -16));
+
+    boxmuller_errmap_eval(bm, BOXMULLER_UNIT_COS, 0x8000, &y, &y_ref);
+    ck_assert_double_eq(y, -1.0);
+
+    boxmuller_errmap_eval(bm, BOXMULLER_UNIT_LN, 0x40000000, &y, &y_ref);
+    ck_assert_double_eq_tol(y, log(1.5), ldexp(2, -27));
+
+    // Bins are the ROM segments, and exp_f + 6 for f
+    ck_assert_uint_eq(boxmuller_errmap_bin(BOXMULLER_UNIT_LN, 0x7FFFFFFF), 255);
+    ck_assert_uint_eq(boxmuller_errmap_bin(BOXMULLER_UNIT_SQRT, 0xFFFFF), 127);
+    ck_assert_uint_eq(boxmuller_errmap_bin(BOXMULLER_UNIT_SIN, 0xFFFF), 511);
+    ck_assert_uint_eq(boxmuller_errmap_bin(BOXMULLER_UNIT_F, 1 << 24), 6);
+    ck_assert_uint_eq(boxmuller_errmap_bin(BOXMULLER_UNIT_F, 0x7FFFFFFF), 0);
+    ck_assert_uint_eq(boxmuller_errmap_bin(BOXMULLER_UNIT_F, 0), 31);
+}
+END_TEST
+
+START_TEST(test_boxmuller_errmap_trig) {
+    for (boxmuller_unit_t unit = BOXMULLER_UNIT_SIN; unit <= BOXMULLER_UNIT_COS; unit++) {
+        boxmuller_err_t *bins = sweep(unit, 0, 0x10000);
+
+        for (size_t i = 0; i < BOXMULLER_UNITS[unit].bins; i++) {
+            ck_assert_uint_eq(bins[i].n, 128);
+            ck_assert_uint_eq(boxmuller_errmap_bin(unit, bins[i].worst), i);
+
+            // The worst input reproduces the maximum
+            ck_assert_double_eq(fabs(boxmuller_errmap_eval(bm, unit, bins[i].worst, NULL, NULL)), bins[i].max_abs);
+            ck_assert_double_le(bins[i].max_abs, ldexp(3, -16));
+        }
+
+        free(bins);
+    }
+}
+END_TEST
+
+START_TEST(test_boxmuller_errmap_merge) {
+    // Sweeping in pieces, in any order, finds the same maxima
+    boxmuller_err_t *full = sweep(BOXMULLER_UNIT_SQRT, 0, 0x100000);
+    boxmuller_err_t *lo = sweep(BOXMULLER_UNIT_SQRT, 0, 0x7F123);
+    boxmuller_err_t *hi = sweep(BOXMULLER_UNIT_SQRT, 0x7F123, 0x100000);
+
+    for (size_t i = 0; i < BOXMULLER_UNITS[BOXMULLER_UNIT_SQRT].bins; i++) {
+        boxmuller_err_t acc = { 0 };
+        boxmuller_err_merge(&acc, &hi[i]);
+        boxmuller_err_merge(&acc, &lo[i]);
+
+        ck_assert_uint_eq(acc.n, full[i].n);
+        ck_assert_uint_eq(acc.worst, full[i].worst);
+        ck_assert_double_eq(acc.max_abs, full[i].max_abs);
+        ck_assert_double_eq_tol(acc.sum, full[i].sum, 1e-9);
+        ck_assert_double_eq_tol(acc.sum_abs, full[i].sum_abs, 1e-9);
+        ck_assert_double_le(full[i].max_abs, ldexp(2, -16));
+    }
+
+    free(full);
+    free(lo);
+    free(hi);
+}
+END_TEST
+
+START_TEST(test_boxmuller_errmap_ln) {
+    // First and last 2^16 inputs of the ln segments
+    boxmuller_err_t *bins = sweep(BOXMULLER_UNIT_LN, 0, 0x10000);
+    boxmuller_errmap_sweep(bm, BOXMULLER_UNIT_LN, 0x7FFF0000, 0x80000000, bins);
+
+    ck_assert_uint_eq(bins[0].n, 0x10000);
+    ck_assert_uint_eq(bins[255].n, 0x10000);
+    ck_assert_double_le(bins[0].max_abs, ldexp(2, -27));
+    ck_assert_double_le(bins[255].max_abs, ldexp(2, -27));
+
+    for (size_t i = 1; i < 255; i++)
+        ck_assert_uint_eq(bins[i].n, 0);
+
+    free(bins);
+}
+END_TEST
+
+Suite *make_boxmuller_errmap_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Boxmuller Error Map Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_boxmuller_errmap_units);
+    tcase_add_test(tc_core, test_boxmuller_errmap_trig);
+    tcase_add_test(tc_core, test_boxmuller_errmap_merge);
+    tcase_add_test(tc_core, test_boxmuller_errmap_ln);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_boxmuller_errmap_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_boxmuller_errmap.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,236 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <check.h>
+
+#include <xoroshiro128plus.h>
+#include <urng.h>
+#include <boxmuller.h>
+#include <boxmuller_tail.h>
+#include <sample_stats.h>
+
+static boxmuller_t *bm;
+
+void setup(void) {
+    bm = boxmuller_new();
+}
+
+void teardown(void) {
+    boxmuller_free(bm);
+}
+
+static int leading_zeros(uint64_t u_0) {
+    return u_0 ? __builtin_clzll(u_0) - 16 : 48;
+}
+
+// True if (u_0, u_1) lies in the tail region
+static bool in_region(const boxmuller_tail_t *tail, uint64_t u_0, uint32_t u_1) {
+    int lz = leading_zeros(u_0);
+
+    for (int i = 0; i < tail->n_strata; i++) {
+        const boxmuller_tail_stratum_t *s = &tail->strata[i];
+        if (s->lz != lz)
+            continue;
+
+        // u_1 is sorted
+        uint32_t lo = 0, hi = s->n_u_1;
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if (s->u_1[mid] < u_1)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo < s->n_u_1 && s->u_1[lo] == u_1;
+    }
+    return false;
+}
+
+START_TEST(test_boxmuller_tail_region) {
+    boxmuller_tail_t *tail = boxmuller_tail_new(bm, 7.0);
+    ck_assert_ptr_nonnull(tail);
+    ck_assert_int_eq(tail->threshold_code, 7 * 2048);
+
+    // Negative codes are mirrored onto the floor grid of the positive ones
+    ck_assert_int_eq(boxmuller_tail_mirror(-1), 0);
+    ck_assert_int_eq(boxmuller_tail_mirror(INT16_MIN), INT16_MAX);
+    ck_assert(boxmuller_tail_accept(tail, 7 * 2048));
+    ck_assert(!boxmuller_tail_accept(tail, 7 * 2048 - 1));
+    ck_assert(boxmuller_tail_accept(tail, -7 * 2048 - 1));
+    ck_assert(!boxmuller_tail_accept(tail, -7 * 2048));
+
+    // sqrt(2 ln(2) exp_e) > 7 needs exp_e >= 36, i.e. 35 leading zeros
+    ck_assert_int_eq(tail->strata[0].lz, 48);
+    ck_assert_int_eq(tail->strata[tail->n_strata - 1].lz, 35);
+
+    double weight = 0;
+    for (int i = 0; i < tail->n_strata; i++) {
+        const boxmuller_tail_stratum_t *s = &tail->strata[i];
+        ck_assert_int_eq(s->lz, 48 - i);
+        ck_assert_uint_gt(s->n_u_1, 0);
+        ck_assert_uint_lt(s->n_u_1, 0x10000);
+
+        // f shrinks with lz
+        if (i)
+            ck_assert_uint_le(s->n_u_1, s[-1].n_u_1);
+
+        for (uint32_t j = 1; j < s->n_u_1; j++)
+            ck_assert_uint_lt(s->u_1[j - 1], s->u_1[j]);
+
+        weight += ldexp(s->n_u_1, (s->lz == 48 ? 0 : 47 - s->lz) - 64);
+    }
+    ck_assert_double_eq(tail->weight, weight);
+
+    boxmuller_tail_free(tail);
+}
+END_TEST
+
+START_TEST(test_boxmuller_tail_draw) {
+    boxmuller_tail_t *tail = boxmuller_tail_new(bm, 7.0);
+    urng_t g;
+    urng_init(&g, URNG_XOROSHIRO128PLUS, 0x5eed5eed5eed5eed);
+
+    size_t n = 1 << 14;
+    uint32_t *u = malloc(3 * n * sizeof(*u));
+    int16_t *x = malloc(2 * n * sizeof(*x));
+
+    boxmuller_tail_draw(tail, &g, u, n);
+    boxmuller_generate(bm, u, n, x);
+
+    size_t hits = 0;
+    size_t lowest = 0;
+    for (size_t i = 0; i < n; i++) {
+        ck_assert(in_region(tail, BOXMULLER_U_0(&u[3 * i]), BOXMULLER_U_1(&u[3 * i])));
+        lowest += leading_zeros(BOXMULLER_U_0(&u[3 * i])) == 35;
+        hits += boxmuller_tail_accept(tail, x[2 * i]) + boxmuller_tail_accept(tail, x[2 * i + 1]);
+    }
+
+    // The lowest stratum holds about half of the region
+    ck_assert_uint_gt(lowest, n / 4);
+
+    // Most of the region is in the tail
+    ck_assert_uint_gt(hits, n / 4);
+
+    free(u);
+    free(x);
+    boxmuller_tail_free(tail);
+}
+END_TEST
+
+START_TEST(test_boxmuller_tail_complete) {
+    // No input outside of the region may reach the threshold
+    boxmuller_tail_t *tail = boxmuller_tail_new(bm, 7.0);
+    xoroshiro128plus_t xoro;
+    xoroshiro128plus_init(&xoro, 0xc0ffee0123456789);
+
+    for (size_t i = 0; i < (1 << 20); i++) {
+        uint64_t a = xoroshiro128plus_next(&xoro);
+        uint64_t b = xoroshiro128plus_next(&xoro);
+
+        // 30..47 leading zeros, around the lowest stratum
+        uint64_t u_0 = ((a & 0xFFFFFFFFFFFFUL) | 1) >> (30 + (b & 0xF) % 18);
+        uint32_t u_1 = a >> 48;
+        uint32_t u_2 = b >> 33;
+
+        if (in_region(tail, u_0, u_1))
+            continue;
+
+        int16_t y[2];
+        boxmuller_eval(bm, u_0, u_1, u_2, y);
+        ck_assert(!boxmuller_tail_accept(tail, y[0]));
+        ck_assert(!boxmuller_tail_accept(tail, y[1]));
+    }
+
+    boxmuller_tail_free(tail);
+}
+END_TEST
+
+START_TEST(test_boxmuller_tail_limits) {
+    // Every input can exceed 0
+    boxmuller_tail_t *tail = boxmuller_tail_new(bm, 0.0);
+    ck_assert_int_eq(tail->n_strata, 49);
+    ck_assert_uint_eq(tail->count, 0);
+    ck_assert_double_eq(tail->weight, 1.0);
+    for (int i = 0; i < tail->n_strata; i++)
+        ck_assert_uint_eq(tail->strata[i].n_u_1, 0x10000);
+    boxmuller_tail_free(tail);
+
+    // exp_e <= 49 limits |x| to sqrt(2 ln(2) 49) ~ 8.24
+    ck_assert_ptr_null(boxmuller_tail_new(bm, 8.5));
+    ck_assert_ptr_null(boxmuller_tail_new(bm, 100.0));
+}
+END_TEST
+
+START_TEST(test_boxmuller_tail_stats) {
+    // The samples of main -t THRESHOLD, mirrored like generate_tail_block,
+    // pass analyze -t THRESHOLD. 10^6 samples resolve a shift by one code.
+    static sample_hist_t hist;
+    const double thresholds[] = { 7.0, 6.8 };
+    const size_t n = 1000000;
+
+    for (int t = 0; t < 2; t++) {
+        boxmuller_tail_t *tail = boxmuller_tail_new(bm, thresholds[t]);
+        urng_t g;
+        urng_init(&g, URNG_XOROSHIRO128PLUS, 12345);
+        memset(&hist, 0, sizeof(hist));
+        hist.grid = SAMPLE_GRID_5_11;
+
+        uint32_t u[3 * 64];
+        int16_t x[2 * 64];
+        size_t samples = 0;
+        while (samples < n) {
+            boxmuller_tail_draw(tail, &g, u, 64);
+            boxmuller_generate(bm, u, 64, x);
+            for (int k = 0; k < 2 * 64 && samples < n; k++) {
+                if (boxmuller_tail_accept(tail, x[k])) {
+                    sample_hist_add(&hist, boxmuller_tail_mirror(x[k]));
+                    samples++;
+                }
+            }
+        }
+
+        sample_moments_t m = { 0 };
+        sample_report_t r;
+        sample_stats_evaluate(&hist, &m, 0, 1, thresholds[t], &r);
+        ck_assert_double_gt(r.ks_p, 1e-3);
+        ck_assert_double_gt(r.ad_p, 1e-3);
+        ck_assert_double_gt(r.chi2_p, 1e-3);
+
+        boxmuller_tail_free(tail);
+    }
+}
+END_TEST
+
+Suite *make_boxmuller_tail_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Boxmuller Tail Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_boxmuller_tail_region);
+    tcase_add_test(tc_core, test_boxmuller_tail_draw);
+    tcase_add_test(tc_core, test_boxmuller_tail_complete);
+    tcase_add_test(tc_core, test_boxmuller_tail_limits);
+    tcase_add_test(tc_core, test_boxmuller_tail_stats);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_boxmuller_tail_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_boxmuller_tail.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,184 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <check.h>
+
+#include <fxpnt.h>
+#include <fxpnt_piecewise_poly.h>
+#include <fxpnt_fixed.h>
+#include <xoroshiro128plus.h>
+
+FXPNT_FIXED(fx8_16, 8, 16)
+FXPNT_FIXED(fx16_8, 16, 8)
+FXPNT_FIXED(fx8_32, 8, 32)
+FXPNT_FIXED(fx5_11, 5, 11)
+
+FXPNT_FIXED_PP1(pp1_eval, fx8_32, 4)
+FXPNT_FIXED_PP2(pp2_eval, fx8_32, 4)
+
+#define SAMPLES 100000
+
+static xoroshiro128plus_t xoro;
+
+void setup(void) {
+    xoroshiro128plus_init(&xoro, 0xcafebabe8badbeef);
+}
+
+void teardown(void) {
+}
+
+// Random value in the range of the format, and sometimes just outside
+static fxpnt_t random_value(int n_i, int n_f) {
+    return (fxpnt_t) xoroshiro128plus_next(&xoro) >> (63 - n_i - n_f);
+}
+
+START_TEST(test_fxpnt_fixed_cfg) {
+    fxpnt_cfg_t *cfg = fxpnt_cfg(8, 16);
+    fxpnt_cfg_t fixed = fx8_16_cfg();
+
+    ck_assert_int_eq(fixed.n_i, cfg->n_i);
+    ck_assert_int_eq(fixed.n_f, cfg->n_f);
+    ck_assert_int_eq(fixed.max_v, cfg->max_v);
+    ck_assert_int_eq(fixed.min_v, cfg->min_v);
+    ck_assert_int_eq(fixed.mask, cfg->mask);
+    ck_assert_int_eq(fixed.mask_i, cfg->mask_i);
+    ck_assert_int_eq(fixed.mask_f, cfg->mask_f);
+
+    fxpnt_free(cfg);
+}
+END_TEST
+
+#define CHECK_FORMAT(NAME, N_I, N_F) do {                                               \
+    fxpnt_cfg_t *cfg = fxpnt_cfg(N_I, N_F);                                             \
+    for (int i = 0; i < SAMPLES; i++) {                                                 \
+        fxpnt_t a = random_value(N_I, N_F);                                             \
+        fxpnt_t b = random_value(N_I, N_F);                                             \
+        int64_t n = (int64_t) xoroshiro128plus_next(&xoro) >> 40;                       \
+                                                                                        \
+        ck_assert_int_eq(NAME##_mult(a, b), fxpnt_mult(cfg, a, b));                     \
+        ck_assert_int_eq(NAME##_saturate(a + b), fxpnt_saturate(cfg, a + b));           \
+        ck_assert_int_eq(NAME##_new(n, b), fxpnt_new(cfg, n, b));                       \
+        ck_assert_int_eq(NAME##_from_int((int) n), fxpnt_from_int(cfg, (int) n));       \
+        ck_assert(NAME##_to_double(a) == fxpnt_to_double(cfg, a));                      \
+        ck_assert_int_eq(NAME##_from_double(a * 1e-3), fxpnt_from_double(cfg, a * 1e-3)); \
+    }                                                                                   \
+    fxpnt_free(cfg);                                                                    \
+} while (0)
+
+START_TEST(test_fxpnt_fixed_arith) {
+    CHECK_FORMAT(fx8_16, 8, 16);
+    CHECK_FORMAT(fx16_8, 16, 8);
+    CHECK_FORMAT(fx8_32, 8, 32);
+    CHECK_FORMAT(fx5_11, 5, 11);
+}
+END_TEST
+
+START_TEST(test_fxpnt_fixed_convert) {
+    fxpnt_cfg_t *cfg_8_16 = fxpnt_cfg(8, 16);
+    fxpnt_cfg_t *cfg_16_8 = fxpnt_cfg(16, 8);
+    fxpnt_cfg_t *cfg_8_32 = fxpnt_cfg(8, 32);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        fxpnt_t a = random_value(8, 16);
+        fxpnt_t b = random_value(16, 8);
+        fxpnt_t c = random_value(8, 32);
+
+        ck_assert_int_eq(fx16_8_convert(a, 16), fxpnt_to_fxpnt(cfg_8_16, a, cfg_16_8));
+        ck_assert_int_eq(fx8_16_convert(b, 8), fxpnt_to_fxpnt(cfg_16_8, b, cfg_8_16));
+        ck_assert_int_eq(fx8_32_convert(a, 16), fxpnt_to_fxpnt(cfg_8_16, a, cfg_8_32));
+        ck_assert_int_eq(fx8_16_convert(c, 32), fxpnt_to_fxpnt(cfg_8_32, c, cfg_8_16));
+    }
+
+    fxpnt_free(cfg_8_16);
+    fxpnt_free(cfg_16_8);
+    fxpnt_free(cfg_8_32);
+}
+END_TEST
+
+START_TEST(test_fxpnt_fixed_pp_eval) {
+    // Tables built from the fixed cfg work with both evaluators
+    fxpnt_cfg_t cfg = fx8_32_cfg();
+    fxpnt_pp_t *pp = fxpnt_pp_new(&cfg, 4, 2);
+
+    for (size_t i = 0; i < pp->n * (pp->degree + 1); i++)
+        pp->table[i] = random_value(2, 32);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        fxpnt_t x = (fxpnt_t)(xoroshiro128plus_next(&xoro) >> 32);
+        ck_assert_int_eq(fx8_32_pp_eval(pp, x), fxpnt_pp_eval(pp, x));
+    }
+
+    fxpnt_pp_free(pp);
+}
+END_TEST
+
+START_TEST(test_fxpnt_fixed_horner) {
+    static FXPNT_PP_ALIGN fxpnt_pp1_seg_t table_1[16];
+    static FXPNT_PP_ALIGN fxpnt_pp2_seg_t table_2[16];
+    fxpnt_cfg_t cfg = fx8_32_cfg();
+    fxpnt_pp_t *pp = fxpnt_pp_new(&cfg, 4, 2);
+
+    ck_assert_int_eq((uintptr_t) table_2 % 64, 0);
+    ck_assert_int_eq(sizeof(fxpnt_pp2_seg_t), 32);
+
+    for (size_t i = 0; i < 16; i++) {
+        fxpnt_t *seg = fxpnt_pp_get_seg(pp, i);
+        seg[0] = table_1[i].c_0 = table_2[i].c_0 = random_value(2, 32);
+        seg[1] = table_1[i].c_1 = table_2[i].c_1 = random_value(2, 32);
+        seg[2] = table_2[i].c_2 = random_value(2, 32);
+    }
+
+    fxpnt_t x[256], y[256];
+    for (int i = 0; i < SAMPLES; i++) {
+        x[i % 256] = (fxpnt_t)(xoroshiro128plus_next(&xoro) >> 32);
+        fxpnt_t r = x[i % 256] & 0xFFFFFFF;
+        const fxpnt_t *seg = fxpnt_pp_get_seg(pp, (x[i % 256] >> 28) & 0xF);
+
+        fxpnt_t y_1 = fxpnt_saturate(&cfg, seg[0] + fxpnt_mult(&cfg, r, seg[1]));
+        fxpnt_t y_2 = fxpnt_saturate(&cfg, seg[0] + fxpnt_mult(&cfg, r, seg[1] + fxpnt_mult(&cfg, r, seg[2])));
+
+        ck_assert_int_eq(pp1_eval(table_1, x[i % 256]), y_1);
+        ck_assert_int_eq(pp2_eval(table_2, x[i % 256]), y_2);
+
+        // The power form only differs in the truncation of the products, |c_2| < 4
+        ck_assert(llabs(y_2 - fxpnt_pp_eval(pp, x[i % 256])) <= 8);
+    }
+
+    pp2_eval_batch(table_2, x, 256, y);
+    for (int i = 0; i < 256; i++)
+        ck_assert_int_eq(y[i], pp2_eval(table_2, x[i]));
+
+    fxpnt_pp_free(pp);
+}
+END_TEST
+
+Suite *make_fxpnt_fixed_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Fixed Point Compile-Time Format Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_fxpnt_fixed_cfg);
+    tcase_add_test(tc_core, test_fxpnt_fixed_arith);
+    tcase_add_test(tc_core, test_fxpnt_fixed_convert);
+    tcase_add_test(tc_core, test_fxpnt_fixed_pp_eval);
+    tcase_add_test(tc_core, test_fxpnt_fixed_horner);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_fxpnt_fixed_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_fxpnt_fixed.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
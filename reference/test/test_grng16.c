@@ -0,0 +1,216 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <check.h>
+
+#include <xoroshiro128plus.h>
+#include <xoro_seeds.h>
+#include <boxmuller.h>
+#include <output_remapper.h>
+#include <grng16.h>
+
+#define CYCLES 1000
+
+static boxmuller_t *bm;
+
+// xoroshiro outputs captured at enabled edge k after the reset, 3 words per boxmuller
+static uint32_t words[CYCLES + 1][GRNG16_XORO_COUNT * 2];
+
+void setup(void) {
+    bm = boxmuller_new();
+}
+
+void teardown(void) {
+    boxmuller_free(bm);
+}
+
+static void fill_words(unsigned seed_base) {
+    xoroshiro128plus_t xoro[GRNG16_XORO_COUNT];
+    for (int i = 0; i < GRNG16_XORO_COUNT; i++) {
+        xoro[i].s[0] = XORO_SEEDS[seed_base * GRNG16_XORO_COUNT + i][0];
+        xoro[i].s[1] = XORO_SEEDS[seed_base * GRNG16_XORO_COUNT + i][1];
+    }
+
+    for (int k = 0; k <= CYCLES; k++) {
+        uint64_t x[GRNG16_XORO_COUNT];
+        for (int i = 0; i < GRNG16_XORO_COUNT; i++)
+            x[i] = xoroshiro128plus_next(&xoro[i]);
+        memcpy(words[k], x, sizeof(x));
+    }
+}
+
+// Data word after enabled edge n > GRNG16_LATENCY, counting the first edge after the reset as 0
+static void expected(int n, const int16_t *factor, const int8_t *offset, int8_t *data) {
+    for (int b = 0; b < GRNG16_BM_COUNT; b++) {
+        int16_t x[2];
+        boxmuller_eval(bm, BOXMULLER_U_0(&words[n - GRNG16_DELAY_U_0][3 * b]),
+                BOXMULLER_U_1(&words[n - GRNG16_DELAY_U_1][3 * b]), BOXMULLER_U_2(&words[n - GRNG16_DELAY_U_2][3 * b]), x);
+        for (int j = 0; j < 2; j++)
+            data[2 * b + j] = output_remapper_eval(x[j], factor[n - GRNG16_DELAY_REMAP], offset[n - GRNG16_DELAY_REMAP]);
+    }
+}
+
+START_TEST(test_grng16_seed_base) {
+    grng16_t *g = grng16_new(XORO_SEEDS_LENGTH / GRNG16_XORO_COUNT - 1);
+    ck_assert_ptr_nonnull(g);
+    grng16_free(g);
+
+    ck_assert_ptr_null(grng16_new(XORO_SEEDS_LENGTH / GRNG16_XORO_COUNT));
+}
+END_TEST
+
+START_TEST(test_grng16_steady_state) {
+    static int16_t factor[CYCLES];
+    static int8_t offset[CYCLES];
+    xoroshiro128plus_t rng;
+    xoroshiro128plus_init(&rng, 0x5eed);
+
+    for (unsigned seed_base = 0; seed_base < 3; seed_base++) {
+        fill_words(seed_base);
+        grng16_t *g = grng16_new(seed_base);
+        grng16_reset(g);
+
+        for (int n = 0; n < CYCLES; n++) {
+            // Change the scaling every few cycles, to check its latency as well
+            uint64_t r = xoroshiro128plus_next(&rng);
+            factor[n] = n % 7 ? factor[n - 1] : (int16_t)(r & 0x3FF);
+            offset[n] = n % 7 ? offset[n - 1] : (int8_t)((r >> 16) % 33) - 16;
+
+            int8_t data[GRNG16_LANES], ref[GRNG16_LANES];
+            grng16_clock(g, true, true, factor[n], offset[n]);
+            grng16_data(g, data);
+            if (n < GRNG16_LATENCY)
+                continue;
+
+            expected(n, factor, offset, ref);
+            for (int i = 0; i < GRNG16_LANES; i++)
+                ck_assert_int_eq(data[i], ref[i]);
+        }
+
+        grng16_free(g);
+    }
+}
+END_TEST
+
+START_TEST(test_grng16_stall) {
+    static int16_t factor[CYCLES];
+    static int8_t offset[CYCLES];
+    xoroshiro128plus_t rng;
+    xoroshiro128plus_init(&rng, 0x57a11);
+
+    fill_words(1);
+    grng16_t *g = grng16_new(1);
+    grng16_reset(g);
+
+    int8_t last[GRNG16_LANES] = { 0 };
+    for (int n = 0; n < CYCLES;) {
+        uint64_t r = xoroshiro128plus_next(&rng);
+        bool en = r & 1;
+        factor[n] = (int16_t)(r >> 8);
+        offset[n] = (int8_t)(r >> 32);
+
+        // The ports are ignored, and the data held, while en = 0
+        int8_t data[GRNG16_LANES];
+        grng16_clock(g, true, en, factor[n], offset[n]);
+        grng16_data(g, data);
+        if (!en) {
+            ck_assert_mem_eq(data, last, sizeof(data));
+            continue;
+        }
+
+        if (n >= GRNG16_LATENCY) {
+            int8_t ref[GRNG16_LANES];
+            expected(n, factor, offset, ref);
+            ck_assert_mem_eq(data, ref, sizeof(data));
+        }
+        memcpy(last, data, sizeof(data));
+        n++;
+    }
+
+    ck_assert_uint_gt(g->cycle, CYCLES);
+    grng16_free(g);
+}
+END_TEST
+
+START_TEST(test_grng16_reset) {
+    // After GRNG16_LATENCY cycles, a reset in the middle of a run is the same as one after power-up
+    grng16_t *a = grng16_new(2);
+    grng16_t *b = grng16_new(2);
+    int8_t data_a[GRNG16_LANES], data_b[GRNG16_LANES];
+
+    grng16_reset(a);
+    for (int n = 0; n < 100; n++)
+        grng16_clock(a, true, true, 256, 8);
+
+    // Reset with en = 1 for a few cycles, the pipelines keep clocking
+    for (int n = 0; n < 3; n++) {
+        grng16_clock(a, false, true, 256, 8);
+        grng16_clock(b, false, true, 256, 8);
+    }
+
+    for (int n = 0; n < 2 * GRNG16_LATENCY; n++) {
+        grng16_clock(a, true, true, 256, 8);
+        grng16_clock(b, true, true, 256, 8);
+        grng16_data(a, data_a);
+        grng16_data(b, data_b);
+
+        if (n >= GRNG16_LATENCY)
+            ck_assert_mem_eq(data_a, data_b, sizeof(data_a));
+    }
+
+    grng16_free(a);
+    grng16_free(b);
+}
+END_TEST
+
+START_TEST(test_grng16_run) {
+    grng16_t *a = grng16_new(0);
+    grng16_t *b = grng16_new(0);
+    int8_t data[100][GRNG16_LANES], ref[GRNG16_LANES];
+
+    grng16_reset(a);
+    grng16_reset(b);
+    grng16_run(a, 100, 128, -4, &data[0][0]);
+    for (int n = 0; n < 100; n++) {
+        grng16_clock(b, true, true, 128, -4);
+        grng16_data(b, ref);
+        ck_assert_mem_eq(data[n], ref, sizeof(ref));
+    }
+
+    grng16_free(a);
+    grng16_free(b);
+}
+END_TEST
+
+Suite *make_grng16_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("grng_16 Model Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_grng16_seed_base);
+    tcase_add_test(tc_core, test_grng16_steady_state);
+    tcase_add_test(tc_core, test_grng16_stall);
+    tcase_add_test(tc_core, test_grng16_reset);
+    tcase_add_test(tc_core, test_grng16_run);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_grng16_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_grng16.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
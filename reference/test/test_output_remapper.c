@@ -0,0 +1,149 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <check.h>
+
+#include <output_remapper.h>
+
+void setup(void) {
+}
+
+void teardown(void) {
+}
+
+START_TEST(test_output_remapper_identity) {
+    // factor = 1.0 (8,8), offset = 0: (5,11) -> (6,2)
+    ck_assert_int_eq(output_remapper_eval(0, 256, 0), 0);
+    ck_assert_int_eq(output_remapper_eval(2048, 256, 0), 4);
+    ck_assert_int_eq(output_remapper_eval(-2048, 256, 0), -4);
+    ck_assert_int_eq(output_remapper_eval(2048 * 7 + 1024, 256, 0), 30);
+}
+END_TEST
+
+START_TEST(test_output_remapper_rounding) {
+    // 0.125 -> 0.25, -0.125 -> 0, ties round up
+    ck_assert_int_eq(output_remapper_eval(256, 256, 0), 1);
+    ck_assert_int_eq(output_remapper_eval(-256, 256, 0), 0);
+    ck_assert_int_eq(output_remapper_eval(255, 256, 0), 0);
+    ck_assert_int_eq(output_remapper_eval(-257, 256, 0), -1);
+}
+END_TEST
+
+START_TEST(test_output_remapper_clamp) {
+    ck_assert_int_eq(output_remapper_eval(2048 * 8, 256, 0), 31);
+    ck_assert_int_eq(output_remapper_eval(-2048 * 8, 256, 0), -31);
+    ck_assert_int_eq(output_remapper_eval(INT16_MAX, INT16_MAX, 127), 31);
+    ck_assert_int_eq(output_remapper_eval(INT16_MIN, INT16_MAX, -128), -31);
+    ck_assert_int_eq(output_remapper_eval(INT16_MIN, INT16_MIN, 0), 31);
+}
+END_TEST
+
+START_TEST(test_output_remapper_scale) {
+    // mu = 2.0, sigma = 1.0 as in testbench.vhd
+    ck_assert_int_eq(output_remapper_eval(0, 256, 8), 8);
+    ck_assert_int_eq(output_remapper_eval(-2048, 256, 8), 4);
+
+    // sigma = 0.5
+    ck_assert_int_eq(output_remapper_eval(2048, 128, 0), 2);
+    ck_assert_int_eq(output_remapper_eval(-2048 * 3, 128, -4), -10);
+
+    int16_t din[] = { 0, 2048, -2048, 30000 };
+    int8_t dout[4];
+    output_remapper_generate(din, 4, 256, 8, dout);
+    ck_assert_int_eq(dout[0], 8);
+    ck_assert_int_eq(dout[1], 12);
+    ck_assert_int_eq(dout[2], 4);
+    ck_assert_int_eq(dout[3], 31);
+}
+END_TEST
+
+START_TEST(test_output_remapper_fixpt) {
+    // +-7.5 instead of +-7.75
+    ck_assert_int_eq(output_remapper_fixpt_eval(2048 * 7 + 1024, 256, 0), 30);
+    ck_assert_int_eq(output_remapper_fixpt_eval(2048 * 8, 256, 0), 30);
+    ck_assert_int_eq(output_remapper_fixpt_eval(-2048 * 8, 256, 0), -30);
+    ck_assert_int_eq(output_remapper_fixpt_eval(INT16_MIN, UINT16_MAX, -128), -30);
+
+    // factor >= 128.0 is positive, unlike in output_remapper.vhd
+    ck_assert_int_eq(output_remapper_fixpt_eval(2048, 0x8000, 0), 30);
+    ck_assert_int_eq(output_remapper_eval(2048, INT16_MIN, 0), -31);
+    ck_assert_int_eq(output_remapper_fixpt_eval(1, 0x8000, 0), 0);
+    ck_assert_int_eq(output_remapper_fixpt_eval(2, 0x8000, 0), 1);
+
+    // Otherwise both agree
+    const uint16_t factors[] = { 0, 1, 128, 256, 300, 4096, INT16_MAX };
+    const int8_t offsets[] = { -128, -9, 0, 1, 8, 127 };
+    for (size_t f = 0; f < sizeof(factors) / sizeof(factors[0]); f++) {
+        for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+            for (int32_t din = INT16_MIN; din <= INT16_MAX; din++) {
+                int8_t y = output_remapper_eval(din, factors[f], offsets[o]);
+                y = y > 30 ? 30 : y < -30 ? -30 : y;
+                ck_assert_int_eq(output_remapper_fixpt_eval(din, factors[f], offsets[o]), y);
+            }
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_output_remapper_isa) {
+    // Every din, plus a remainder that does not fill a vector
+    static int16_t din[65536 + 37];
+    static int8_t dout[65536 + 37];
+    static float x[65536 + 37];
+    const int16_t factors[] = { 256, 128, 1, -1, INT16_MAX, INT16_MIN, 0x1234 };
+    const int8_t offsets[] = { 0, 8, -4, 127, -128 };
+
+    for (size_t i = 0; i < 65536 + 37; i++)
+        din[i] = (int16_t)(i * 40503);
+
+    for (int isa = OUTPUT_REMAPPER_ISA_SCALAR; isa <= OUTPUT_REMAPPER_ISA_AVX512; isa++) {
+        if (!output_remapper_set_isa(isa))
+            continue;
+
+        for (size_t f = 0; f < sizeof(factors) / sizeof(factors[0]); f++) {
+            for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+                output_remapper_generate(din, 65536 + 37, factors[f], offsets[o], dout);
+                for (size_t i = 0; i < 65536 + 37; i++)
+                    ck_assert_int_eq(dout[i], output_remapper_eval(din[i], factors[f], offsets[o]));
+            }
+        }
+
+        output_remapper_unpack(dout, 65536 + 37, x);
+        for (size_t i = 0; i < 65536 + 37; i++)
+            ck_assert_double_eq(x[i], dout[i] / 4.0);
+    }
+}
+END_TEST
+
+Suite *make_output_remapper_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Output Remapper Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_output_remapper_identity);
+    tcase_add_test(tc_core, test_output_remapper_rounding);
+    tcase_add_test(tc_core, test_output_remapper_clamp);
+    tcase_add_test(tc_core, test_output_remapper_scale);
+    tcase_add_test(tc_core, test_output_remapper_fixpt);
+    tcase_add_test(tc_core, test_output_remapper_isa);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_output_remapper_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_output_remapper.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,210 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <check.h>
+
+#include <xoroshiro128plus.h>
+#include <sample_stats.h>
+
+static sample_hist_t hist;
+
+void setup(void) {
+    memset(&hist, 0, sizeof(hist));
+}
+
+void teardown(void) {
+}
+
+static double cdf(double x) {
+    return 0.5 * erfc(-x * M_SQRT1_2);
+}
+
+// Histogram with the rounded expectation of every code, for n samples
+static void ideal_hist(sample_grid_t grid, double n, double mu, double tail) {
+    hist.grid = grid;
+    int32_t lo = grid == SAMPLE_GRID_5_11 ? INT16_MIN : -31;
+    int32_t hi = grid == SAMPLE_GRID_5_11 ? INT16_MAX : 31;
+
+    for (int32_t c = lo; c <= hi; c++) {
+        double a = grid == SAMPLE_GRID_5_11 ? ldexp(c, -11) : ldexp(c - 0.5, -2);
+        double b = grid == SAMPLE_GRID_5_11 ? ldexp(c + 1, -11) : ldexp(c + 0.5, -2);
+        a = c == lo ? -INFINITY : a - mu;
+        b = c == hi ? INFINITY : b - mu;
+
+        double p;
+        if (isnan(tail))
+            p = cdf(b) - cdf(a);
+        else
+            p = b <= tail ? 0 : (cdf(-fmax(a, tail)) - cdf(-b)) / cdf(-tail);
+
+        hist.count[c - INT16_MIN] = llround(n * p);
+    }
+}
+
+START_TEST(test_sample_stats_grid) {
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_5_11, 0.0), 0);
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_5_11, -1e-9), -1);
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_5_11, 1.0), 2048);
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_5_11, 100.0), INT16_MAX);
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_5_11, -100.0), INT16_MIN);
+
+    // Ties round up, like output_remapper
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_6_2, 0.125), 1);
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_6_2, -0.125), 0);
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_6_2, 9.0), 31);
+    ck_assert_int_eq(sample_grid_code(SAMPLE_GRID_6_2, -9.0), -31);
+}
+END_TEST
+
+START_TEST(test_sample_stats_moments) {
+    xoroshiro128plus_t xoro;
+    xoroshiro128plus_init(&xoro, 0x0123456789abcdef);
+
+    size_t n = 10000;
+    double x[10000];
+    double sum = 0, lag = 0;
+    for (size_t i = 0; i < n; i++) {
+        // Skewed, with a large offset
+        double u = (xoroshiro128plus_next(&xoro) >> 11) * 0x1p-53;
+        x[i] = 1000 + u * u * u;
+        sum += x[i];
+        if (i)
+            lag += x[i - 1] * x[i];
+    }
+
+    double mean = sum / n, m2 = 0, m3 = 0, m4 = 0;
+    for (size_t i = 0; i < n; i++) {
+        double d = x[i] - mean;
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+    }
+
+    // Uneven pieces, merged in order
+    sample_moments_t a = { 0 }, b = { 0 }, whole = { 0 };
+    sample_moments_add(&a, x, 17);
+    sample_moments_add(&a, x + 17, 4000);
+    sample_moments_add(&b, x + 4017, n - 4017);
+    sample_moments_merge(&a, &b);
+    sample_moments_add(&whole, x, n);
+
+    const sample_moments_t *ms[] = { &a, &whole };
+    for (int i = 0; i < 2; i++) {
+        const sample_moments_t *m = ms[i];
+        ck_assert_uint_eq(m->n, n);
+        ck_assert_double_eq_tol(m->mean, mean, 1e-9);
+        ck_assert_double_eq_tol(m->m2, m2, 1e-9 * m2);
+        ck_assert_double_eq_tol(m->m3, m3, 1e-6 * fabs(m3));
+        ck_assert_double_eq_tol(m->m4, m4, 1e-6 * m4);
+        ck_assert_double_eq_tol(m->lag, lag, 1e-12 * lag);
+        ck_assert_double_eq(m->first, x[0]);
+        ck_assert_double_eq(m->last, x[n - 1]);
+    }
+}
+END_TEST
+
+START_TEST(test_sample_stats_serial) {
+    double x[1000];
+    for (size_t i = 0; i < 1000; i++)
+        x[i] = (i & 1) ? 1 : -1;
+
+    sample_moments_t m = { 0 };
+    sample_moments_add(&m, x, 1000);
+
+    sample_report_t r;
+    hist.grid = SAMPLE_GRID_6_2;
+    sample_stats_evaluate(&hist, &m, 0, 1, NAN, &r);
+
+    ck_assert_double_eq_tol(r.serial_r, -1, 1e-2);
+    ck_assert_double_eq_tol(r.mean, 0, 1e-12);
+    ck_assert_double_eq_tol(r.variance, 1000.0 / 999, 1e-12);
+}
+END_TEST
+
+START_TEST(test_sample_stats_fit) {
+    sample_moments_t m = { 0 };
+    sample_report_t r;
+
+    // The expectation itself fits perfectly
+    ideal_hist(SAMPLE_GRID_6_2, 1e8, 0, NAN);
+    sample_stats_evaluate(&hist, &m, 0, 1, NAN, &r);
+    ck_assert_double_gt(r.chi2_p, 0.99);
+    ck_assert_double_gt(r.ks_p, 0.99);
+    ck_assert_double_gt(r.ad_p, 0.99);
+    ck_assert_double_lt(r.ks_d, 1e-7);
+
+    ideal_hist(SAMPLE_GRID_5_11, 1e9, 0, NAN);
+    sample_stats_evaluate(&hist, &m, 0, 1, NAN, &r);
+    ck_assert_double_gt(r.chi2_p, 0.99);
+    ck_assert_double_gt(r.ks_p, 0.99);
+    ck_assert_double_gt(r.ad_p, 0.99);
+    ck_assert_uint_gt(r.chi2_dof, 10000);
+
+    // A shift of 0.01 sigma is obvious at 10^8 samples
+    ideal_hist(SAMPLE_GRID_6_2, 1e8, 0.01, NAN);
+    sample_stats_evaluate(&hist, &m, 0, 1, NAN, &r);
+    ck_assert_double_lt(r.chi2_p, 1e-6);
+    ck_assert_double_lt(r.ks_p, 1e-6);
+    ck_assert_double_lt(r.ad_p, 1e-6);
+
+    // Tail
+    ideal_hist(SAMPLE_GRID_5_11, 1e7, 0, 7.0);
+    sample_stats_evaluate(&hist, &m, 0, 1, 7.0, &r);
+    ck_assert_double_gt(r.chi2_p, 0.99);
+    ck_assert_double_gt(r.ks_p, 0.99);
+    ck_assert_double_gt(r.ad_p, 0.99);
+
+    sample_stats_evaluate(&hist, &m, 0, 1, 6.99, &r);
+    ck_assert_double_lt(r.ks_p, 1e-6);
+}
+END_TEST
+
+START_TEST(test_sample_stats_merge) {
+    static sample_hist_t other;
+    hist.grid = other.grid = SAMPLE_GRID_5_11;
+
+    sample_hist_add(&hist, -5);
+    sample_hist_add(&hist, 7);
+    sample_hist_add(&other, 7);
+    sample_hist_add(&other, INT16_MIN);
+    sample_hist_merge(&hist, &other);
+
+    ck_assert_uint_eq(hist.count[-5 - INT16_MIN], 1);
+    ck_assert_uint_eq(hist.count[7 - INT16_MIN], 2);
+    ck_assert_uint_eq(hist.count[0], 1);
+}
+END_TEST
+
+Suite *make_sample_stats_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Sample Statistics Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_sample_stats_grid);
+    tcase_add_test(tc_core, test_sample_stats_moments);
+    tcase_add_test(tc_core, test_sample_stats_serial);
+    tcase_add_test(tc_core, test_sample_stats_fit);
+    tcase_add_test(tc_core, test_sample_stats_merge);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_sample_stats_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_sample_stats.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
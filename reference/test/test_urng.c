@@ -0,0 +1,167 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <check.h>
+
+#include <xoroshiro128plus.h>
+#include <urng.h>
+
+void setup(void) {
+}
+
+void teardown(void) {
+}
+
+START_TEST(test_urng_xoroshiro128plus) {
+    // Bit-identical to xoroshiro128plus, including jumps and advance
+    xoroshiro128plus_t xoro;
+    urng_t g;
+    xoroshiro128plus_init(&xoro, 0xcafebabe8badbeef);
+    urng_init(&g, URNG_XOROSHIRO128PLUS, 0xcafebabe8badbeef);
+
+    for (int i = 0; i < 1000; i++)
+        ck_assert_uint_eq(urng_next(&g), xoroshiro128plus_next(&xoro));
+
+    xoroshiro128plus_jump(&xoro);
+    urng_jump(&g);
+    uint64_t out[37];
+    urng_fill(&g, out, 37);
+    for (int i = 0; i < 37; i++)
+        ck_assert_uint_eq(out[i], xoroshiro128plus_next(&xoro));
+
+    xoroshiro128plus_init(&xoro, 0xcafebabe8badbeef);
+    xoroshiro128plus_advance(&xoro, 3, 12345);
+    ck_assert(urng_seek(&g, 3, 12345));
+    ck_assert_uint_eq(urng_next(&g), xoroshiro128plus_next(&xoro));
+}
+END_TEST
+
+START_TEST(test_urng_xoshiro256pp) {
+    // Reference outputs for the state { 1, 2, 3, 4 }
+    urng_t g;
+    urng_init(&g, URNG_XOSHIRO256PP, 0);
+    g.s[0] = 1;
+    g.s[1] = 2;
+    g.s[2] = 3;
+    g.s[3] = 4;
+
+    ck_assert_uint_eq(urng_next(&g), 41943041);
+    ck_assert_uint_eq(urng_next(&g), 58720359);
+    ck_assert_uint_eq(urng_next(&g), UINT64_C(3588806011781223));
+    ck_assert_uint_eq(urng_next(&g), UINT64_C(3591011842654386));
+    ck_assert_uint_eq(urng_next(&g), UINT64_C(9228616714210784205));
+
+    ck_assert(!urng_seek(&g, 1, 0));
+}
+END_TEST
+
+START_TEST(test_urng_kat) {
+    // Known-answer vectors of Random123
+    const uint64_t zero[2] = { 0, 0 };
+    const uint64_t ones[2] = { UINT64_MAX, UINT64_MAX };
+    uint64_t out[2];
+
+    urng_philox4x32(zero, zero, out);
+    ck_assert_uint_eq(out[0], UINT64_C(0xe169c58d6627e8d5));
+    ck_assert_uint_eq(out[1], UINT64_C(0x9b00dbd8bc57ac4c));
+    urng_philox4x32(ones, ones, out);
+    ck_assert_uint_eq(out[0], UINT64_C(0x41c83b0e408f276d));
+    ck_assert_uint_eq(out[1], UINT64_C(0x6d5451fda20bc7c6));
+
+    const uint64_t pi_ctr[2] = { UINT64_C(0x85a308d3243f6a88), UINT64_C(0x0370734413198a2e) };
+    const uint64_t pi_key[2] = { UINT64_C(0x299f31d0a4093822), 0 };
+    urng_philox4x32(pi_ctr, pi_key, out);
+    ck_assert_uint_eq(out[0], UINT64_C(0x94fdccebd16cfe09));
+    ck_assert_uint_eq(out[1], UINT64_C(0x24126ea15001e420));
+
+    urng_threefry2x64(zero, zero, out);
+    ck_assert_uint_eq(out[0], UINT64_C(0xc2b6e3a8c2c69865));
+    ck_assert_uint_eq(out[1], UINT64_C(0x6f81ed42f350084d));
+}
+END_TEST
+
+START_TEST(test_urng_counter) {
+    // next, fill, jump and seek agree for the counter-based sources
+    for (urng_kind_t kind = URNG_PHILOX4X32; kind <= URNG_THREEFRY2X64; kind++) {
+        urng_t g, h;
+        uint64_t seq[300], out[300];
+
+        urng_init(&g, kind, 0x5eed);
+        for (int i = 0; i < 300; i++)
+            seq[i] = urng_next(&g);
+
+        // Fills of odd lengths from odd positions
+        urng_init(&h, kind, 0x5eed);
+        urng_fill(&h, out, 1);
+        urng_fill(&h, out + 1, 100);
+        urng_fill(&h, out + 101, 3);
+        urng_fill(&h, out + 104, 196);
+        for (int i = 0; i < 300; i++)
+            ck_assert_uint_eq(out[i], seq[i]);
+
+        for (int i = 0; i < 300; i += 7) {
+            ck_assert(urng_seek(&h, 0, i));
+            ck_assert_uint_eq(urng_next(&h), seq[i]);
+        }
+
+        // Jumps keep the position, substreams differ
+        urng_seek(&g, 0, 5);
+        urng_jump(&g);
+        urng_jump(&g);
+        urng_seek(&h, 2, 5);
+        uint64_t x = urng_next(&g);
+        ck_assert_uint_eq(x, urng_next(&h));
+        ck_assert_uint_ne(x, seq[5]);
+
+        // Output 2^64 - 1 of a substream
+        urng_seek(&g, 7, UINT64_MAX - 1);
+        urng_next(&g);
+        urng_seek(&h, 7, UINT64_MAX);
+        ck_assert_uint_eq(urng_next(&g), urng_next(&h));
+    }
+}
+END_TEST
+
+START_TEST(test_urng_parse) {
+    for (urng_kind_t kind = 0; kind < URNG_KIND_COUNT; kind++) {
+        urng_kind_t parsed;
+        ck_assert(urng_parse(urng_name(kind), &parsed));
+        ck_assert_int_eq(parsed, kind);
+    }
+
+    urng_kind_t parsed;
+    ck_assert(!urng_parse("mt19937", &parsed));
+}
+END_TEST
+
+Suite *make_urng_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("URNG Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_urng_xoroshiro128plus);
+    tcase_add_test(tc_core, test_urng_xoshiro256pp);
+    tcase_add_test(tc_core, test_urng_kat);
+    tcase_add_test(tc_core, test_urng_counter);
+    tcase_add_test(tc_core, test_urng_parse);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_urng_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_urng.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,113 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <check.h>
+
+#include <xoroshiro128plus.h>
+#include <boxmuller.h>
+#include <grng16.h>
+#include <xoro_lanes.h>
+
+#define STEPS 100
+
+void setup(void) {
+}
+
+void teardown(void) {
+}
+
+START_TEST(test_xoro_lanes_invalid) {
+    xoro_lanes_t x;
+    ck_assert(!xoro_lanes_seed(&x, 0, 1));
+    ck_assert(!xoro_lanes_seed(&x, 6, 1));
+    ck_assert(!xoro_lanes_seed(&x, XORO_LANES_MAX + 4, 1));
+    ck_assert(xoro_lanes_seed(&x, XORO_LANES_MAX, 1));
+    ck_assert(!xoro_lanes_grng16(&x, 1000));
+}
+END_TEST
+
+START_TEST(test_xoro_lanes_isa) {
+    // Every lane is xoroshiro128plus_next of its own state, for every kernel
+    // and every shape of the vector loops
+    static const size_t lane_counts[] = { 4, 8, 12, 16, 20, 28, XORO_LANES_MAX };
+    static uint64_t out[XORO_LANES_MAX * STEPS];
+
+    for (int isa = XORO_LANES_ISA_SCALAR; isa <= XORO_LANES_ISA_AVX512; isa++) {
+        if (!xoro_lanes_set_isa(isa))
+            continue;
+
+        for (size_t c = 0; c < sizeof(lane_counts) / sizeof(lane_counts[0]); c++) {
+            size_t lanes = lane_counts[c];
+            xoro_lanes_t x;
+            ck_assert(xoro_lanes_seed(&x, lanes, 0xdeadbeef));
+
+            // Two calls, so that the state is carried over
+            xoro_lanes_fill(&x, 1, out);
+            xoro_lanes_fill(&x, STEPS - 1, out + lanes);
+
+            xoroshiro128plus_t xoro, lane;
+            xoroshiro128plus_init(&xoro, 0xdeadbeef);
+            for (size_t i = 0; i < lanes; i++) {
+                xoroshiro128plus_t ref = xoro;
+                for (size_t t = 0; t < STEPS; t++)
+                    ck_assert_uint_eq(out[lanes * t + i], xoroshiro128plus_next(&ref));
+
+                xoro_lanes_get(&x, i, &lane);
+                ck_assert_uint_eq(lane.s[0], ref.s[0]);
+                ck_assert_uint_eq(lane.s[1], ref.s[1]);
+                xoroshiro128plus_jump(&xoro);
+            }
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_xoro_lanes_grng16) {
+    // w_xoro_data of the grng_16 model, cycle by cycle
+    static uint64_t out[GRNG16_XORO_COUNT * STEPS];
+    int8_t data[GRNG16_LANES];
+
+    xoro_lanes_t x;
+    ck_assert(xoro_lanes_grng16(&x, 1));
+    xoro_lanes_fill(&x, STEPS, out);
+
+    grng16_t *g = grng16_new(1);
+    grng16_reset(g);
+    for (size_t t = 0; t < STEPS; t++) {
+        for (int i = 0; i < GRNG16_XORO_COUNT; i++)
+            ck_assert_uint_eq(out[GRNG16_XORO_COUNT * t + i], g->xoro[i].s[0] + g->xoro[i].s[1]);
+        grng16_run(g, 1, 256, 0, data);
+    }
+    grng16_free(g);
+}
+END_TEST
+
+Suite *make_xoro_lanes_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Xoroshiro Lanes Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_xoro_lanes_invalid);
+    tcase_add_test(tc_core, test_xoro_lanes_isa);
+    tcase_add_test(tc_core, test_xoro_lanes_grng16);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_xoro_lanes_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_xoro_lanes.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
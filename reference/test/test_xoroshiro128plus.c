@@ -3,6 +3,7 @@
 #include <check.h>
 
 #include <xoroshiro128plus.h>
+#include <xoro_seeds.h>
 
 xoroshiro128plus_t xoro_state;
 
@@ -43,6 +44,115 @@ START_TEST(test_xoroshiro128plus) {
         ck_assert_int_eq(xoroshiro128plus_next(&xoro_state), values[i]);
 }
 
+static void seed_state(void) {
+    xoro_state.x = 0xcafebabe8badbeef;
+
+    xoro_state.s[0] = splitmix64_next(&xoro_state);
+    xoro_state.s[1] = splitmix64_next(&xoro_state);
+}
+
+START_TEST(test_jump_short) {
+    // Short distances can be checked against stepping
+    for (uint64_t n = 0; n < 300; n += 7) {
+        seed_state();
+        xoroshiro128plus_t ref = xoro_state;
+
+        xoroshiro128plus_advance(&xoro_state, 0, n);
+        for (uint64_t i = 0; i < n; i++)
+            xoroshiro128plus_next(&ref);
+
+        ck_assert_int_eq(xoro_state.s[0], ref.s[0]);
+        ck_assert_int_eq(xoro_state.s[1], ref.s[1]);
+    }
+
+    for (unsigned k = 0; k < 8; k++) {
+        seed_state();
+        xoroshiro128plus_t ref = xoro_state;
+
+        ck_assert_int_eq(xoroshiro128plus_jump_pow2(&xoro_state, k), 0);
+        for (uint64_t i = 0; i < (1U << k); i++)
+            xoroshiro128plus_next(&ref);
+
+        ck_assert_int_eq(xoro_state.s[0], ref.s[0]);
+        ck_assert_int_eq(xoro_state.s[1], ref.s[1]);
+    }
+
+    // Out of range, the state is kept
+    seed_state();
+    xoroshiro128plus_t ref = xoro_state;
+    ck_assert_int_eq(xoroshiro128plus_jump_pow2(&xoro_state, 128), -1);
+    ck_assert_int_eq(xoro_state.s[0], ref.s[0]);
+    ck_assert_int_eq(xoro_state.s[1], ref.s[1]);
+}
+END_TEST
+
+START_TEST(test_jump_long) {
+    seed_state();
+    xoroshiro128plus_t ref = xoro_state;
+
+    // 5 * 2^64 + 3
+    xoroshiro128plus_advance(&xoro_state, 5, 3);
+    for (int i = 0; i < 5; i++)
+        xoroshiro128plus_jump(&ref);
+    for (int i = 0; i < 3; i++)
+        xoroshiro128plus_next(&ref);
+
+    ck_assert_int_eq(xoro_state.s[0], ref.s[0]);
+    ck_assert_int_eq(xoro_state.s[1], ref.s[1]);
+
+    // 2^96
+    seed_state();
+    ref = xoro_state;
+    xoroshiro128plus_long_jump(&ref);
+    xoroshiro128plus_advance(&xoro_state, UINT64_C(1) << 32, 0);
+
+    ck_assert_int_eq(xoro_state.s[0], ref.s[0]);
+    ck_assert_int_eq(xoro_state.s[1], ref.s[1]);
+
+    seed_state();
+    xoroshiro128plus_jump_pow2(&xoro_state, 96);
+
+    ck_assert_int_eq(xoro_state.s[0], ref.s[0]);
+    ck_assert_int_eq(xoro_state.s[1], ref.s[1]);
+
+    // a + b, with a carry out of the low word
+    seed_state();
+    ref = xoro_state;
+    xoroshiro128plus_advance(&xoro_state, 0x0123456789abcdef, 0xfedcba9876543210);
+    xoroshiro128plus_advance(&xoro_state, 0x1111111111111111, 0x2222222222222222);
+    xoroshiro128plus_advance(&ref, 0x123456789abcdef + 0x1111111111111111 + 1, 0xfedcba9876543210 + 0x2222222222222222);
+
+    ck_assert_int_eq(xoro_state.s[0], ref.s[0]);
+    ck_assert_int_eq(xoro_state.s[1], ref.s[1]);
+
+    // The period is 2^128 - 1
+    seed_state();
+    ref = xoro_state;
+    xoroshiro128plus_advance(&xoro_state, UINT64_MAX, UINT64_MAX);
+
+    ck_assert_int_eq(xoro_state.s[0], ref.s[0]);
+    ck_assert_int_eq(xoro_state.s[1], ref.s[1]);
+}
+END_TEST
+
+START_TEST(test_seed_table) {
+    // The hardware seeds are consecutive substreams of seed 0
+    xoroshiro128plus_t xoro = { .s = { XORO_SEEDS[0][0], XORO_SEEDS[0][1] } };
+
+    for (size_t i = 1; i < XORO_SEEDS_LENGTH; i++) {
+        xoroshiro128plus_jump_pow2(&xoro, XORO_SEEDS_STRIDE_LOG2);
+        ck_assert_int_eq(xoro.s[0], XORO_SEEDS[i][0]);
+        ck_assert_int_eq(xoro.s[1], XORO_SEEDS[i][1]);
+    }
+
+    xoro.s[0] = XORO_SEEDS[0][0];
+    xoro.s[1] = XORO_SEEDS[0][1];
+    xoroshiro128plus_advance(&xoro, XORO_SEEDS_LENGTH - 1, 0);
+    ck_assert_int_eq(xoro.s[0], XORO_SEEDS[XORO_SEEDS_LENGTH - 1][0]);
+    ck_assert_int_eq(xoro.s[1], XORO_SEEDS[XORO_SEEDS_LENGTH - 1][1]);
+}
+END_TEST
+
 Suite *make_xoroshiro128plus_suite(void) {
     Suite *s;
     TCase *tc_core;
@@ -54,6 +164,9 @@ Suite *make_xoroshiro128plus_suite(void) {
 
     tcase_add_test(tc_core, test_splitmix64);
     tcase_add_test(tc_core, test_xoroshiro128plus);
+    tcase_add_test(tc_core, test_jump_short);
+    tcase_add_test(tc_core, test_jump_long);
+    tcase_add_test(tc_core, test_seed_table);
 
     suite_add_tcase(s, tc_core);
 
@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "boxmuller.h"
+#include "boxmuller_errmap.h"
+
+/*
+ * Sweeps every input of the selected function units of the boxmuller model
+ * (see boxmuller_errmap.h) and writes an error report per bin:
+ *
+ *   # <unit> inputs=<n> lsb=2^<k>
+ *   <unit> <bin> <n> <max_abs> <max_ulp> <mean> <mean_abs> <worst> <y> <y_ref>
+ *   <unit> all   ...
+ *
+ * The input space is split into chunks, which are handed out to the worker
+ * threads and merged in chunk order afterwards, so the report does not
+ * depend on the number of threads.
+ */
+
+#define MAX_CHUNKS_LOG2 9
+#define MIN_CHUNK_LOG2 16
+
+typedef struct sweep_t {
+    const boxmuller_t *bm;
+    boxmuller_unit_t unit;
+    size_t bins;
+    uint64_t chunk_size, chunks;
+    atomic_size_t next_chunk;
+    boxmuller_err_t *results;   // chunks * bins
+} sweep_t;
+
+static void *worker(void *p) {
+    sweep_t *ctx = p;
+
+    for (;;) {
+        size_t i = atomic_fetch_add(&ctx->next_chunk, 1);
+        if (i >= ctx->chunks)
+            break;
+
+        boxmuller_errmap_sweep(ctx->bm, ctx->unit, i * ctx->chunk_size, (i + 1) * ctx->chunk_size,
+                ctx->results + i * ctx->bins);
+    }
+
+    return NULL;
+}
+
+// Returns the merged bins, or NULL if no thread could be started
+static boxmuller_err_t *sweep_unit(const boxmuller_t *bm, boxmuller_unit_t unit, int threads) {
+    const boxmuller_unit_info_t *info = &BOXMULLER_UNITS[unit];
+    int chunk_log2 = info->input_bits - MAX_CHUNKS_LOG2;
+    if (chunk_log2 < MIN_CHUNK_LOG2)
+        chunk_log2 = MIN_CHUNK_LOG2;
+
+    sweep_t ctx = {
+        .bm = bm,
+        .unit = unit,
+        .bins = info->bins,
+        .chunk_size = UINT64_C(1) << chunk_log2,
+        .chunks = UINT64_C(1) << (info->input_bits - chunk_log2),
+    };
+    atomic_init(&ctx.next_chunk, 0);
+    ctx.results = calloc(ctx.chunks * ctx.bins, sizeof(boxmuller_err_t));
+
+    pthread_t *pool = malloc(threads * sizeof(pthread_t));
+    int started = 0;
+    for (; started < threads; started++)
+        if (pthread_create(&pool[started], NULL, worker, &ctx))
+            break;
+
+    for (int i = 0; i < started; i++)
+        pthread_join(pool[i], NULL);
+    free(pool);
+
+    if (!started) {
+        free(ctx.results);
+        return NULL;
+    }
+
+    boxmuller_err_t *bins = calloc(ctx.bins, sizeof(boxmuller_err_t));
+    for (size_t i = 0; i < ctx.chunks; i++)
+        for (size_t j = 0; j < ctx.bins; j++)
+            boxmuller_err_merge(&bins[j], &ctx.results[i * ctx.bins + j]);
+
+    free(ctx.results);
+    return bins;
+}
+
+static void report_bin(FILE *out, const boxmuller_t *bm, boxmuller_unit_t unit, const char *bin,
+        const boxmuller_err_t *err) {
+    double y, y_ref;
+    boxmuller_errmap_eval(bm, unit, err->worst, &y, &y_ref);
+
+    fprintf(out, "%s %s %lu %.6e %.3f %.6e %.6e 0x%08x %.12f %.12f\n", BOXMULLER_UNITS[unit].name, bin,
+            err->n, err->max_abs, ldexp(err->max_abs, -BOXMULLER_UNITS[unit].lsb_log2),
+            err->sum / err->n, err->sum_abs / err->n, err->worst, y, y_ref);
+}
+
+static void report_unit(FILE *out, const boxmuller_t *bm, boxmuller_unit_t unit, const boxmuller_err_t *bins) {
+    const boxmuller_unit_info_t *info = &BOXMULLER_UNITS[unit];
+    boxmuller_err_t all = { 0 };
+    char label[24];
+
+    fprintf(out, "# %s inputs=%lu lsb=2^%d\n", info->name, UINT64_C(1) << info->input_bits, info->lsb_log2);
+    fprintf(out, "# unit bin n max_abs max_ulp mean mean_abs worst y y_ref\n");
+
+    for (size_t i = 0; i < info->bins; i++) {
+        if (!bins[i].n)
+            continue;
+
+        // f is binned by exp_f
+        if (unit == BOXMULLER_UNIT_F)
+            snprintf(label, sizeof(label), "%d", (int) i - 6);
+        else
+            snprintf(label, sizeof(label), "%zu", i);
+
+        report_bin(out, bm, unit, label, &bins[i]);
+        boxmuller_err_merge(&all, &bins[i]);
+    }
+
+    report_bin(out, bm, unit, "all", &all);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-j THREADS] [-u UNIT[,UNIT...]] [OUTFILE]\n", prog);
+    fprintf(stderr, "  -j THREADS  Worker threads, default: number of online cores\n");
+    fprintf(stderr, "  -u UNITS    Units to sweep: ln, sqrt, f, sin, cos (default: all)\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *prog = argv[0];
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cores > 0 ? (int) cores : 1;
+    bool selected[BOXMULLER_UNIT_COUNT];
+    bool any = false;
+    memset(selected, 0, sizeof(selected));
+
+    int opt;
+    while ((opt = getopt(argc, argv, "j:u:")) != -1) {
+        switch (opt) {
+        case 'j':
+            if (sscanf(optarg, "%d", &threads) < 1 || threads < 1) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as thread count!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'u':
+            for (char *tok = strtok(optarg, ","); tok; tok = strtok(NULL, ",")) {
+                int u = 0;
+                while (u < BOXMULLER_UNIT_COUNT && strcmp(tok, BOXMULLER_UNITS[u].name))
+                    u++;
+
+                if (u == BOXMULLER_UNIT_COUNT) {
+                    fprintf(stderr, "%s: Unknown unit \"%s\"!\n", prog, tok);
+                    return EXIT_FAILURE;
+                }
+                selected[u] = any = true;
+            }
+            break;
+        default:
+            usage(prog);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind > 1) {
+        usage(prog);
+        return EXIT_FAILURE;
+    }
+
+    FILE *out = stdout;
+    if (optind < argc && !(out = fopen(argv[optind], "w"))) {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    boxmuller_t *bm = boxmuller_new();
+    int ret = 0;
+
+    for (int u = 0; u < BOXMULLER_UNIT_COUNT && !ret; u++) {
+        if (any && !selected[u])
+            continue;
+
+        boxmuller_err_t *bins = sweep_unit(bm, u, threads);
+        if (!bins) {
+            fprintf(stderr, "%s: Failed to start worker threads!\n", prog);
+            ret = EXIT_FAILURE;
+            break;
+        }
+
+        report_unit(out, bm, u, bins);
+        fflush(out);
+        free(bins);
+    }
+
+    boxmuller_free(bm);
+    if (out != stdout)
+        fclose(out);
+
+    return ret;
+}
@@ -0,0 +1,1091 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/*
+ * Fits the coefficient tables of the piecewise polynomial units and writes
+ * them into their sources:
+ *
+ *   ppfit ln|sqrt|trig ../src/pp_fcn_rom_pkg.vhd    ROMs of pp_fcn.vhd
+ *   ppfit -c ln|sqrt|cos|sin main/main.h           tables of main/gaussian.c
+ *
+ * Every table is evaluated bit for bit like its datapath: the ROMs like
+ * lib/boxmuller.c (i.e. pp_fcn.vhd), the C tables like FXPNT_FIXED_PP1/2 in
+ * pp_fx (8,32). Per segment, the polynomial through the function at the
+ * Chebyshev nodes is rounded to the coefficient lsbs, then every combination
+ * of c_1..c_d within +-RADIUS lsbs of it is tried, each with the c_0 that
+ * centers its error. The combination with the smallest maximum error of the
+ * unit's output wins, so every segment is minimax among the quantized
+ * neighbours of the real fit. At x = 0 the output is exact where it can be,
+ * as in the tables in the tree. Segments are fitted on all cores.
+ *
+ * Errors are measured at every input of a segment, or at 2^POINTS evenly
+ * spaced inputs including both ends for wider segments, in lsbs of the
+ * output. The table (type and constant, or static array) is replaced in
+ * place, or appended if FILE has none yet. Other segment counts or degrees
+ * also need the datapath (pp_fcn.vhd, lib/boxmuller.c or the LOG2_N of
+ * FXPNT_FIXED_PP2 in main/gaussian.c) to be changed. *
+ *   ppfit -x -s 6:9 -w 17:20,11:13 trig
+ *
+ * explores the design space of a ROM instead: every segment count and
+ * combination of widths in the ranges is fitted, its error is measured at
+ * every input, and its cost is estimated as RAMB18 tiles and DSP48E2
+ * slices. The results mark the Pareto front.
+ */
+
+#define MAX_TERMS 3
+#define MAX_FUNCS 2
+
+#define DEFAULT_RADIUS 4
+#define DEFAULT_POINTS_LOG2 14
+
+// pp_fcn_trig accumulates in 26 bits, output (2,16)
+#define TRIG_ACC_BITS 26
+
+// pp_fx, the format of main/gaussian.c
+#define C_N_I 8
+#define C_N_F 32
+
+typedef enum kind_t {
+    KIND_LN,
+    KIND_SQRT,
+    KIND_TRIG,
+    KIND_C
+} kind_t;
+
+typedef struct table_t {
+    const char *name;
+    const char *symbol;         // LOG_COEFF_TABLE_DATA or FXPNT_PP_LOG
+    kind_t kind;
+    double (*f)(double x);      // C tables
+    int funcs;                  // functions per entry, cos and sin for trig
+    int input_bits;
+    int log2_n;
+    int degree;
+    int width[MAX_TERMS];
+    bool is_unsigned[MAX_TERMS];
+    double lsb_log2;            // of the output
+
+    // Derived
+    int local_bits;             // input bits within a segment
+    double unit[MAX_TERMS];     // lsb of c_k as the coefficient of t^k, t in [0, 1), in datapath lsbs
+    int out_shift;              // output = datapath >> out_shift
+} table_t;
+
+typedef int64_t coeffs_t[MAX_FUNCS][MAX_TERMS];
+
+typedef struct seg_result_t {
+    double error;               // max, output lsbs
+    bool fits;
+} seg_result_t;
+
+typedef struct fit_t {
+    const table_t *t;
+    int radius;
+    int points_log2;
+    coeffs_t *coeffs;           // per segment
+    seg_result_t *results;
+    bool exhaustive;            // measure the final error at every input, not only at the points
+    atomic_size_t next_seg;
+} fit_t;
+
+// A configuration of an exploration and its cost
+typedef struct design_t {
+    int log2_n;
+    int width[MAX_TERMS];
+    size_t rom_bits;
+    int ramb18;
+    int mults[MAX_FUNCS * MAX_TERMS][2];    // signed operand widths
+    int n_mults;
+    int dsps;
+    double error;               // max, output lsbs
+    bool front;
+} design_t;
+
+static double cos_quarter(double x) {
+    return cos(M_PI / 2 * x);
+}
+
+static double sin_quarter(double x) {
+    return sin(M_PI / 2 * x);
+}
+
+static double sqrt_1p(double x) {
+    return sqrt(1 + x);
+}
+
+// Sign extends the lower n bits of x
+static inline int64_t sext(int64_t x, int n) {
+    return (int64_t)((uint64_t) x << (64 - n)) >> (64 - n);
+}
+
+// Sign-magnitude product of pp_fx, truncated towards zero, like pp_fx_mult
+static inline int64_t c_mult(int64_t a, int64_t b) {
+    uint64_t sign = (uint64_t)((a ^ b) >> 63);
+    uint64_t m_a = a < 0 ? -(uint64_t) a : (uint64_t) a;
+    uint64_t m_b = b < 0 ? -(uint64_t) b : (uint64_t) b;
+    int64_t y = sext((int64_t)(((unsigned __int128) m_a * m_b) >> C_N_F), C_N_I + C_N_F);
+    return (int64_t)(((uint64_t) y ^ sign) - sign);
+}
+
+static inline int64_t c_saturate(int64_t x) {
+    int64_t max = (INT64_C(1) << (C_N_I + C_N_F - 1)) - 1;
+    return x > max ? max : x < -max - 1 ? -max - 1 : x;
+}
+
+/*
+ * Value of the datapath for input i of a segment, before the output is
+ * truncated (lsb 2^out_shift of the output's)
+ */
+static int64_t eval(const table_t *t, const int64_t *c, uint64_t i) {
+    const int *w = t->width;
+
+    switch (t->kind) {
+    case KIND_LN: {
+        // see eval_ln in lib/boxmuller.c
+        int64_t x_a = i >> (t->local_bits - (w[1] - 1));
+        int64_t eta_2 = c[2] * (x_a >> (w[1] - w[2]));
+        int64_t mult_a = sext(c[1] + (eta_2 >> (w[2] - 1)), w[1]);
+        int64_t mult_p = sext((mult_a * x_a) >> (w[1] - 1), w[1] + 1);
+        return sext(mult_p + c[0], w[0]);
+    }
+    case KIND_SQRT:
+        // see eval_sqrt, the output drops bit 31
+        return ((uint32_t)((uint64_t) c[0] << (32 - w[0])) + (uint32_t)(c[1] * (int64_t) i)) & 0x7FFFFFFF;
+    case KIND_TRIG:
+        // see eval_trig
+        return sext(c[0] * (INT64_C(1) << (TRIG_ACC_BITS - w[0])) + c[1] * (int64_t) i, TRIG_ACC_BITS);
+    case KIND_C:
+        // see FXPNT_FIXED_PP1/2
+        if (t->degree == 1)
+            return c_saturate(c[0] + c_mult(i, c[1]));
+        return c_saturate(c[0] + c_mult(i, c[1] + c_mult(i, c[2])));
+    }
+    return 0;
+}
+
+// The function at input i (not necessarily integral) of segment seg, in datapath lsbs
+static double target(const table_t *t, int func, size_t seg, double i) {
+    double x = ldexp((double)(seg << t->local_bits) + i, -t->input_bits);
+
+    switch (t->kind) {
+    case KIND_LN:
+        return ldexp(log1p(x), t->width[0] - 1);
+    case KIND_SQRT: {
+        // The msb of the input selects sqrt(2 (1 + f)), the output has an implicit integer 1
+        bool odd = x >= 0.5;
+        double f = 2 * x - odd;
+        return ldexp(sqrt((1 + f) * (odd ? 2 : 1)) - 1, 31);
+    }
+    case KIND_TRIG:
+        return ldexp(func ? sin_quarter(x) : cos_quarter(x), TRIG_ACC_BITS - 2);
+    case KIND_C:
+        return ldexp(t->f(x), C_N_F);
+    }
+    return 0;
+}
+
+static bool coeff_fits(const table_t *t, int k, int64_t c) {
+    int w = t->width[k];
+    if (t->is_unsigned[k])
+        return c >= 0 && c < (INT64_C(1) << w);
+    return c >= -(INT64_C(1) << (w - 1)) && c < (INT64_C(1) << (w - 1));
+}
+
+/*
+ * Real coefficients a_k of t^k, in datapath lsbs, of the polynomial through
+ * the function at the Chebyshev nodes of the segment
+ */
+static void fit_real(const table_t *t, int func, size_t seg, double *a) {
+    int n = t->degree + 1;
+    double m[MAX_TERMS][MAX_TERMS + 1];
+
+    for (int j = 0; j < n; j++) {
+        double node = (1 - cos(M_PI * (j + 0.5) / n)) / 2;
+        double p = 1;
+        for (int k = 0; k < n; k++, p *= node)
+            m[j][k] = p;
+        m[j][n] = target(t, func, seg, ldexp(node, t->local_bits));
+    }
+
+    // Gaussian elimination with partial pivoting
+    for (int k = 0; k < n; k++) {
+        int pivot = k;
+        for (int j = k + 1; j < n; j++)
+            if (fabs(m[j][k]) > fabs(m[pivot][k]))
+                pivot = j;
+        for (int l = 0; l <= n; l++) {
+            double tmp = m[k][l];
+            m[k][l] = m[pivot][l];
+            m[pivot][l] = tmp;
+        }
+        for (int j = 0; j < n; j++) {
+            if (j == k)
+                continue;
+            double r = m[j][k] / m[k][k];
+            for (int l = k; l <= n; l++)
+                m[j][l] -= r * m[k][l];
+        }
+    }
+
+    for (int k = 0; k < n; k++)
+        a[k] = m[k][n] / m[k][k];
+}
+
+typedef struct points_t {
+    size_t n;
+    uint64_t *i;
+    double *y;      // target
+    int64_t *p;     // datapath
+} points_t;
+
+static void points_init(points_t *pts, const table_t *t, int points_log2) {
+    int p = t->local_bits < points_log2 ? t->local_bits : points_log2;
+    int step = t->local_bits - p;
+
+    pts->n = (size_t) 1 << p;
+    pts->n += step > 0;
+    pts->i = malloc(sizeof(uint64_t) * pts->n);
+    pts->y = malloc(sizeof(double) * pts->n);
+    pts->p = malloc(sizeof(int64_t) * pts->n);
+
+    for (size_t j = 0; j < pts->n; j++)
+        pts->i[j] = j << step;
+    if (step > 0)
+        pts->i[pts->n - 1] = (UINT64_C(1) << t->local_bits) - 1;
+}
+
+static void points_free(points_t *pts) {
+    free(pts->i);
+    free(pts->y);
+    free(pts->p);
+}
+
+// Max error of the output in output lsbs, with coefficients c
+static double max_error(const table_t *t, const points_t *pts, const int64_t *c) {
+    double scale = ldexp(1, -t->out_shift), error = 0;
+    for (size_t j = 0; j < pts->n; j++)
+        error = fmax(error, fabs((double)(eval(t, c, pts->i[j]) >> t->out_shift) - pts->y[j] * scale));
+    return error;
+}
+
+/*
+ * Best quantized coefficients of one function of a segment, returns the
+ * error or INFINITY if no candidate fits the widths
+ */
+static double fit_func(const fit_t *ctx, points_t *pts, int func, size_t seg, int64_t *best) {
+    const table_t *t = ctx->t;
+    int d = t->degree;
+    double a[MAX_TERMS];
+
+    for (size_t j = 0; j < pts->n; j++)
+        pts->y[j] = target(t, func, seg, pts->i[j]);
+    fit_real(t, func, seg, a);
+
+    int64_t base[MAX_TERMS] = { 0 };
+    for (int k = 1; k <= d; k++)
+        base[k] = llround(a[k] / t->unit[k]);
+
+    // Every c_1..c_d in the box, by the spread of the datapath error without c_0
+    int64_t c[MAX_TERMS] = { 0 };
+    int off[MAX_TERMS] = { 0 };
+    double best_spread = INFINITY, best_center = 0;
+    for (int k = 1; k <= d; k++)
+        off[k] = -ctx->radius;
+
+    for (;;) {
+        bool fits = true;
+        for (int k = 1; k <= d; k++) {
+            c[k] = base[k] + off[k];
+            fits &= coeff_fits(t, k, c[k]);
+        }
+
+        if (fits) {
+            double lo = INFINITY, hi = -INFINITY;
+            for (size_t j = 0; j < pts->n && hi - lo < best_spread; j++) {
+                double e = (double) eval(t, c, pts->i[j]) - pts->y[j];
+                lo = fmin(lo, e);
+                hi = fmax(hi, e);
+            }
+
+            if (hi - lo < best_spread) {
+                best_spread = hi - lo;
+                best_center = (lo + hi) / 2;
+                memcpy(best, c, sizeof(c));
+            }
+        }
+
+        int k = 1;
+        while (k <= d && off[k] == ctx->radius)
+            off[k++] = -ctx->radius;
+        if (k > d)
+            break;
+        off[k]++;
+    }
+
+    if (isinf(best_spread))
+        return INFINITY;
+
+    // c_0 centers the error of the truncated output, which is half an output lsb lower
+    double half = ldexp(1, t->out_shift - 1);
+    int64_t c_0 = llround((half - best_center) / t->unit[0]);
+    int window = 2 + (int)(half / t->unit[0]);
+    int64_t lo = c_0 - window, hi = c_0 + window;
+
+    // Exact at x = 0 where the output can be, like the tables in the tree: ln(1), sqrt(1), sin(0) and cos(0)
+    double y_0 = target(t, func, seg, 0), lsb = 2 * half;
+    if (seg == 0 && y_0 == floor(y_0 / lsb) * lsb) {
+        lo = (int64_t) ceil(y_0 / t->unit[0]);
+        hi = (int64_t) ceil((y_0 + lsb) / t->unit[0]) - 1;
+    }
+
+    double best_error = INFINITY;
+    int64_t best_c_0 = c_0;
+
+    for (int64_t k = lo; k <= hi; k++) {
+        if (!coeff_fits(t, 0, k))
+            continue;
+        best[0] = k;
+        double error = max_error(t, pts, best);
+        if (error < best_error) {
+            best_error = error;
+            best_c_0 = k;
+        }
+    }
+
+    best[0] = best_c_0;
+    return best_error;
+}
+
+// Max error of the output at every input of a segment
+static double segment_error(const table_t *t, int func, size_t seg, const int64_t *c) {
+    double scale = ldexp(1, -t->out_shift), error = 0;
+    for (uint64_t i = 0; i < UINT64_C(1) << t->local_bits; i++)
+        error = fmax(error, fabs((double)(eval(t, c, i) >> t->out_shift) - target(t, func, seg, i) * scale));
+    return error;
+}
+
+static void *worker(void *p) {
+    fit_t *ctx = p;
+    const table_t *t = ctx->t;
+    points_t pts;
+    points_init(&pts, t, ctx->points_log2);
+
+    for (;;) {
+        size_t seg = atomic_fetch_add(&ctx->next_seg, 1);
+        if (seg >= (size_t) 1 << t->log2_n)
+            break;
+
+        seg_result_t *r = &ctx->results[seg];
+        r->fits = true;
+        for (int func = 0; func < t->funcs; func++) {
+            double error = fit_func(ctx, &pts, func, seg, ctx->coeffs[seg][func]);
+            if (ctx->exhaustive && !isinf(error))
+                error = segment_error(t, func, seg, ctx->coeffs[seg][func]);
+            r->fits &= !isinf(error);
+            r->error = fmax(r->error, error);
+        }
+    }
+
+    points_free(&pts);
+    return NULL;
+}
+
+// Fits all segments on a pool of threads, false if none could be started
+static bool fit_table(fit_t *ctx, int threads) {
+    size_t n = (size_t) 1 << ctx->t->log2_n;
+    memset(ctx->coeffs, 0, n * sizeof(coeffs_t));
+    memset(ctx->results, 0, n * sizeof(seg_result_t));
+    atomic_init(&ctx->next_seg, 0);
+
+    pthread_t *pool = malloc(threads * sizeof(pthread_t));
+    int started = 0;
+    for (; started < threads; started++)
+        if (pthread_create(&pool[started], NULL, worker, ctx))
+            break;
+    for (int i = 0; i < started; i++)
+        pthread_join(pool[i], NULL);
+    free(pool);
+
+    return started > 0;
+}
+
+// Max error of a whole table, and its segment
+static double table_error(const table_t *t, int points_log2, coeffs_t *coeffs, size_t *worst) {
+    points_t pts;
+    points_init(&pts, t, points_log2);
+    double error = 0;
+
+    for (size_t seg = 0; seg < (size_t) 1 << t->log2_n; seg++) {
+        for (int func = 0; func < t->funcs; func++) {
+            for (size_t j = 0; j < pts.n; j++)
+                pts.y[j] = target(t, func, seg, pts.i[j]);
+
+            double e = max_error(t, &pts, coeffs[seg][func]);
+            if (e > error) {
+                error = e;
+                *worst = seg;
+            }
+        }
+    }
+
+    points_free(&pts);
+    return error;
+}
+
+static int entry_width(const table_t *t) {
+    int w = 0;
+    for (int k = 0; k <= t->degree; k++)
+        w += t->width[k];
+    return w * t->funcs;
+}
+
+// The ROM vector of a segment: [func 1: C_d .. C_0][func 0: C_d .. C_0], msb first
+static void rom_vector(const table_t *t, coeffs_t c, char *s) {
+    for (int func = t->funcs - 1; func >= 0; func--)
+        for (int k = t->degree; k >= 0; k--)
+            for (int b = t->width[k] - 1; b >= 0; b--)
+                *s++ = '0' + (((uint64_t) c[func][k] >> b) & 1);
+    *s = '\0';
+}
+
+static bool rom_parse(const table_t *t, const char *s, coeffs_t c) {
+    for (int func = t->funcs - 1; func >= 0; func--) {
+        for (int k = t->degree; k >= 0; k--) {
+            uint64_t v = 0;
+            for (int b = 0; b < t->width[k]; b++, s++) {
+                if (*s != '0' && *s != '1')
+                    return false;
+                v = (v << 1) | (*s & 1);
+            }
+            c[func][k] = t->is_unsigned[k] ? (int64_t) v : sext(v, t->width[k]);
+        }
+    }
+    return *s == '"';
+}
+
+static void lower(char *s) {
+    for (; *s; s++)
+        *s = tolower((unsigned char) *s);
+}
+
+static void emit_rom(FILE *out, const table_t *t, coeffs_t *coeffs) {
+    size_t n = (size_t) 1 << t->log2_n;
+    char type[64];
+    snprintf(type, sizeof(type), "%s", t->symbol);
+    *strstr(type, "_COEFF") = '\0';
+    lower(type);
+    strcat(type, "_coeff_table_t");
+
+    char *vec = malloc(entry_width(t) + 1);
+    fprintf(out, "    type %s is array(0 to %zu) of std_logic_vector(%d downto 0);\n", type, n - 1,
+            entry_width(t) - 1);
+    fprintf(out, "    constant %s : %s := (\n", t->symbol, type);
+    for (size_t seg = 0; seg < n; seg++) {
+        rom_vector(t, coeffs[seg], vec);
+        fprintf(out, "        \"%s\"%s\n", vec, seg + 1 < n ? "," : "");
+    }
+    fprintf(out, "    );\n");
+    free(vec);
+}
+
+static void emit_c(FILE *out, const table_t *t, coeffs_t *coeffs) {
+    size_t n = (size_t) 1 << t->log2_n;
+
+    fprintf(out, "static const FXPNT_PP_ALIGN fxpnt_pp%d_seg_t %s[%zu] = {\n", t->degree, t->symbol, n);
+    for (size_t seg = 0; seg < n; seg++) {
+        // fxpnt_pp2_seg_t is padded to 32 bytes
+        fprintf(out, "    {");
+        for (int k = 0; k <= t->degree; k++)
+            fprintf(out, "%s %12ld", k ? "," : "", coeffs[seg][0][k]);
+        fprintf(out, "%s }%s\n", t->degree == 2 ? ", 0" : "", seg + 1 < n ? "," : "");
+    }
+    fprintf(out, "};\n");
+}
+
+/*
+ * The table in the file: [*begin, *end) are its lines, or both point to
+ * where it would be inserted. Returns whether it exists.
+ */
+static bool find_table(const table_t *t, char *src, char **begin, char **end) {
+    char key[64];
+    snprintf(key, sizeof(key), t->kind == KIND_C ? "%s[" : "constant %s ", t->symbol);
+
+    char *p = strstr(src, key);
+    if (!p) {
+        // Before the end of the package, or the include guard
+        const char *anchor = t->kind == KIND_C ? "#endif" : "end package;";
+        char *last = NULL;
+        for (char *q = strstr(src, anchor); q; q = strstr(q + 1, anchor))
+            last = q;
+        *begin = *end = last ? last : src + strlen(src);
+        return false;
+    }
+
+    // The table ends after the constant, the type declaration precedes it
+    char *close = strstr(p, t->kind == KIND_C ? "};" : ");");
+    *end = close ? strchr(close, '\n') : NULL;
+    *end = *end ? *end + 1 : src + strlen(src);
+
+    if (t->kind != KIND_C) {
+        char *type = p;
+        while (type > src && type[-1] != '\n')
+            type--;
+        if (type > src) {
+            char *prev = type - 1;
+            while (prev > src && prev[-1] != '\n')
+                prev--;
+            if (strstr(prev, "type ") && strstr(prev, "type ") < type)
+                p = prev;
+        }
+    }
+
+    while (p > src && p[-1] != '\n')
+        p--;
+    *begin = p;
+    return true;
+}
+
+// Coefficients of the existing table, false if its layout differs
+static bool parse_table(const table_t *t, const char *begin, const char *end, coeffs_t *coeffs) {
+    size_t n = (size_t) 1 << t->log2_n, seg = 0;
+    const char *p = strchr(begin, t->kind == KIND_C ? '{' : '(');
+
+    while (p && (p = strchr(p + 1, t->kind == KIND_C ? '{' : '"')) && p < end) {
+        if (seg == n)
+            return false;
+
+        if (t->kind == KIND_C) {
+            char *q = (char *) p + 1;
+            for (int k = 0; k <= t->degree; k++) {
+                coeffs[seg][0][k] = strtoll(q, &q, 10);
+                if (*q++ != ',' && k < t->degree)
+                    return false;
+            }
+            p = strchr(p, '}');
+        } else {
+            if (!rom_parse(t, p + 1, coeffs[seg]))
+                return false;
+            p = strchr(p + 1, '"');
+        }
+        seg++;
+    }
+
+    return seg == n;
+}
+
+static char *read_file(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return NULL;
+
+    size_t n = 0, cap = 4096;
+    char *buf = malloc(cap);
+    size_t r;
+    while ((r = fread(buf + n, 1, cap - n - 1, f)) > 0) {
+        n += r;
+        if (n + 1 == cap)
+            buf = realloc(buf, cap *= 2);
+    }
+    buf[n] = 0;
+
+    fclose(f);
+    return buf;
+}
+
+static const table_t TABLES[] = {
+    { .name = "ln", .symbol = "LOG_COEFF_TABLE_DATA", .kind = KIND_LN, .funcs = 1, .input_bits = 31, .log2_n = 8,
+      .degree = 2, .width = { 31, 23, 14 }, .is_unsigned = { false, true, false }, .lsb_log2 = -27 },
+    { .name = "sqrt", .symbol = "SQRT_COEFF_TABLE_DATA", .kind = KIND_SQRT, .funcs = 1, .input_bits = 20, .log2_n = 7,
+      .degree = 1, .width = { 19, 13 }, .is_unsigned = { true, false }, .lsb_log2 = -16 },
+    { .name = "trig", .symbol = "TRIG_COEFF_TABLE_DATA", .kind = KIND_TRIG, .funcs = 2, .input_bits = 14, .log2_n = 7,
+      .degree = 1, .width = { 19, 12 }, .lsb_log2 = -16 },
+};
+
+static const table_t C_TABLES[] = {
+    { .name = "ln", .symbol = "FXPNT_PP_LOG", .kind = KIND_C, .f = log1p, .funcs = 1, .input_bits = C_N_F,
+      .log2_n = 8, .degree = 2, .width = { 40, 40, 40 }, .lsb_log2 = -C_N_F },
+    { .name = "sqrt", .symbol = "FXPNT_PP_SQRT", .kind = KIND_C, .f = sqrt_1p, .funcs = 1, .input_bits = C_N_F,
+      .log2_n = 4, .degree = 2, .width = { 40, 40, 40 }, .lsb_log2 = -C_N_F },
+    { .name = "cos", .symbol = "FXPNT_PP_COS", .kind = KIND_C, .f = cos_quarter, .funcs = 1, .input_bits = C_N_F,
+      .log2_n = 4, .degree = 2, .width = { 40, 40, 40 }, .lsb_log2 = -C_N_F },
+    { .name = "sin", .symbol = "FXPNT_PP_SIN", .kind = KIND_C, .f = sin_quarter, .funcs = 1, .input_bits = C_N_F,
+      .log2_n = 4, .degree = 2, .width = { 40, 40, 40 }, .lsb_log2 = -C_N_F },
+};
+
+// Derived fields, returns an error message if the parameters do not fit the datapath
+static const char *table_init(table_t *t) {
+    const int *w = t->width;
+
+    if (t->log2_n < 1 || t->log2_n >= t->input_bits)
+        return "segment count out of range";
+    t->local_bits = t->input_bits - t->log2_n;
+    for (int k = 0; k <= t->degree; k++)
+        if (w[k] < 2 || w[k] > 62)
+            return "widths must be 2..62 bits";
+
+    switch (t->kind) {
+    case KIND_LN:
+        if (w[0] < 28 || w[1] < w[2] || t->local_bits < w[1] - 1)
+            return "pp_fcn_ln needs c_0 >= 28 bits, c_1 >= c_2 and c_1 <= 1 + input bits per segment";
+        t->unit[0] = t->unit[1] = t->unit[2] = 1;
+        t->out_shift = w[0] - 28;
+        break;
+    case KIND_SQRT:
+        if (w[0] > 32 || w[0] < 17 || t->log2_n < 2)
+            return "pp_fcn_sqrt needs c_0 of 17..32 bits and at least 4 segments";
+        t->unit[0] = ldexp(1, 32 - w[0]);
+        t->unit[1] = ldexp(1, t->local_bits);
+        t->out_shift = 15;
+        break;
+    case KIND_TRIG:
+        if (w[0] > TRIG_ACC_BITS || w[0] < 10)
+            return "pp_fcn_trig needs c_0 of 10..26 bits";
+        t->unit[0] = ldexp(1, TRIG_ACC_BITS - w[0]);
+        t->unit[1] = ldexp(1, t->local_bits);
+        t->out_shift = 8;
+        break;
+    case KIND_C:
+        t->unit[0] = 1;
+        t->unit[1] = ldexp(1, -t->log2_n);
+        t->unit[2] = ldexp(1, -2 * t->log2_n);
+        t->out_shift = 0;
+        break;
+    }
+    return NULL;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Cost of a ROM on the XCZU28DR: pp_fcn.vhd forces block ROMs, which are
+ * counted in RAMB18 tiles of the cheapest aspect ratio, and every product
+ * is counted in DSP48E2 slices (27 x 18 signed, wider products are tiled
+ * from 26 x 17 unsigned parts).
+ */
+static const int RAMB18_SHAPES[][2] = {
+    { 512, 36 }, { 1024, 18 }, { 2048, 9 }, { 4096, 4 }, { 8192, 2 }, { 16384, 1 }
+};
+
+static int rom_ramb18(const table_t *t) {
+    size_t depth = (size_t) 1 << t->log2_n;
+    int width = entry_width(t), best = INT32_MAX;
+
+    for (size_t i = 0; i < sizeof(RAMB18_SHAPES) / sizeof(RAMB18_SHAPES[0]); i++) {
+        size_t tiles = (depth + RAMB18_SHAPES[i][0] - 1) / RAMB18_SHAPES[i][0]
+                     * ((width + RAMB18_SHAPES[i][1] - 1) / RAMB18_SHAPES[i][1]);
+        if (tiles < (size_t) best)
+            best = (int) tiles;
+    }
+    return best;
+}
+
+static int dsp_tiles(int bits, int port) {
+    return bits <= port ? 1 : 1 + (bits - port + port - 2) / (port - 1);
+}
+
+static int dsp48e2(int a, int b) {
+    int ab = dsp_tiles(a, 27) * dsp_tiles(b, 18);
+    int ba = dsp_tiles(a, 18) * dsp_tiles(b, 27);
+    return ab < ba ? ab : ba;
+}
+
+// Signed operand widths of the products of the datapath, returns their count
+static int multipliers(const table_t *t, int m[][2]) {
+    const int *w = t->width;
+
+    switch (t->kind) {
+    case KIND_LN:
+        // c_2 * x(top), (c_1 + eta_2) * x
+        m[0][0] = m[0][1] = w[2];
+        m[1][0] = m[1][1] = w[1];
+        return 2;
+    case KIND_SQRT:
+        m[0][0] = w[1];
+        m[0][1] = t->local_bits + 1;
+        return 1;
+    case KIND_TRIG:
+        for (int func = 0; func < 2; func++) {
+            m[func][0] = w[1];
+            m[func][1] = t->local_bits + 1;
+        }
+        return 2;
+    case KIND_C:
+        break;
+    }
+    return 0;
+}
+
+static void design_print(FILE *out, const table_t *t, const design_t *d) {
+    fprintf(out, "%d ", d->log2_n);
+    for (int k = 0; k <= t->degree; k++)
+        fprintf(out, "%s%d", k ? "," : "", d->width[k]);
+    fprintf(out, " %zu %d ", d->rom_bits, d->ramb18);
+    for (int i = 0; i < d->n_mults; i++)
+        fprintf(out, "%s%dx%d", i ? "," : "", d->mults[i][0], d->mults[i][1]);
+    fprintf(out, " %d %.6e %.3f %d\n", d->dsps, ldexp(d->error, (int) t->lsb_log2), d->error, d->front);
+}
+
+static int design_cmp(const void *a, const void *b) {
+    const design_t *x = a, *y = b;
+    if (x->ramb18 != y->ramb18)
+        return x->ramb18 - y->ramb18;
+    if (x->dsps != y->dsps)
+        return x->dsps - y->dsps;
+    return (x->error > y->error) - (x->error < y->error);
+}
+
+/*
+ * Fits every combination of segment count and widths within the ranges and
+ * writes them with their cost, sorted by RAMB18 tiles, DSPs and error. The
+ * Pareto front of error, RAMB18 tiles, DSPs and ROM bits (which break ties
+ * between equal tiles) is marked.
+ */
+static int explore(const char *prog, const table_t *base, const int *log2_n, int w[][2], int radius,
+        int points_log2, bool exhaustive, int threads, FILE *out) {
+    size_t cap = 16, n = 0, skipped = 0;
+    design_t *designs = malloc(cap * sizeof(design_t));
+    int terms = base->degree + 1;
+    double start = now();
+    bool progress = isatty(STDERR_FILENO);
+
+    for (int s = log2_n[0]; s <= log2_n[1]; s++) {
+        int width[MAX_TERMS];
+        for (int k = 0; k < terms; k++)
+            width[k] = w[k][0];
+
+        for (;;) {
+            table_t t = *base;
+            t.log2_n = s;
+            memcpy(t.width, width, sizeof(width));
+
+            if (!table_init(&t)) {
+                size_t segs = (size_t) 1 << s;
+                fit_t ctx = {
+                    .t = &t,
+                    .radius = radius,
+                    .points_log2 = points_log2,
+                    .coeffs = malloc(segs * sizeof(coeffs_t)),
+                    .results = malloc(segs * sizeof(seg_result_t)),
+                    .exhaustive = exhaustive,
+                };
+
+                if (!fit_table(&ctx, threads)) {
+                    fprintf(stderr, "%s: Failed to start worker threads!\n", prog);
+                    return EXIT_FAILURE;
+                }
+
+                design_t d = { .log2_n = s, .rom_bits = segs * entry_width(&t), .ramb18 = rom_ramb18(&t) };
+                memcpy(d.width, width, sizeof(width));
+                d.n_mults = multipliers(&t, d.mults);
+                for (int i = 0; i < d.n_mults; i++)
+                    d.dsps += dsp48e2(d.mults[i][0], d.mults[i][1]);
+
+                bool fits = true;
+                for (size_t seg = 0; seg < segs; seg++) {
+                    fits &= ctx.results[seg].fits;
+                    d.error = fmax(d.error, ctx.results[seg].error);
+                }
+                free(ctx.coeffs);
+                free(ctx.results);
+
+                if (fits) {
+                    if (n == cap)
+                        designs = realloc(designs, (cap *= 2) * sizeof(design_t));
+                    designs[n++] = d;
+                    if (progress)
+                        fprintf(stderr, "\r%zu configurations, %.1f s", n, now() - start);
+                } else {
+                    skipped++;
+                }
+            } else {
+                skipped++;
+            }
+
+            int k = 0;
+            while (k < terms && width[k] == w[k][1]) {
+                width[k] = w[k][0];
+                k++;
+            }
+            if (k == terms)
+                break;
+            width[k]++;
+        }
+    }
+    fprintf(stderr, "%s%zu configurations, %zu skipped (invalid, or the coefficients overflow), %.1f s\n",
+            progress ? "\r" : "", n,
+            skipped, now() - start);
+
+    for (size_t i = 0; i < n; i++) {
+        design_t *a = &designs[i];
+        a->front = true;
+        for (size_t j = 0; j < n && a->front; j++) {
+            design_t *b = &designs[j];
+            bool le = b->error <= a->error && b->ramb18 <= a->ramb18 && b->dsps <= a->dsps
+                   && b->rom_bits <= a->rom_bits;
+            bool lt = b->error < a->error || b->ramb18 < a->ramb18 || b->dsps < a->dsps || b->rom_bits < a->rom_bits;
+            a->front = !(le && lt);
+        }
+    }
+    qsort(designs, n, sizeof(design_t), design_cmp);
+
+    fprintf(out, "# %s inputs=%" PRIu64 " lsb=2^%d %s\n", base->name, UINT64_C(1) << base->input_bits,
+            (int) base->lsb_log2, exhaustive ? "exhaustive" : "sampled");
+    fprintf(out, "# log2_n widths rom_bits ramb18 multipliers dsp48e2 max_abs max_ulp front\n");
+    for (size_t i = 0; i < n; i++)
+        design_print(out, base, &designs[i]);
+
+    free(designs);
+    return EXIT_SUCCESS;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-c] [-s LOG2_SEGMENTS] [-d DEGREE] [-w W_0,W_1,...] [-r RADIUS] [-p POINTS] "
+                    "[-j THREADS] [-t] <FUNCTION> <FILE>\n", prog);
+    fprintf(stderr, "       %s -x [-s MIN:MAX] [-w MIN:MAX,MIN:MAX,...] [-r RADIUS] [-p POINTS] [-j THREADS] "
+                    "<ln|sqrt|trig> [OUTFILE]\n", prog);
+    fprintf(stderr, "  FUNCTION          ln, sqrt or trig (sin and cos): the ROM of pp_fcn.vhd in FILE, e.g.\n");
+    fprintf(stderr, "                    src/pp_fcn_rom_pkg.vhd\n");
+    fprintf(stderr, "  -c                ln, sqrt, cos or sin: the table of main/gaussian.c in FILE, e.g. main/main.h\n");
+    fprintf(stderr, "  -s LOG2_SEGMENTS  2^LOG2_SEGMENTS segments, default ln 8, sqrt and trig 7, with -c 8 and 4\n");
+    fprintf(stderr, "  -d DEGREE         With -c, 1 or 2 (default). The ROMs have the degree of their datapath.\n");
+    fprintf(stderr, "  -w W_0,W_1,...    Coefficient widths, default ln 31,23,14, sqrt 19,13, trig 19,12, -c 40\n");
+    fprintf(stderr, "  -r RADIUS         Search c_1.. within +-RADIUS lsbs of the rounded fit, default %d\n",
+            DEFAULT_RADIUS);
+    fprintf(stderr, "  -p POINTS         Measure the error at up to 2^POINTS inputs per segment, default %d\n",
+            DEFAULT_POINTS_LOG2);
+    fprintf(stderr, "  -j THREADS        Worker threads, default: number of online cores\n");
+    fprintf(stderr, "  -t                Only report the errors of the fit and of the table in FILE\n");
+    fprintf(stderr, "  -x                Fit every ROM with segments and widths within the ranges (default: the\n");
+    fprintf(stderr, "                    current value) and write error and cost to OUTFILE (default: stdout).\n");
+    fprintf(stderr, "                    The error is measured at every input unless -p is given.\n");
+}
+
+// "A" or "A:B"
+static bool parse_range(const char *s, int *range) {
+    int n = sscanf(s, "%d:%d", &range[0], &range[1]);
+    if (n == 1)
+        range[1] = range[0];
+    return n >= 1 && range[0] <= range[1];
+}
+
+int main(int argc, char *argv[]) {
+    const char *prog = argv[0];
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cores > 0 ? (int) cores : 1;
+    bool c_table = false, dry_run = false, exploring = false, sampled = false;
+    int log2_n[2] = { 0, 0 }, degree = 0, radius = DEFAULT_RADIUS, points_log2 = DEFAULT_POINTS_LOG2;
+    int widths[MAX_TERMS][2], n_widths = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "cs:d:w:r:p:j:tx")) != -1) {
+        switch (opt) {
+        case 'c':
+            c_table = true;
+            break;
+        case 's':
+            if (!parse_range(optarg, log2_n) || log2_n[0] < 1) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as segment count!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'd':
+            if (sscanf(optarg, "%d", &degree) < 1 || degree < 1 || degree > 2) {
+                fprintf(stderr, "%s: Invalid argument, the degree must be 1 or 2!\n", prog);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'w':
+            for (char *tok = strtok(optarg, ","); tok; tok = strtok(NULL, ",")) {
+                if (n_widths == MAX_TERMS || !parse_range(tok, widths[n_widths++])) {
+                    fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as widths!\n", prog, optarg);
+                    return EXIT_FAILURE;
+                }
+            }
+            break;
+        case 'r':
+            if (sscanf(optarg, "%d", &radius) < 1 || radius < 0) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as radius!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'p':
+            if (sscanf(optarg, "%d", &points_log2) < 1 || points_log2 < 1 || points_log2 > 24) {
+                fprintf(stderr, "%s: Invalid argument, POINTS must be 1..24!\n", prog);
+                return EXIT_FAILURE;
+            }
+            sampled = true;
+            break;
+        case 'j':
+            if (sscanf(optarg, "%d", &threads) < 1 || threads < 1) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as thread count!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            dry_run = true;
+            break;
+        case 'x':
+            exploring = true;
+            break;
+        default:
+            usage(prog);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (exploring ? argc - optind < 1 || argc - optind > 2 || c_table : argc - optind != 2) {
+        usage(prog);
+        return EXIT_FAILURE;
+    }
+
+    const table_t *tables = c_table ? C_TABLES : TABLES;
+    size_t n_tables = c_table ? sizeof(C_TABLES) / sizeof(C_TABLES[0]) : sizeof(TABLES) / sizeof(TABLES[0]);
+    table_t t = { 0 };
+    for (size_t i = 0; i < n_tables && !t.name; i++)
+        if (!strcmp(tables[i].name, argv[optind]))
+            t = tables[i];
+
+    if (!t.name) {
+        fprintf(stderr, "%s: Unknown function \"%s\"%s\n", prog, argv[optind],
+                c_table ? ", the C tables are ln, sqrt, cos and sin" : ", the ROMs are ln, sqrt and trig");
+        return EXIT_FAILURE;
+    }
+
+    if (degree && !c_table && degree != t.degree) {
+        fprintf(stderr, "%s: The %s ROM has degree %d, like its datapath\n", prog, t.name, t.degree);
+        return EXIT_FAILURE;
+    }
+
+    t.degree = degree ? degree : t.degree;
+    if (n_widths && n_widths != t.degree + 1 && !(c_table && n_widths == 1)) {
+        fprintf(stderr, "%s: Expected %d widths\n", prog, t.degree + 1);
+        return EXIT_FAILURE;
+    }
+    for (int k = 0; k <= t.degree; k++) {
+        if (!n_widths)
+            widths[k][0] = widths[k][1] = t.width[k];
+        else if (n_widths == 1)
+            memcpy(widths[k], widths[0], sizeof(widths[0]));
+    }
+    if (!log2_n[0])
+        log2_n[0] = log2_n[1] = t.log2_n;
+
+    if (exploring) {
+        FILE *out = stdout;
+        if (argc - optind == 2 && !(out = fopen(argv[optind + 1], "w"))) {
+            fprintf(stderr, "%s: Failed to open output file: %s\n", prog, strerror(errno));
+            return EXIT_FAILURE;
+        }
+
+        int ret = explore(prog, &t, log2_n, widths, radius, points_log2, !sampled, threads, out);
+        if (out != stdout)
+            fclose(out);
+        return ret;
+    }
+
+    bool ranges = log2_n[0] != log2_n[1];
+    for (int k = 0; k <= t.degree; k++) {
+        ranges |= widths[k][0] != widths[k][1];
+        t.width[k] = widths[k][0];
+    }
+    t.log2_n = log2_n[0];
+    if (ranges) {
+        fprintf(stderr, "%s: Ranges of segments or widths need -x\n", prog);
+        return EXIT_FAILURE;
+    }
+
+    const char *invalid = table_init(&t);
+    if (invalid) {
+        fprintf(stderr, "%s: %s\n", prog, invalid);
+        return EXIT_FAILURE;
+    }
+
+    const char *path = argv[optind + 1];
+    char *src = read_file(path);
+    if (!src) {
+        fprintf(stderr, "%s: Failed to open input file: %s\n", prog, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    size_t n = (size_t) 1 << t.log2_n;
+    fit_t ctx = {
+        .t = &t,
+        .radius = radius,
+        .points_log2 = points_log2,
+        .coeffs = malloc(n * sizeof(coeffs_t)),
+        .results = malloc(n * sizeof(seg_result_t)),
+    };
+
+    double start = now();
+    if (!fit_table(&ctx, threads)) {
+        fprintf(stderr, "%s: Failed to start worker threads!\n", prog);
+        return EXIT_FAILURE;
+    }
+
+    size_t worst = 0;
+    for (size_t seg = 0; seg < n; seg++) {
+        if (!ctx.results[seg].fits) {
+            fprintf(stderr, "%s: The coefficients of segment %zu do not fit the widths\n", prog, seg);            return EXIT_FAILURE;
+        }
+        if (ctx.results[seg].error > ctx.results[worst].error)
+            worst = seg;
+    }
+
+    size_t points = (size_t) 1 << (t.local_bits < points_log2 ? t.local_bits : points_log2);
+    fprintf(stderr, "%s: %zu segments, degree %d, widths", t.symbol, n, t.degree);
+    for (int k = 0; k <= t.degree; k++)
+        fprintf(stderr, "%s%d", k ? "," : " ", t.width[k]);
+    fprintf(stderr, ", %zu%s inputs per segment\n", points, points < (size_t) 1 << t.local_bits ? "+1" : "");
+    fprintf(stderr, "  fit:      max error %.4f lsb (2^%g) in segment %zu, %.2f s\n", ctx.results[worst].error,
+            t.lsb_log2, worst, now() - start);
+
+    char *begin, *end;
+    coeffs_t *old = calloc(n, sizeof(coeffs_t));
+    if (find_table(&t, src, &begin, &end) && parse_table(&t, begin, end, old)) {
+        size_t old_worst = 0;
+        double error = table_error(&t, points_log2, old, &old_worst);
+        fprintf(stderr, "  in file:  max error %.4f lsb in segment %zu\n", error, old_worst);
+    }
+    free(old);
+
+    int ret = EXIT_SUCCESS;
+    if (!dry_run) {
+        FILE *out = fopen(path, "w");
+        if (!out) {
+            fprintf(stderr, "%s: Failed to open output file: %s\n", prog, strerror(errno));
+            ret = EXIT_FAILURE;
+        } else {
+            bool insert = begin == end;
+            fwrite(src, 1, begin - src, out);
+            if (t.kind == KIND_C)
+                emit_c(out, &t, ctx.coeffs);
+            else
+                emit_rom(out, &t, ctx.coeffs);
+            if (insert)
+                fputs("\n", out);
+            fputs(end, out);
+            fclose(out);
+        }
+    }
+
+    free(ctx.coeffs);
+    free(ctx.results);
+    free(src);
+
+    return ret;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <errno.h>
+
+/*
+ * Converts the bit-vector ROM constants of a VHDL package (e.g.
+ * src/pp_fcn_rom_pkg.vhd) into a C header.
+ *
+ * Every `constant <NAME> : <type> := ( "0101...", ... );` block with
+ * bit-string elements is emitted as
+ *
+ *   #define <NAME>_LENGTH <number of entries>
+ *   #define <NAME>_WIDTH  <bits per entry>
+ *   static const uint64_t <NAME>[<NAME>_LENGTH][2] = { { lo, hi }, ... };
+ *
+ * where lo holds bits 63..0 and hi bits 127..64 of each vector, so that
+ * fields can be sliced in C exactly like in the VHDL source.
+ */
+
+#define MAX_WIDTH 128
+
+typedef struct rom_t {
+    char name[128];
+    size_t n;
+    size_t cap;
+    int width;
+    uint64_t (*data)[2];
+} rom_t;
+
+static int parse_bits(const char *s, int len, uint64_t out[2]) {
+    out[0] = 0;
+    out[1] = 0;
+
+    for (int i = 0; i < len; i++) {
+        int bit = len - 1 - i;
+        if (s[i] != '0' && s[i] != '1')
+            return -1;
+        if (s[i] == '1')
+            out[bit / 64] |= UINT64_C(1) << (bit % 64);
+    }
+    return 0;
+}
+
+static void rom_append(rom_t *rom, const uint64_t v[2]) {
+    if (rom->n == rom->cap) {
+        rom->cap = rom->cap ? 2 * rom->cap : 256;
+        rom->data = realloc(rom->data, rom->cap * sizeof(*rom->data));
+    }
+    rom->data[rom->n][0] = v[0];
+    rom->data[rom->n][1] = v[1];
+    rom->n++;
+}
+
+static void rom_emit(FILE *out, const rom_t *rom) {
+    fprintf(out, "#define %s_LENGTH %zu\n", rom->name, rom->n);
+    fprintf(out, "#define %s_WIDTH %d\n\n", rom->name, rom->width);
+    fprintf(out, "static const uint64_t %s[%s_LENGTH][2] = {\n", rom->name, rom->name);
+    for (size_t i = 0; i < rom->n; i++)
+        fprintf(out, "    { 0x%016lxUL, 0x%016lxUL }%s\n",
+                rom->data[i][0], rom->data[i][1], i + 1 < rom->n ? "," : "");
+    fprintf(out, "};\n\n");
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "%s: Not enough arguments!\n", argv[0]);
+        fprintf(stderr, "Usage: %s <ROM_PKG.VHD> <OUT.H>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *in = fopen(argv[1], "r");
+    if (!in) {
+        fprintf(stderr, "%s: Failed to open input file: %s\n", argv[0], strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out) {
+        fprintf(stderr, "%s: Failed to open output file: %s\n", argv[0], strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    fprintf(out, "/* Generated from %s - do not edit! */\n", argv[1]);
+    fprintf(out, "#ifndef H_PP_FCN_ROM\n#define H_PP_FCN_ROM\n\n#include <stdint.h>\n\n");
+
+    char *line = NULL;
+    size_t line_n = 0;
+    size_t line_idx = 0;
+    rom_t rom = { 0 };
+    int in_rom = 0;
+    int roms = 0;
+
+    while (getline(&line, &line_n, in) != -1) {
+        line_idx++;
+
+        char *p = line;
+        while (isspace((unsigned char) *p))
+            p++;
+
+        if (!in_rom) {
+            char name[128];
+            if (sscanf(p, "constant %127[A-Za-z0-9_] :", name) == 1 && strstr(p, ":= (")) {
+                strcpy(rom.name, name);
+                rom.n = 0;
+                rom.width = 0;
+                in_rom = 1;
+            }
+            continue;
+        }
+
+        if (*p == '"') {
+            char *end = strchr(p + 1, '"');
+            int len = end ? (int)(end - p - 1) : -1;
+            uint64_t v[2];
+
+            if (len <= 0 || len > MAX_WIDTH || parse_bits(p + 1, len, v)) {
+                fprintf(stderr, "%s: Malformed bit vector in line %zu\n", argv[0], line_idx);
+                return EXIT_FAILURE;
+            }
+
+            if (rom.width == 0)
+                rom.width = len;
+            else if (rom.width != len) {
+                fprintf(stderr, "%s: Inconsistent vector width in line %zu\n", argv[0], line_idx);
+                return EXIT_FAILURE;
+            }
+
+            rom_append(&rom, v);
+        } else if (*p == ')') {
+            if (rom.n > 0) {
+                rom_emit(out, &rom);
+                roms++;
+            }
+            in_rom = 0;
+        }
+    }
+
+    fprintf(out, "#endif\n");
+
+    free(line);
+    free(rom.data);
+    fclose(in);
+    fclose(out);
+
+    if (roms == 0) {
+        fprintf(stderr, "%s: No ROM constants found in %s\n", argv[0], argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "xoroshiro128plus.h"
+
+/*
+ * Regenerates the xoro_seeds package in src/xoroshiro128plus.vhd and a
+ * matching C header.
+ *
+ * Seed i is the state of seed 0 advanced by i * 2^STRIDE steps, so the
+ * instances of grng_16 run on non-overlapping substreams. The package is
+ * replaced in place, everything outside of `package xoro_seeds is` ...
+ * `end package;` is kept. The header contains
+ *
+ *   #define XORO_SEEDS_LENGTH <COUNT>
+ *   #define XORO_SEEDS_STRIDE_LOG2 <STRIDE>
+ *   static const uint64_t XORO_SEEDS[XORO_SEEDS_LENGTH][2] = { { s[0], s[1] }, ... };
+ *
+ * i.e. copying XORO_SEEDS[i] into xoroshiro128plus_t.s reproduces the output
+ * of the VHDL instance with seed index i from its first cycle after reset.
+ */
+
+#define PKG_BEGIN "package xoro_seeds is"
+#define PKG_END "end package;"
+
+// State of seed 0 in the original package, seed_0 = s[0], seed_1 = s[1]
+#define DEFAULT_S0 0x86114fc94d6c4ad5UL
+#define DEFAULT_S1 0x1976c51ab89a5886UL
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-s S0:S1] [-k STRIDE] <COUNT> <XOROSHIRO128PLUS.VHD> <OUT.H>\n", prog);
+    fprintf(stderr, "  -s S0:S1   State of seed 0 (hex), default %016lx:%016lx\n", DEFAULT_S0, DEFAULT_S1);
+    fprintf(stderr, "  -k STRIDE  Distance between seeds is 2^STRIDE steps, default 64\n");
+}
+
+static char *read_file(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return NULL;
+
+    size_t n = 0, cap = 4096;
+    char *buf = malloc(cap);
+    size_t r;
+    while ((r = fread(buf + n, 1, cap - n - 1, f)) > 0) {
+        n += r;
+        if (n + 1 == cap)
+            buf = realloc(buf, cap *= 2);
+    }
+    buf[n] = 0;
+
+    fclose(f);
+    return buf;
+}
+
+static void emit_package(FILE *out, const uint64_t (*seeds)[2], size_t count) {
+    fprintf(out, PKG_BEGIN "\n");
+    fprintf(out, "    type xoro_seed_t is array(1 downto 0) of unsigned(63 downto 0);\n");
+    fprintf(out, "    type xoro_seeds_t is array(0 to %zu) of xoro_seed_t;\n", count - 1);
+
+    // A positional aggregate needs at least two elements
+    if (count == 1) {
+        fprintf(out, "    constant xoro_seeds : xoro_seeds_t := (0 => (X\"%016lx\", X\"%016lx\"));\n",
+                seeds[0][1], seeds[0][0]);
+    } else {
+        for (size_t i = 0; i < count; i++)
+            fprintf(out, "%s(X\"%016lx\", X\"%016lx\")%s\n",
+                    i ? "        " : "    constant xoro_seeds : xoro_seeds_t := (",
+                    seeds[i][1], seeds[i][0], i + 1 < count ? "," : ");");
+    }
+
+    fprintf(out, PKG_END);
+}
+
+static void emit_header(FILE *out, const uint64_t (*seeds)[2], size_t count, unsigned stride) {
+    fprintf(out, "/* Generated by xoro_seeds - do not edit! */\n");
+    fprintf(out, "#ifndef H_XORO_SEEDS\n#define H_XORO_SEEDS\n\n#include <stdint.h>\n\n");
+    fprintf(out, "/*\n");
+    fprintf(out, " * Initial states of the xoroshiro128plus instances in src/xoroshiro128plus.vhd,\n");
+    fprintf(out, " * { s[0], s[1] } = { seed_0, seed_1 }. Seed i is seed 0 advanced by i * 2^%u steps.\n", stride);
+    fprintf(out, " */\n");
+    fprintf(out, "#define XORO_SEEDS_LENGTH %zu\n", count);
+    fprintf(out, "#define XORO_SEEDS_STRIDE_LOG2 %u\n\n", stride);
+    fprintf(out, "static const uint64_t XORO_SEEDS[XORO_SEEDS_LENGTH][2] = {\n");
+    for (size_t i = 0; i < count; i++)
+        fprintf(out, "    { 0x%016lxUL, 0x%016lxUL }%s\n", seeds[i][0], seeds[i][1], i + 1 < count ? "," : "");
+    fprintf(out, "};\n\n#endif\n");
+}
+
+int main(int argc, char *argv[]) {
+    xoroshiro128plus_t xoro = { .s = { DEFAULT_S0, DEFAULT_S1 } };
+    unsigned stride = 64;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:k:")) != -1) {
+        switch (opt) {
+        case 's':
+            if (sscanf(optarg, "%lx:%lx", &xoro.s[0], &xoro.s[1]) != 2 || !(xoro.s[0] | xoro.s[1])) {
+                fprintf(stderr, "%s: Invalid state \"%s\"!\n", argv[0], optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'k':
+            if (sscanf(optarg, "%u", &stride) != 1 || stride > 127) {
+                fprintf(stderr, "%s: Invalid stride \"%s\"!\n", argv[0], optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind < 3) {
+        fprintf(stderr, "%s: Not enough arguments!\n", argv[0]);
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *vhd_path = argv[optind + 1];
+    const char *h_path = argv[optind + 2];
+
+    size_t count;
+    if (sscanf(argv[optind], "%zu", &count) != 1 || count == 0) {
+        fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as count!\n", argv[0], argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    char *vhd = read_file(vhd_path);
+    if (!vhd) {
+        fprintf(stderr, "%s: Failed to open input file: %s\n", argv[0], strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    char *begin = strstr(vhd, PKG_BEGIN);
+    char *end = begin ? strstr(begin, PKG_END) : NULL;
+    if (!end) {
+        fprintf(stderr, "%s: No xoro_seeds package found in %s\n", argv[0], vhd_path);
+        return EXIT_FAILURE;
+    }
+    *begin = 0;
+    end += strlen(PKG_END);
+
+    uint64_t (*seeds)[2] = malloc(count * sizeof(*seeds));
+    for (size_t i = 0; i < count; i++) {
+        seeds[i][0] = xoro.s[0];
+        seeds[i][1] = xoro.s[1];
+        xoroshiro128plus_jump_pow2(&xoro, stride);
+    }
+
+    FILE *out = fopen(vhd_path, "w");
+    if (!out) {
+        fprintf(stderr, "%s: Failed to open output file: %s\n", argv[0], strerror(errno));
+        return EXIT_FAILURE;
+    }
+    fputs(vhd, out);
+    emit_package(out, seeds, count);
+    fputs(end, out);
+    fclose(out);
+
+    out = fopen(h_path, "w");
+    if (!out) {
+        fprintf(stderr, "%s: Failed to open output file: %s\n", argv[0], strerror(errno));
+        return EXIT_FAILURE;
+    }
+    emit_header(out, seeds, count, stride);
+    fclose(out);
+
+    free(seeds);
+    free(vhd);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "golden.h"
+
+#include "bench.h"
+
+/*
+ * Throughput of the golden model, per sample: golden_libm against golden_eval
+ * for each instruction set, on every u_1, every lzd(u_0) and random u_2. Their
+ * accuracy is checked by test/test_golden.c.
+ */
+
+#define SAMPLES (1 << 16)
+
+typedef struct golden_case_t {
+    uint64_t u[3][SAMPLES];
+    double x_0[SAMPLES];
+    double x_1[SAMPLES];
+    double e[SAMPLES];
+} golden_case_t;
+
+typedef struct isa_case_t {
+    golden_case_t *c;
+    golden_isa_t isa;
+} isa_case_t;
+
+static uint64_t next_rand(uint64_t *x) {
+    // splitmix64
+    uint64_t z = (*x += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+// Every u_1, u_0 with each lzd from 0 to 48, random u_2 with the extremes
+static void fill_case(golden_case_t *c) {
+    uint64_t seed = 1;
+
+    for (size_t i = 0; i < SAMPLES; i++) {
+        int lzd = i % 49;
+        c->u[0][i] = lzd == 48 ? 0 : (1ull << (47 - lzd)) | (next_rand(&seed) & ((1ull << (47 - lzd)) - 1));
+        c->u[1][i] = i;
+        c->u[2][i] = i < 2 ? i * 0x7FFFFFFF : next_rand(&seed) & 0x7FFFFFFF;
+    }
+}
+
+static void bench_golden_libm(void *arg, uint64_t ops) {
+    golden_case_t *c = arg;
+    double x[2], e, sum = 0;
+
+    for (uint64_t i = 0; i < ops; i++) {
+        size_t j = i % SAMPLES;
+        golden_libm(c->u[0][j], c->u[1][j], c->u[2][j], x, &e);
+        sum += x[0] + x[1] + e;
+    }
+
+    bench_sink ^= (uint64_t) sum;
+}
+
+static void bench_golden_eval(void *arg, uint64_t ops) {
+    isa_case_t *b = arg;
+    golden_case_t *c = b->c;
+
+    golden_set_isa(b->isa);
+    for (uint64_t i = 0; i < ops; i += GOLDEN_BATCH) {
+        size_t j = i % SAMPLES;
+        size_t n = ops - i < GOLDEN_BATCH ? ops - i : GOLDEN_BATCH;
+        golden_eval(n, c->u[0] + j, c->u[1] + j, c->u[2] + j, c->x_0 + j, c->x_1 + j, c->e + j);
+    }
+
+    bench_sink ^= (uint64_t) c->e[0];
+}
+
+int main(int argc, char *argv[]) {
+    golden_case_t *c = malloc(sizeof(golden_case_t));
+
+    fill_case(c);
+
+    isa_case_t scalar_case = { c, GOLDEN_ISA_SCALAR };
+    isa_case_t avx2_case = { c, GOLDEN_ISA_AVX2 };
+
+    bench_case_t cases[3] = {
+        { "golden_libm", bench_golden_libm, c, 0 },
+        { "golden_eval/scalar", bench_golden_eval, &scalar_case, 0 },
+    };
+    size_t n = 2;
+    if (golden_set_isa(GOLDEN_ISA_AVX2))
+        cases[n++] = (bench_case_t) { "golden_eval/avx2", bench_golden_eval, &avx2_case, 0 };
+
+    int ret = bench_main(argc, argv, "verification", cases, n);
+
+    free(c);
+    return ret;
+}
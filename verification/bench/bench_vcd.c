@@ -0,0 +1,327 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+
+#include "vcd.h"
+
+#include "bench.h"
+
+/*
+ * Throughput of the vcd parser on a synthetic trace of the boxmuller test
+ * bench: the five signals verify_trace reads plus a clock, all changing in
+ * every timeslot, like in the dumps of the simulation. The "wide" trace has
+ * WIDE_SIGNALS signals with identifiers of up to three characters, of which
+ * one in eight changes per timeslot.
+ */
+
+#define TIMESLOTS (1 << 17)
+#define WIDE_TIMESLOTS 2048
+#define WIDE_SIGNALS 10000
+#define HISTORY_LOG 6
+
+typedef struct signal_def_t {
+    const char *name;
+    int width;
+    char symbol;
+} signal_def_t;
+
+static const signal_def_t SIGNALS[] = {
+    { "clk", 1, '!' },
+    { "r_i_u_0", 48, '"' },
+    { "r_i_u_1", 16, '#' },
+    { "r_i_u_2", 31, '$' },
+    { "t_x_0", 16, '%' },
+    { "t_x_1", 16, '&' },
+};
+
+#define N_SIGNALS (sizeof(SIGNALS) / sizeof(SIGNALS[0]))
+
+typedef struct vcd_case_t {
+    char path[64];
+    size_t body_bytes;
+    size_t body_lines;
+    char **lines;       // body, for vcd_parse_body_line
+    vcd_t *vcd;         // vcd_parse_body_line
+} vcd_case_t;
+
+typedef struct backend_case_t {
+    const vcd_case_t *c;
+    vcd_backend_t backend;
+    vcd_t *vcd;         // vcd_next, reopened at the end of the file
+    int filtered;       // if > 0, watch this many signals and filter the rest, like verify_trace
+} backend_case_t;
+
+static uint64_t next_rand(uint64_t *x) {
+    // splitmix64
+    uint64_t z = (*x += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+static FILE *create_vcd(vcd_case_t *c) {
+    strcpy(c->path, "/tmp/bench_vcd_XXXXXX");
+    int fd = mkstemp(c->path);
+    return fd < 0 ? NULL : fdopen(fd, "w");
+}
+
+static void write_bits(FILE *f, uint64_t v, int width) {
+    char bits[65];
+    for (int j = 0; j < width; j++)
+        bits[j] = '0' + ((v >> (width - 1 - j)) & 1);
+    bits[width] = '\0';
+    fputs(bits, f);
+}
+
+static bool write_vcd(vcd_case_t *c) {
+    FILE *f = create_vcd(c);
+    if (!f)
+        return false;
+
+    fprintf(f, "$date\n  Sat Jan  1 00:00:00 2000\n$end\n");
+    fprintf(f, "$version\n  bench_vcd\n$end\n");
+    fprintf(f, "$timescale\n  1 fs\n$end\n");
+    fprintf(f, "$scope module boxmuller_tb $end\n");
+    for (size_t i = 0; i < N_SIGNALS; i++)
+        fprintf(f, "$var wire %d %c %s $end\n", SIGNALS[i].width, SIGNALS[i].symbol, SIGNALS[i].name);
+    fprintf(f, "$upscope $end\n");
+    fprintf(f, "$enddefinitions $end\n");
+
+    long body = ftell(f);
+    uint64_t seed = 0x0123456789abcdef;
+
+    c->body_lines = 0;
+    for (size_t t = 0; t < TIMESLOTS; t++) {
+        fprintf(f, "#%lu\n", t * 5000000);
+        fprintf(f, "%d%c\n", (int)(t & 1), SIGNALS[0].symbol);
+        c->body_lines += 2;
+
+        for (size_t i = 1; i < N_SIGNALS; i++) {
+            fputc('b', f);
+            write_bits(f, next_rand(&seed), SIGNALS[i].width);
+            fprintf(f, " %c\n", SIGNALS[i].symbol);
+            c->body_lines++;
+        }
+    }
+
+    c->body_bytes = ftell(f) - body;
+    return !fclose(f);
+}
+
+// Identifier i, in base 94 with the least significant digit first
+static void wide_id(size_t i, char *id) {
+    size_t len = 1;
+    for (size_t n = 94; i >= n; n *= 94) {
+        i -= n;
+        len++;
+    }
+    for (size_t j = 0; j < len; j++, i /= 94)
+        id[j] = '!' + i % 94;
+    id[len] = '\0';
+}
+
+static int wide_width(size_t i) {
+    static const int widths[] = { 1, 1, 16, 31, 48, 64 };
+    return widths[i % (sizeof(widths) / sizeof(widths[0]))];
+}
+
+static bool write_wide_vcd(vcd_case_t *c) {
+    FILE *f = create_vcd(c);
+    if (!f)
+        return false;
+
+    char id[8];
+    fprintf(f, "$timescale\n  1 fs\n$end\n");
+    fprintf(f, "$scope module grng_16_tb $end\n");
+    for (size_t i = 0; i < WIDE_SIGNALS; i++) {
+        wide_id(i, id);
+        fprintf(f, "$var wire %d %s s_%lu $end\n", wide_width(i), id, i);
+    }
+    fprintf(f, "$upscope $end\n");
+    fprintf(f, "$enddefinitions $end\n");
+
+    long body = ftell(f);
+    uint64_t seed = 0xfedcba9876543210;
+
+    c->body_lines = 0;
+    for (size_t t = 0; t < WIDE_TIMESLOTS; t++) {
+        fprintf(f, "#%lu\n", t * 5000000);
+        c->body_lines++;
+
+        for (size_t i = 0; i < WIDE_SIGNALS; i++) {
+            uint64_t v = next_rand(&seed);
+            if (v & 7)
+                continue;
+
+            wide_id(i, id);
+            if (wide_width(i) == 1) {
+                fprintf(f, "%d%s\n", (int)(v >> 63), id);
+            } else {
+                fputc('b', f);
+                write_bits(f, v >> 3, wide_width(i));
+                fprintf(f, " %s\n", id);
+            }
+            c->body_lines++;
+        }
+    }
+
+    c->body_bytes = ftell(f) - body;
+    return !fclose(f);
+}
+
+static bool load_lines(vcd_case_t *c) {
+    FILE *f = fopen(c->path, "r");
+    if (!f)
+        return false;
+
+    // Skip the header, keep the body
+    char *line = NULL;
+    size_t line_n = 0;
+    while (getline(&line, &line_n, f) != -1 && strncmp(line, "$enddefinitions", 15))
+        ;
+
+    c->lines = calloc(c->body_lines, sizeof(char *));
+    for (size_t i = 0; i < c->body_lines && getline(&line, &line_n, f) != -1; i++)
+        c->lines[i] = strdup(line);
+
+    free(line);
+    fclose(f);
+    return true;
+}
+
+static vcd_t *open_vcd(const vcd_case_t *c, vcd_backend_t backend) {
+    vcd_t *vcd = vcd_open_backend((char *) c->path, HISTORY_LOG, backend);
+    if (vcd)
+        vcd_parse_header(vcd);
+    return vcd;
+}
+
+static vcd_t *open_backend_case(const backend_case_t *b) {
+    vcd_t *vcd = open_vcd(b->c, b->backend);
+    if (vcd && b->filtered) {
+        for (int i = 0; i < b->filtered && i < vcd->signal_count; i++)
+            vcd_watch(vcd, &vcd->signals[i * (vcd->signal_count / b->filtered)]);
+        vcd_filter(vcd, true);
+    }
+    return vcd;
+}
+
+static void bench_vcd_parse_body_line(void *arg, uint64_t ops) {
+    vcd_case_t *c = arg;
+    vcd_t *vcd = c->vcd;
+    char *line_buffer = vcd->line_buffer;
+
+    for (uint64_t i = 0; i < ops; i++) {
+        vcd->line_buffer = c->lines[i % c->body_lines];
+        vcd_parse_body_line(vcd);
+    }
+
+    bench_sink ^= vcd->signals[0].data[vcd_get_data_idx(vcd, 0)];
+    vcd->line_buffer = line_buffer;
+}
+
+static void bench_vcd_next(void *arg, uint64_t ops) {
+    backend_case_t *b = arg;
+
+    for (uint64_t i = 0; i < ops; i++) {
+        if (!b->vcd || !vcd_has_next(b->vcd)) {
+            if (b->vcd)
+                vcd_close(b->vcd);
+            b->vcd = open_backend_case(b);
+        }
+        vcd_next(b->vcd);
+    }
+
+    bench_sink ^= b->vcd->signals[0].data[vcd_get_data_idx(b->vcd, 0)];
+}
+
+static void bench_vcd_file(void *arg, uint64_t ops) {
+    backend_case_t *b = arg;
+
+    for (uint64_t i = 0; i < ops; i++) {
+        vcd_t *vcd = open_backend_case(b);
+        while (vcd_has_next(vcd))
+            vcd_next(vcd);
+        bench_sink ^= vcd->time;
+        vcd_close(vcd);
+    }
+}
+
+// Lower bound for the parser: counting the lines of the mapped file
+static void bench_memchr(void *arg, uint64_t ops) {
+    const vcd_case_t *c = arg;
+    int fd = open(c->path, O_RDONLY);
+    size_t size = lseek(fd, 0, SEEK_END);
+    const char *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return;
+
+    uint64_t lines = 0;
+    for (uint64_t i = 0; i < ops; i++) {
+        for (const char *p = map, *end = map + size; (p = memchr(p, '\n', end - p)); p++)
+            lines++;
+    }
+
+    bench_sink ^= lines;
+    munmap((void *) map, size);
+}
+
+int main(int argc, char *argv[]) {
+    vcd_case_t c, wide = { 0 };
+
+    if (!write_vcd(&c) || !load_lines(&c) || !write_wide_vcd(&wide)) {
+        perror("Failed to write synthetic vcd");
+        return EXIT_FAILURE;
+    }
+
+    c.vcd = open_vcd(&c, VCD_BACKEND_STDIO);
+    if (!c.vcd) {
+        perror(c.path);
+        return EXIT_FAILURE;
+    }
+
+    backend_case_t stdio_case = { &c, VCD_BACKEND_STDIO, NULL, 0 };
+    backend_case_t mmap_case = { &c, VCD_BACKEND_MMAP, NULL, 0 };
+    backend_case_t wide_case = { &wide, VCD_BACKEND_MMAP, NULL, 0 };
+    backend_case_t filtered_case = { &wide, VCD_BACKEND_MMAP, NULL, 5 };
+
+    double line_bytes = (double) c.body_bytes / c.body_lines;
+    double slot_bytes = (double) c.body_bytes / TIMESLOTS;
+
+    const bench_case_t cases[] = {
+        { "vcd_parse_body_line", bench_vcd_parse_body_line, &c, line_bytes },
+        { "vcd_next/stdio", bench_vcd_next, &stdio_case, slot_bytes },
+        { "vcd_next/mmap", bench_vcd_next, &mmap_case, slot_bytes },
+        { "vcd_file/stdio", bench_vcd_file, &stdio_case, c.body_bytes },
+        { "vcd_file/mmap", bench_vcd_file, &mmap_case, c.body_bytes },
+        { "vcd_file/mmap/10k_signals", bench_vcd_file, &wide_case, wide.body_bytes },
+        { "vcd_file/mmap/10k_signals/filtered", bench_vcd_file, &filtered_case, wide.body_bytes },
+        { "memchr", bench_memchr, &c, c.body_bytes },
+    };
+
+    fprintf(stderr, "synthetic vcd: %d timeslots, %lu lines, %.1f MB\n", TIMESLOTS, c.body_lines, c.body_bytes * 1e-6);
+    fprintf(stderr, "wide synthetic vcd: %d signals, %d timeslots, %lu lines, %.1f MB\n", WIDE_SIGNALS,
+            WIDE_TIMESLOTS, wide.body_lines, wide.body_bytes * 1e-6);
+
+    int ret = bench_main(argc, argv, "verification", cases, sizeof(cases) / sizeof(cases[0]));
+
+    vcd_close(c.vcd);
+    if (stdio_case.vcd)
+        vcd_close(stdio_case.vcd);
+    if (mmap_case.vcd)
+        vcd_close(mmap_case.vcd);
+    for (size_t i = 0; i < c.body_lines; i++)
+        free(c.lines[i]);
+    free(c.lines);
+    unlink(c.path);
+    unlink(wide.path);
+
+    return ret;
+}
@@ -0,0 +1,132 @@
+#ifndef HEADER_TRACE
+#define HEADER_TRACE
+
+/*
+ * Columnar binary traces, converted once from a VCD (see main/vcd2trace) and
+ * mapped without any parsing afterwards.
+ *
+ * Timeslot t is the t-th call of vcd_next on the source VCD. All integers are
+ * in the byte order of the host that wrote the file, since readers use the
+ * mapped columns as they are. Traces are therefore not portable between
+ * hosts of different endianness; the version field does not match on the
+ * other one, so trace_open rejects such files. Columns start at 64 byte
+ * boundaries:
+ *
+ *   0           trace_header_t
+ *   time_offset uint64_t time[timeslots]
+ *   ...         per signal: values[timeslots], 1, 2, 4 or 8 bytes each by
+ *               width, and the valid bitmap, bit t % 8 of byte t / 8
+ *   dir_offset  uint32_t count, then count trace_dir_entry_t, each followed
+ *               by its name and padded to 8 bytes
+ *
+ * Signals are appended by writing their columns and a new directory behind
+ * the current one, and then pointing the header at it. Readers of older
+ * versions of the file simply see fewer signals.
+ */
+
+#define TRACE_MAGIC "VCDTRACE"
+#define TRACE_VERSION 1
+#define TRACE_ALIGN 64
+
+typedef struct trace_header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t timeslots;
+    uint64_t time_offset;
+    uint64_t dir_offset;
+    uint64_t dir_size;
+    uint64_t pad[2];
+} trace_header_t;
+
+typedef struct trace_dir_entry_t {
+    uint64_t values_offset;
+    uint64_t valid_offset;
+    uint32_t width;
+    uint32_t name_len;
+} trace_dir_entry_t;
+
+typedef struct trace_signal_t {
+    char *name;             // path in the VCD
+    int width;
+    int bytes;              // per value
+    const void *values;
+    const uint8_t *valid;
+} trace_signal_t;
+
+typedef struct trace_t {
+    const uint8_t *map;
+    size_t size;
+    uint64_t timeslots;
+    const uint64_t *time;
+    int signal_count;
+    trace_signal_t *signals;
+} trace_t;
+
+/*
+ * Whether path is a regular file starting with TRACE_MAGIC
+ */
+bool trace_probe(const char *path);
+
+/*
+ * Returns NULL on failure, with errno set (EINVAL for malformed files)
+ */
+trace_t *trace_open(const char *path);
+
+void trace_close(trace_t *trace);
+
+/*
+ * Finds a signal by its path, or else by its name, like vcd_get_signal_by_name
+ */
+trace_signal_t *trace_get_signal(trace_t *trace, const char *name);
+
+static inline uint64_t trace_value(const trace_signal_t *signal, uint64_t t) {
+    switch (signal->bytes) {
+        case 1:
+            return ((const uint8_t *) signal->values)[t];
+        case 2:
+            return ((const uint16_t *) signal->values)[t];
+        case 4:
+            return ((const uint32_t *) signal->values)[t];
+        default:
+            return ((const uint64_t *) signal->values)[t];
+    }
+}
+
+static inline bool trace_valid(const trace_signal_t *signal, uint64_t t) {
+    return (signal->valid[t >> 3] >> (t & 7)) & 1;
+}
+
+/*
+ * Writing: trace_writer_open creates a trace, or, with append, opens an
+ * existing one with the same number of timeslots. Columns are added with
+ * trace_writer_add, then trace_writer_map maps them for the set functions.
+ * trace_writer_close writes the directory and publishes the new signals.
+ */
+typedef struct trace_writer_t trace_writer_t;
+
+trace_writer_t *trace_writer_open(const char *path, uint64_t timeslots, bool append);
+
+/*
+ * Returns the column index of the new signal
+ */
+int trace_writer_add(trace_writer_t *w, const char *name, int width);
+
+bool trace_writer_map(trace_writer_t *w);
+
+void trace_writer_set_time(trace_writer_t *w, uint64_t t, uint64_t time);
+
+void trace_writer_set(trace_writer_t *w, int column, uint64_t t, uint64_t value, bool valid);
+
+/*
+ * Returns false if the trace could not be completed, the file is then left
+ * as it was before trace_writer_open (append) or invalid (create)
+ */
+bool trace_writer_close(trace_writer_t *w);
+
+/*
+ * Discards the new signals, an appended trace keeps its old ones
+ */
+void trace_writer_abort(trace_writer_t *w);
+
+#endif
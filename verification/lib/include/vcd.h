@@ -11,22 +11,67 @@ typedef enum vcd_state_t {
     BODY
 } vcd_state_t;
 
+/*
+ * VCD_BACKEND_STDIO reads the file line by line and works on any stream,
+ * VCD_BACKEND_MMAP maps the whole file and scans the body in place.
+ * VCD_BACKEND_FOLLOW reads like stdio a file that is still being written,
+ * see vcd_follow.
+ */
+typedef enum vcd_backend_t {
+    VCD_BACKEND_STDIO,
+    VCD_BACKEND_MMAP,
+    VCD_BACKEND_FOLLOW
+} vcd_backend_t;
+
+// Follow backend: default idle timeout, and the poll interval without inotify
+#define VCD_FOLLOW_IDLE_MS 10000
+#define VCD_FOLLOW_POLL_MS 100
+
+/*
+ * Signals are stored in declaration order. data/valid are rings of
+ * history_length timeslots, indexed by vcd_get_data_idx. They are written in
+ * every timeslot with a change of the signal, and, for watched signals (see
+ * vcd_watch), also carried forward through timeslots without one.
+ */
 typedef struct vcd_signal_t {
     char *name;
-    char symbol;
+    char *path;         // scopes and name, separated by '.'
+    char *id;           // VCD identifier code
     int width;
-    void *next;
+    int alias;          // next signal with the same id, or -1
+    bool watched;
     bool *valid;
     uint64_t *data;
-    bool processed;
+    ssize_t timeslot;   // of the last change
 } vcd_signal_t;
 
+/*
+ * Identifier lookup. Dumpers number their identifiers in base 94, so if they
+ * are short and dense, their value indexes a table directly; any other set of
+ * identifiers goes through an open addressing hash table.
+ */
+#define VCD_RADIX_MAX_LEN 4
+
+typedef struct vcd_index_t {
+    int32_t *radix;         // first signal of each id value, or -1
+    size_t radix_size;
+    bool radix_msb_first;   // whether the first character is the most significant digit
+
+    int32_t *hash;          // first signal of each id, or -1
+    size_t hash_mask;
+} vcd_index_t;
+
 typedef struct vcd_t {
     vcd_state_t state;
     vcd_signal_t *signals;
     int signal_count;
-    char lowest_symbol;
-    char highest_symbol;
+    int signal_cap;
+    vcd_index_t index;
+    int *watched;           // indices of the watched signals
+    int watched_count;
+    bool filter;            // see vcd_filter
+    uint64_t *subscribed;   // bitmap over the first signal of each id, set if any of its aliases is watched
+    char *scope;
     char *version;
     char *timescale;
     char *date;
@@ -37,20 +82,94 @@ typedef struct vcd_t {
     ssize_t history_length_mask;
     ssize_t timeslot_idx;
 
-    FILE *source;
-    char *line_buffer;
+    vcd_backend_t backend;
+    FILE *source;           // VCD_BACKEND_STDIO
+    const char *map;        // VCD_BACKEND_MMAP
+    size_t map_size;
+    const char *body;       // VCD_BACKEND_MMAP, first line after the header
+    const char *line;       // VCD_BACKEND_MMAP, current line in map
+    const char *end;        // VCD_BACKEND_MMAP, parsing stops here
+    bool eof;
+
+    int follow_fd;          // VCD_BACKEND_FOLLOW, inotify instance, or -1 to poll
+    int follow_idle_ms;
+    int64_t follow_last;    // ms, monotonic, when data was last read
+    bool follow_closed;     // the writer closed the file
+    bool (*on_wait)(void *arg);
+    void *on_wait_arg;
+    char *follow_buffer;    // continuation of a partial line
+    size_t follow_n;
+
+    const struct vcd_t *parent; // see vcd_fork
+
+    char *line_buffer;      // current line, for the header and VCD_BACKEND_STDIO
     size_t line_n;
     size_t line_idx;
 
     uint64_t time;
 } vcd_t;
 
+/*
+ * Opens file with the mmap backend if it is a regular file, with the stdio
+ * backend otherwise (e.g. pipes)
+ */
 vcd_t *vcd_open(char *file, size_t history_length_log);
 
+vcd_t *vcd_open_backend(char *file, size_t history_length_log, vcd_backend_t backend);
+
 void vcd_close(vcd_t *vcd);
 
+/*
+ * Settings of the follow backend. At the end of the data, it waits for the
+ * file to grow (inotify, or polling every VCD_FOLLOW_POLL_MS) instead of
+ * ending, and only returns complete lines. The dump ends once the writer
+ * closed the file and everything is read, or after idle_ms without new data.
+ * Before every wait, on_wait (may be NULL) is called with arg, returning
+ * false ends the dump as well.
+ */
+void vcd_follow(vcd_t *vcd, int idle_ms, bool (*on_wait)(void *arg), void *arg);
+
+/*
+ * Independent cursor into the body of a mmap backed vcd, for parsing parts
+ * of the file concurrently. The fork shares the mapping, the declarations and
+ * the index with vcd, which must outlive it, but has its own history rings.
+ * Watched signals stay watched. Returns NULL for the stdio backend.
+ */
+vcd_t *vcd_fork(const vcd_t *vcd);
+
+/*
+ * Parses [begin, end) of the mapped body from now on, begin should be the
+ * start of a timestamp line. All history is cleared.
+ */
+void vcd_seek(vcd_t *vcd, const char *begin, const char *end);
+
+/*
+ * Start of the first timestamp line at or after p, or the end of the file
+ */
+const char *vcd_find_timeslot(const vcd_t *vcd, const char *p);
+
+/*
+ * Start of the n-th timestamp line before p, or the start of the body
+ */
+const char *vcd_rewind_timeslots(const vcd_t *vcd, const char *p, size_t n);
+
 void vcd_parse_header(vcd_t *vcd);
 
+/*
+ * Applies the value change in vcd->line_buffer to the current timeslot
+ */
+void vcd_parse_body_line(vcd_t *vcd);
+
+/*
+ * Value of the vector digits from p on, up to a space, line break or end,
+ * returns the end of them. Any character but 0 and 1 invalidates the value.
+ * vcd_parse_vector_slow takes one digit at a time and is the reference of
+ * vcd_parse_vector, which gives the same results.
+ */
+const char *vcd_parse_vector(const char *p, const char *end, uint64_t *data, bool *valid);
+
+const char *vcd_parse_vector_slow(const char *p, const char *end, uint64_t *data, bool *valid);
+
 void vcd_next(vcd_t *vcd);
 
 void vcd_skip(vcd_t *vcd, size_t n);
@@ -59,6 +178,27 @@ size_t vcd_get_data_idx(vcd_t *vcd, ssize_t i);
 
 bool vcd_has_next(vcd_t *vcd);
 
+/*
+ * Finds a signal by its path, or else by its name, and watches it
+ */
 vcd_signal_t *vcd_get_signal_by_name(vcd_t *vcd, char *name);
 
+/*
+ * Signal with the given identifier code, NULL if there is none. With
+ * aliases, this is the first one declared.
+ */
+vcd_signal_t *vcd_get_signal_by_id(vcd_t *vcd, const char *id, size_t len);
+
+/*
+ * Keeps data/valid of the signal up to date in every timeslot
+ */
+void vcd_watch(vcd_t *vcd, vcd_signal_t *signal);
+
+/*
+ * With filter, only the changes of watched signals are applied, the others
+ * are dropped after the identifier lookup, and the data of unwatched signals
+ * goes stale. Forks inherit the setting.
+ */
+void vcd_filter(vcd_t *vcd, bool filter);
+
 #endif
@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "trace.h"
+
+#define ALIGN(x, a) (((x) + (a) - 1) & ~(uint64_t)((a) - 1))
+
+struct trace_writer_t {
+    int fd;
+    trace_header_t header;
+    uint8_t *map;
+    size_t size;
+    uint64_t end;               // end of the columns
+
+    int count, cap;
+    trace_dir_entry_t *entries;
+    char **names;
+};
+
+static int trace_bytes(int width) {
+    return width <= 8 ? 1 : width <= 16 ? 2 : width <= 32 ? 4 : 8;
+}
+
+static uint64_t trace_valid_size(uint64_t timeslots) {
+    return (timeslots + 7) / 8;
+}
+
+bool trace_probe(const char *path) {
+    // Reading from a pipe would consume the start of a VCD
+    struct stat st;
+    if (stat(path, &st) || !S_ISREG(st.st_mode))
+        return false;
+
+    char magic[8];
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    bool match = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && !memcmp(magic, TRACE_MAGIC, sizeof(magic));
+    fclose(f);
+    return match;
+}
+
+// Reads the directory at header->dir_offset of data[0, size)
+static bool trace_parse_dir(const uint8_t *data, size_t size, const trace_header_t *header, int *count,
+        trace_dir_entry_t **entries, char ***names) {
+    uint64_t p = header->dir_offset, end = header->dir_offset + header->dir_size;
+    if (!p || end > size || end < p || header->dir_size < sizeof(uint32_t))
+        return false;
+
+    uint32_t n;
+    memcpy(&n, data + p, sizeof(n));
+    p += sizeof(n);
+
+    *count = 0;
+    *entries = calloc(n ? n : 1, sizeof(trace_dir_entry_t));
+    *names = calloc(n ? n : 1, sizeof(char *));
+
+    uint64_t valid_size = trace_valid_size(header->timeslots);
+    for (uint32_t i = 0; i < n; i++) {
+        trace_dir_entry_t *e = &(*entries)[i];
+        if (end - p < sizeof(*e))
+            return false;
+        memcpy(e, data + p, sizeof(*e));
+        p += sizeof(*e);
+
+        // The padded name must fit as well, p would pass end otherwise
+        uint64_t values_size = header->timeslots * trace_bytes(e->width);
+        if (end - p < ALIGN(e->name_len, 8) || e->width < 1 || e->width > 64
+                || e->values_offset > size || size - e->values_offset < values_size
+                || e->valid_offset > size || size - e->valid_offset < valid_size)
+            return false;
+
+        (*names)[i] = strndup((const char *) data + p, e->name_len);
+        p += ALIGN(e->name_len, 8);
+        *count = i + 1;
+    }
+
+    return true;
+}
+
+static void trace_free_dir(int count, trace_dir_entry_t *entries, char **names) {
+    for (int i = 0; i < count; i++)
+        free(names[i]);
+    free(names);
+    free(entries);
+}
+
+trace_t *trace_open(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st)) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = st.st_size;
+    const uint8_t *map = size ? mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (map == MAP_FAILED) {
+        errno = size ? errno : EINVAL;
+        return NULL;
+    }
+
+    trace_header_t header;
+    int count = 0;
+    trace_dir_entry_t *entries = NULL;
+    char **names = NULL;
+
+    bool ok = size >= sizeof(header);
+    if (ok) {
+        memcpy(&header, map, sizeof(header));
+        ok = !memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) && header.version == TRACE_VERSION
+            && header.time_offset <= size && (size - header.time_offset) / sizeof(uint64_t) >= header.timeslots;
+    }
+    ok = ok && trace_parse_dir(map, size, &header, &count, &entries, &names);
+
+    if (!ok) {
+        trace_free_dir(count, entries, names);
+        munmap((void *) map, size);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    trace_t *trace = malloc(sizeof(trace_t));
+    trace->map = map;
+    trace->size = size;
+    trace->timeslots = header.timeslots;
+    trace->time = (const uint64_t *)(map + header.time_offset);
+    trace->signal_count = count;
+    trace->signals = calloc(count ? count : 1, sizeof(trace_signal_t));
+
+    for (int i = 0; i < count; i++) {
+        trace_signal_t *signal = &trace->signals[i];
+        signal->name = names[i];
+        signal->width = entries[i].width;
+        signal->bytes = trace_bytes(signal->width);
+        signal->values = map + entries[i].values_offset;
+        signal->valid = map + entries[i].valid_offset;
+    }
+
+    free(names);
+    free(entries);
+    return trace;
+}
+
+void trace_close(trace_t *trace) {
+    for (int i = 0; i < trace->signal_count; i++)
+        free(trace->signals[i].name);
+    free(trace->signals);
+    munmap((void *) trace->map, trace->size);
+    free(trace);
+}
+
+trace_signal_t *trace_get_signal(trace_t *trace, const char *name) {
+    for (int i = 0; i < trace->signal_count; i++)
+        if (!strcmp(trace->signals[i].name, name))
+            return &trace->signals[i];
+
+    // Names are the VCD paths, so fall back to the last component
+    for (int i = 0; i < trace->signal_count; i++) {
+        const char *dot = strrchr(trace->signals[i].name, '.');
+        if (dot && !strcmp(dot + 1, name))
+            return &trace->signals[i];
+    }
+    return NULL;
+}
+
+trace_writer_t *trace_writer_open(const char *path, uint64_t timeslots, bool append) {
+    int fd = open(path, append ? O_RDWR : O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return NULL;
+
+    trace_writer_t *w = calloc(1, sizeof(trace_writer_t));
+    w->fd = fd;
+
+    if (!append) {
+        trace_header_t header = {
+            .version = TRACE_VERSION,
+            .timeslots = timeslots,
+            .time_offset = ALIGN(sizeof(trace_header_t), TRACE_ALIGN),
+        };
+        memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+        w->header = header;
+        w->end = ALIGN(header.time_offset + timeslots * sizeof(uint64_t), TRACE_ALIGN);
+
+        // dir_offset stays 0, i.e. invalid, until trace_writer_close
+        if (pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+            close(fd);
+            free(w);
+            return NULL;
+        }
+        return w;
+    }
+
+    trace_t *trace = trace_open(path);
+    if (!trace || trace->timeslots != timeslots) {
+        if (trace)
+            trace_close(trace);
+        close(fd);
+        free(w);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    // Keep the existing directory, the new columns go behind it
+    memcpy(&w->header, trace->map, sizeof(w->header));
+    w->end = ALIGN(w->header.dir_offset + w->header.dir_size, TRACE_ALIGN);
+    trace_parse_dir(trace->map, trace->size, &w->header, &w->count, &w->entries, &w->names);
+    w->cap = w->count;
+    trace_close(trace);
+
+    return w;
+}
+
+int trace_writer_add(trace_writer_t *w, const char *name, int width) {
+    if (w->count == w->cap) {
+        w->cap = w->cap ? 2 * w->cap : 16;
+        w->entries = realloc(w->entries, sizeof(trace_dir_entry_t) * w->cap);
+        w->names = realloc(w->names, sizeof(char *) * w->cap);
+    }
+
+    trace_dir_entry_t *e = &w->entries[w->count];
+    e->width = width;
+    e->name_len = strlen(name);
+    e->values_offset = w->end;
+    w->end = ALIGN(w->end + w->header.timeslots * trace_bytes(width), TRACE_ALIGN);
+    e->valid_offset = w->end;
+    w->end = ALIGN(w->end + trace_valid_size(w->header.timeslots), TRACE_ALIGN);
+
+    w->names[w->count] = strdup(name);
+    return w->count++;
+}
+
+bool trace_writer_map(trace_writer_t *w) {
+    if (ftruncate(w->fd, w->end))
+        return false;
+
+    w->size = w->end;
+    w->map = mmap(NULL, w->size, PROT_READ | PROT_WRITE, MAP_SHARED, w->fd, 0);
+    if (w->map == MAP_FAILED) {
+        w->map = NULL;
+        return false;
+    }
+    return true;
+}
+
+void trace_writer_set_time(trace_writer_t *w, uint64_t t, uint64_t time) {
+    ((uint64_t *)(w->map + w->header.time_offset))[t] = time;
+}
+
+void trace_writer_set(trace_writer_t *w, int column, uint64_t t, uint64_t value, bool valid) {
+    const trace_dir_entry_t *e = &w->entries[column];
+    uint8_t *values = w->map + e->values_offset;
+
+    switch (trace_bytes(e->width)) {
+        case 1:
+            values[t] = value;
+            break;
+        case 2:
+            ((uint16_t *) values)[t] = value;
+            break;
+        case 4:
+            ((uint32_t *) values)[t] = value;
+            break;
+        default:
+            ((uint64_t *) values)[t] = value;
+            break;
+    }
+
+    uint8_t *bits = w->map + e->valid_offset + (t >> 3);
+    *bits = valid ? *bits | (1 << (t & 7)) : *bits & ~(1 << (t & 7));
+}
+
+static bool trace_writer_free(trace_writer_t *w) {
+    trace_free_dir(w->count, w->entries, w->names);
+    bool ok = !close(w->fd);
+    free(w);
+    return ok;
+}
+
+void trace_writer_abort(trace_writer_t *w) {
+    if (w->map)
+        munmap(w->map, w->size);
+    trace_writer_free(w);
+}
+
+bool trace_writer_close(trace_writer_t *w) {
+    bool ok = w->map != NULL;
+
+    if (w->map) {
+        ok = !msync(w->map, w->size, MS_SYNC);
+        munmap(w->map, w->size);
+    }
+
+    // Directory behind the columns
+    uint64_t dir_size = sizeof(uint32_t);
+    for (int i = 0; i < w->count; i++)
+        dir_size += sizeof(trace_dir_entry_t) + ALIGN(w->entries[i].name_len, 8);
+
+    uint8_t *dir = calloc(1, dir_size);
+    uint64_t p = 0;
+    uint32_t n = w->count;
+    memcpy(dir, &n, sizeof(n));
+    p += sizeof(n);
+    for (int i = 0; i < w->count; i++) {
+        memcpy(dir + p, &w->entries[i], sizeof(trace_dir_entry_t));
+        p += sizeof(trace_dir_entry_t);
+        memcpy(dir + p, w->names[i], w->entries[i].name_len);
+        p += ALIGN(w->entries[i].name_len, 8);
+    }
+
+    ok = ok && pwrite(w->fd, dir, dir_size, w->end) == (ssize_t) dir_size;
+    ok = ok && !fsync(w->fd);
+
+    // Publishing the directory makes the new signals visible
+    if (ok) {
+        w->header.dir_offset = w->end;
+        w->header.dir_size = dir_size;
+        ok = pwrite(w->fd, &w->header, sizeof(w->header), 0) == sizeof(w->header);
+    }
+
+    free(dir);
+    return trace_writer_free(w) && ok;
+}
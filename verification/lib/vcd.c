@@ -1,21 +1,59 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <unistd.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
 
 #include "vcd.h"
 
 #define MIN(a,b) ((a) < (b) ? (a) : (b))
 #define MAX(a,b) ((a) > (b) ? (a) : (b))
 
+static int64_t vcd_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
 vcd_t *vcd_open(char *file, size_t history_length_log) {
+    vcd_t *vcd = vcd_open_backend(file, history_length_log, VCD_BACKEND_MMAP);
+    return vcd ? vcd : vcd_open_backend(file, history_length_log, VCD_BACKEND_STDIO);
+}
+
+vcd_t *vcd_open_backend(char *file, size_t history_length_log, vcd_backend_t backend) {
 
     FILE *input_file = fopen(file, "r");
     if (!input_file)
         return NULL;
 
+    const char *map = NULL;
+    size_t map_size = 0;
+    if (backend == VCD_BACKEND_MMAP) {
+        struct stat st;
+        int fd = fileno(input_file);
+        if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size == 0) {
+            fclose(input_file);
+            return NULL;
+        }
+
+        map_size = st.st_size;
+        map = mmap(NULL, map_size, PROT_READ, MAP_SHARED, fd, 0);
+        fclose(input_file);
+        input_file = NULL;
+
+        if (map == MAP_FAILED)
+            return NULL;
+        madvise((void *) map, map_size, MADV_SEQUENTIAL);
+    }
+
     vcd_t *vcd = malloc(sizeof(vcd_t));
     
     if (!vcd)
@@ -29,70 +67,264 @@ vcd_t *vcd_open(char *file, size_t history_length_log) {
     vcd->state = HEADER;
     vcd->signals = NULL;
     vcd->signal_count = 0;
+    vcd->signal_cap = 0;
+    memset(&vcd->index, 0, sizeof(vcd->index));
+    vcd->watched = NULL;
+    vcd->watched_count = 0;
+    vcd->filter = false;
+    vcd->subscribed = NULL;
+    vcd->scope = calloc(1, 1);
     vcd->version = NULL;
     vcd->timescale = NULL;
     vcd->date = NULL;
     vcd->comment = NULL;
-    vcd->lowest_symbol = 127;
-    vcd->highest_symbol = 0;
 
+    vcd->backend = backend;
     vcd->source = input_file;
+    vcd->map = map;
+    vcd->map_size = map_size;
+    vcd->body = NULL;
+    vcd->line = map;
+    vcd->end = map + map_size;
+    vcd->eof = false;
+    vcd->follow_fd = -1;
+    vcd->follow_idle_ms = VCD_FOLLOW_IDLE_MS;
+    vcd->follow_last = vcd_now_ms();
+    vcd->follow_closed = false;
+    vcd->on_wait = NULL;
+    vcd->on_wait_arg = NULL;
+    vcd->follow_buffer = NULL;
+    vcd->follow_n = 0;
+    vcd->parent = NULL;
     vcd->line_buffer = NULL;
     vcd->line_n = 0UL;
     vcd->line_idx = 0;
 
     vcd->time = 0UL;
+
+    if (backend == VCD_BACKEND_FOLLOW) {
+        vcd->follow_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (vcd->follow_fd >= 0 && inotify_add_watch(vcd->follow_fd, file, IN_MODIFY | IN_CLOSE_WRITE) < 0) {
+            close(vcd->follow_fd);
+            vcd->follow_fd = -1;
+        }
+    }
+
     return vcd;
 }
 
+void vcd_follow(vcd_t *vcd, int idle_ms, bool (*on_wait)(void *arg), void *arg) {
+    vcd->follow_idle_ms = idle_ms;
+    vcd->on_wait = on_wait;
+    vcd->on_wait_arg = arg;
+}
+
 void vcd_close(vcd_t *vcd) {
-    fclose(vcd->source);
+    if (vcd->parent) {
+        for (int i = 0; i < vcd->signal_count; i++) {
+            free(vcd->signals[i].data);
+            free(vcd->signals[i].valid);
+        }
+        free(vcd->signals);
+        free(vcd->watched);
+        free(vcd->subscribed);
+        free(vcd->line_buffer);
+        free(vcd);
+        return;
+    }
+
+    if (vcd->source)
+        fclose(vcd->source);
+    if (vcd->follow_fd >= 0)
+        close(vcd->follow_fd);
+    if (vcd->map)
+        munmap((void *) vcd->map, vcd->map_size);
 
     free(vcd->version);
     free(vcd->timescale);
     free(vcd->date);
     free(vcd->comment);
     free(vcd->line_buffer);
+    free(vcd->follow_buffer);
+    free(vcd->scope);
 
     for (int i = 0; i < vcd->signal_count; i++) {
         free(vcd->signals[i].name);
+        free(vcd->signals[i].path);
+        free(vcd->signals[i].id);
         free(vcd->signals[i].data);
         free(vcd->signals[i].valid);
     }
 
     free(vcd->signals);
+    free(vcd->watched);
+    free(vcd->subscribed);
+    free(vcd->index.radix);
+    free(vcd->index.hash);
 
     free(vcd);
 }
 
+static const char *vcd_map_end(vcd_t *vcd) {
+    return vcd->end;
+}
+
+// Start of the line after p
+static const char *vcd_skip_line(const char *p, const char *end) {
+    const char *nl = memchr(p, '\n', end - p);
+    return nl ? nl + 1 : end;
+}
+
+/*
+ * Waits until the followed file may have grown, returns false at its end
+ */
+static bool vcd_follow_wait(vcd_t *vcd) {
+    if (vcd->follow_closed)
+        return false;
+    if (vcd->on_wait && !vcd->on_wait(vcd->on_wait_arg))
+        return false;
+
+    int64_t timeout = vcd->follow_last + vcd->follow_idle_ms - vcd_now_ms();
+    if (timeout <= 0)
+        return false;
+
+    if (vcd->follow_fd < 0) {
+        poll(NULL, 0, MIN(timeout, VCD_FOLLOW_POLL_MS));
+        return true;
+    }
+
+    struct pollfd pfd = { .fd = vcd->follow_fd, .events = POLLIN };
+    if (poll(&pfd, 1, timeout) == 0)
+        return false;
+
+    // Read once more after the writer closed the file, then stop
+    char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t len;
+    while ((len = read(vcd->follow_fd, events, sizeof(events))) > 0) {
+        for (char *p = events; p < events + len; p += sizeof(struct inotify_event) + ((struct inotify_event *) p)->len)
+            vcd->follow_closed |= (((struct inotify_event *) p)->mask & IN_CLOSE_WRITE) != 0;
+    }
+    return true;
+}
+
+/*
+ * Reads a complete line into line_buffer, waiting for the rest of it if
+ * necessary. At the end of the dump, a partial last line is returned as is,
+ * and eof is only set by the call after it.
+ */
+static ssize_t vcd_follow_line(vcd_t *vcd) {
+    size_t len = 0;
+
+    for (;;) {
+        char **buffer = len ? &vcd->follow_buffer : &vcd->line_buffer;
+        size_t *n = len ? &vcd->follow_n : &vcd->line_n;
+        ssize_t read = getline(buffer, n, vcd->source);
+
+        if (read > 0) {
+            if (len) {
+                if (vcd->line_n < len + read + 1) {
+                    vcd->line_n = len + read + 1;
+                    vcd->line_buffer = realloc(vcd->line_buffer, vcd->line_n);
+                }
+                memcpy(vcd->line_buffer + len, vcd->follow_buffer, read + 1);
+            }
+            len += read;
+            vcd->follow_last = vcd_now_ms();
+
+            if (vcd->line_buffer[len - 1] == '\n')
+                return len;
+        }
+
+        clearerr(vcd->source);
+        if (!vcd_follow_wait(vcd)) {
+            vcd->eof = !len;
+            return len ? (ssize_t) len : -1;
+        }
+    }
+}
+
 ssize_t vcd_next_line(vcd_t *vcd) {
     vcd->line_idx++;
-    return getline(&vcd->line_buffer, &vcd->line_n, vcd->source);
+
+    if (vcd->backend == VCD_BACKEND_FOLLOW)
+        return vcd_follow_line(vcd);
+
+    // eof once there is no line left, a last line without a newline sets the
+    // end of file indicator already but must be parsed as well
+    if (vcd->backend == VCD_BACKEND_STDIO) {
+        ssize_t read = getline(&vcd->line_buffer, &vcd->line_n, vcd->source);
+        vcd->eof = read < 0;
+        return read;
+    }
+
+    // The header is parsed from a copy, the body in place
+    const char *end = vcd_map_end(vcd);
+    if (vcd->line == end) {
+        vcd->eof = true;
+        return -1;
+    }
+
+    const char *next = vcd_skip_line(vcd->line, end);
+    size_t len = next - vcd->line;
+    if (vcd->line_n < len + 1) {
+        vcd->line_n = len + 1;
+        vcd->line_buffer = realloc(vcd->line_buffer, vcd->line_n);
+    }
+    memcpy(vcd->line_buffer, vcd->line, len);
+    vcd->line_buffer[len] = '\0';
+
+    return len;
 }
 
 void vcd_add_signal(vcd_t *vcd, char *line) {
-    vcd_signal_t *signal = malloc(sizeof(vcd_signal_t));
-    signal->name  = malloc(sizeof(*line) * (strlen(line) + 1));
-    signal->data  = malloc(sizeof(*signal->data) * vcd->history_length);
-    signal->valid = malloc(sizeof(*signal->valid) * vcd->history_length);
-    signal->processed = false;
-    char symbol[2];
-    sscanf(line, "var wire %d %s %s %*s $end", &signal->width, symbol, signal->name);
-
-    if (signal->width > 64) {
+    // var <type> <width> <id> <name> [<range>] $end
+    int width, id_start = 0, id_end = 0, name_start = 0, name_end = 0;
+    sscanf(line, "var %*s %d %n%*s%n %n%*s%n", &width, &id_start, &id_end, &name_start, &name_end);
+
+    if (!name_end) {
+        fprintf(stderr, "vcd_add_signal: malformed declaration in line %lu: %s\n", vcd->line_idx, line);
+        exit(EXIT_FAILURE);
+    }
+
+    if (width > 64) {
         fprintf(stderr, "vcd_add_signal: Unsupported signal width > 64!\n");
         exit(EXIT_FAILURE);
     }
 
-    vcd->lowest_symbol = MIN(vcd->lowest_symbol, symbol[0]);
-    vcd->highest_symbol = MAX(vcd->highest_symbol, symbol[0]);
-    signal->symbol = symbol[0];
+    if (vcd->signal_count == vcd->signal_cap) {
+        vcd->signal_cap = vcd->signal_cap ? 2 * vcd->signal_cap : 16;
+        vcd->signals = realloc(vcd->signals, sizeof(vcd_signal_t) * vcd->signal_cap);
+    }
 
+    vcd_signal_t *signal = &vcd->signals[vcd->signal_count++];
+    signal->width = width;
+    signal->id = strndup(line + id_start, id_end - id_start);
+    signal->name = strndup(line + name_start, name_end - name_start);
+    signal->path = malloc(strlen(vcd->scope) + strlen(signal->name) + 2);
+    sprintf(signal->path, *vcd->scope ? "%s.%s" : "%s%s", vcd->scope, signal->name);
+    signal->alias = -1;
+    signal->watched = false;
+    signal->data  = calloc(vcd->history_length, sizeof(*signal->data));
+    signal->valid = calloc(vcd->history_length, sizeof(*signal->valid));
+    signal->timeslot = -1;
+}
 
-    signal->next = vcd->signals;
-    vcd->signals = signal;
+// scope <type> <name> $end
+static void vcd_push_scope(vcd_t *vcd, char *line) {
+    int name_start = 0, name_end = 0;
+    sscanf(line, "scope %*s %n%*s%n", &name_start, &name_end);
+
+    size_t len = strlen(vcd->scope);
+    vcd->scope = realloc(vcd->scope, len + (name_end - name_start) + 2);
+    if (len)
+        vcd->scope[len++] = '.';
+    memcpy(vcd->scope + len, line + name_start, name_end - name_start);
+    vcd->scope[len + name_end - name_start] = '\0';
+}
 
-    vcd->signal_count++;
+static void vcd_pop_scope(vcd_t *vcd) {
+    char *dot = strrchr(vcd->scope, '.');
+    *(dot ? dot : vcd->scope) = '\0';
 }
 
 void vcd_str_helper(vcd_t *vcd, size_t len, char **field, char *name) {
@@ -115,8 +347,10 @@ void vcd_str_helper(vcd_t *vcd, size_t len, char **field, char *name) {
 
 void vcd_parse_header_line(vcd_t *vcd) {
     size_t len = strlen(vcd->line_buffer);
-    if (vcd->line_buffer[len - 1] == '\n')
-        vcd->line_buffer[len - 1] = '\0';
+    if (len && vcd->line_buffer[len - 1] == '\n')
+        vcd->line_buffer[--len] = '\0';
+    if (len && vcd->line_buffer[len - 1] == '\r')
+        vcd->line_buffer[--len] = '\0';
 
     switch (vcd->state) {
         case BODY:
@@ -141,8 +375,11 @@ void vcd_parse_header_line(vcd_t *vcd) {
                 } else if (!strncmp(command, "timescale", len)) {
                     vcd->state = TIMESCALE;
                     return;
-                } else if (!strncmp(command, "scope", MIN(len, 5)) || !strncmp(command, "upscope", MIN(len, 7))) {
-                    // Ignored
+                } else if (!strncmp(command, "scope", MIN(len, 5))) {
+                    vcd_push_scope(vcd, command);
+                    return;
+                } else if (!strncmp(command, "upscope", MIN(len, 7))) {
+                    vcd_pop_scope(vcd);
                     return;
                 } else if (!strncmp(command, "enddefinitions", MIN(len, 14))) {
                     vcd->state = BODY;
@@ -178,6 +415,152 @@ void vcd_parse_header_line(vcd_t *vcd) {
     }
 }
 
+// Value of an identifier as a base 94 number, with the first character as the
+// least or most significant digit. Shorter identifiers come first, i.e. "!"
+// is 0, "~" is 93 and "!!" is 94.
+static uint64_t vcd_id_value(const char *id, size_t len, bool msb_first) {
+    static const uint64_t offset[VCD_RADIX_MAX_LEN + 1] = { 0, 0, 94, 94 + 94 * 94, 94 + 94 * 94 + 94 * 94 * 94 };
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        char c = msb_first ? id[i] : id[len - 1 - i];
+        value = value * 94 + (uint64_t)(c - '!');
+    }
+    return offset[len] + value;
+}
+
+static bool vcd_id_radix(const char *id, size_t len) {
+    if (len == 0 || len > VCD_RADIX_MAX_LEN)
+        return false;
+
+    for (size_t i = 0; i < len; i++)
+        if (id[i] < '!' || id[i] > '~')
+            return false;
+    return true;
+}
+
+// FNV-1a
+static uint64_t vcd_id_hash(const char *id, size_t len) {
+    uint64_t h = 0xcbf29ce484222325;
+    for (size_t i = 0; i < len; i++)
+        h = (h ^ (uint8_t) id[i]) * 0x100000001b3;
+    return h;
+}
+
+// Appends signal i to the aliases of first
+static void vcd_add_alias(vcd_t *vcd, int first, int i) {
+    while (vcd->signals[first].alias >= 0)
+        first = vcd->signals[first].alias;
+    vcd->signals[first].alias = i;
+}
+
+static void vcd_build_lookup(vcd_t *vcd) {
+    vcd_index_t *index = &vcd->index;
+
+    // Radix table, if every id fits and the table is not much sparser than
+    // the signals, in the better of both digit orders
+    bool radix = vcd->signal_count > 0;
+    uint64_t max_value[2] = { 0, 0 };
+    for (int i = 0; i < vcd->signal_count && radix; i++) {
+        const char *id = vcd->signals[i].id;
+        size_t len = strlen(id);
+        radix = vcd_id_radix(id, len);
+        for (int msb_first = 0; msb_first < 2 && radix; msb_first++)
+            max_value[msb_first] = MAX(max_value[msb_first], vcd_id_value(id, len, msb_first));
+    }
+
+    index->radix_msb_first = max_value[1] < max_value[0];
+    uint64_t radix_size = max_value[index->radix_msb_first] + 1;
+
+    if (radix && radix_size <= MAX(1024, 8 * (uint64_t) vcd->signal_count)) {
+        index->radix_size = radix_size;
+        index->radix = malloc(sizeof(int32_t) * radix_size);
+        memset(index->radix, 0xFF, sizeof(int32_t) * radix_size);
+
+        for (int i = 0; i < vcd->signal_count; i++) {
+            const char *id = vcd->signals[i].id;
+            int32_t *slot = &index->radix[vcd_id_value(id, strlen(id), index->radix_msb_first)];
+            if (*slot < 0)
+                *slot = i;
+            else
+                vcd_add_alias(vcd, *slot, i);
+        }
+        return;
+    }
+
+    size_t size = 16;
+    while (size < 2 * (size_t) vcd->signal_count)
+        size <<= 1;
+
+    index->hash_mask = size - 1;
+    index->hash = malloc(sizeof(int32_t) * size);
+    memset(index->hash, 0xFF, sizeof(int32_t) * size);
+
+    for (int i = 0; i < vcd->signal_count; i++) {
+        const char *id = vcd->signals[i].id;
+        size_t h = vcd_id_hash(id, strlen(id)) & index->hash_mask;
+
+        for (;; h = (h + 1) & index->hash_mask) {
+            int32_t *slot = &index->hash[h];
+            if (*slot < 0) {
+                *slot = i;
+                break;
+            }
+            if (!strcmp(vcd->signals[*slot].id, id)) {
+                vcd_add_alias(vcd, *slot, i);
+                break;
+            }
+        }
+    }
+}
+
+// Index of the first signal with the id, or -1
+static inline int vcd_lookup(const vcd_t *vcd, const char *id, size_t len);
+
+static void vcd_subscribe(vcd_t *vcd, const vcd_signal_t *signal) {
+    int i = vcd_lookup(vcd, signal->id, strlen(signal->id));
+    if (i >= 0)
+        vcd->subscribed[i >> 6] |= 1ULL << (i & 63);
+}
+
+static void vcd_build_index(vcd_t *vcd) {
+    vcd_build_lookup(vcd);
+
+    vcd->subscribed = calloc(vcd->signal_count / 64 + 1, sizeof(uint64_t));
+    for (int i = 0; i < vcd->watched_count; i++)
+        vcd_subscribe(vcd, &vcd->signals[vcd->watched[i]]);
+}
+
+static inline int vcd_lookup(const vcd_t *vcd, const char *id, size_t len) {
+    const vcd_index_t *index = &vcd->index;
+
+    if (index->radix) {
+        if (!vcd_id_radix(id, len))
+            return -1;
+        uint64_t value = vcd_id_value(id, len, index->radix_msb_first);
+        return value < index->radix_size ? index->radix[value] : -1;
+    }
+
+    if (!index->hash)
+        return -1;
+
+    for (size_t h = vcd_id_hash(id, len) & index->hash_mask;; h = (h + 1) & index->hash_mask) {
+        int i = index->hash[h];
+        if (i < 0)
+            return -1;
+
+        const char *other = vcd->signals[i].id;
+        if (!strncmp(other, id, len) && other[len] == '\0')
+            return i;
+    }
+}
+
+// Advances the mmap backend to the next line, which is left in place
+static void vcd_advance(vcd_t *vcd) {
+    if (vcd->backend == VCD_BACKEND_MMAP)
+        vcd->line = vcd_skip_line(vcd->line, vcd_map_end(vcd));
+}
+
 void vcd_parse_header(vcd_t *vcd) {
     do {
         ssize_t read = vcd_next_line(vcd);
@@ -185,120 +568,293 @@ void vcd_parse_header(vcd_t *vcd) {
             break;
 
         vcd_parse_header_line(vcd);
-    } while (!feof(vcd->source) && vcd->state != BODY);
+        vcd_advance(vcd);
+    } while (!vcd->eof && vcd->state != BODY);
 
-    if (vcd_next_line(vcd) == -1)
-        return;
+    vcd_build_index(vcd);
 
-    // Consolidate signals (aka. linked list to array)
-    if (vcd->signals == NULL)
-        return;
+    // Mmap: the first body line is vcd->line, the copy is not used
+    vcd->body = vcd->line;
+    vcd_next_line(vcd);
+}
 
-    size_t range = (size_t)(vcd->highest_symbol - vcd->lowest_symbol + 1);
-    
-    if (range < (size_t)(vcd->signal_count)) {
-        fprintf(stderr, "vcd_parse_header: range < vcd->signal_count. aborting!\n");
-        exit(EXIT_FAILURE);
+vcd_t *vcd_fork(const vcd_t *vcd) {
+    if (vcd->backend != VCD_BACKEND_MMAP)
+        return NULL;
+
+    vcd_t *fork = malloc(sizeof(vcd_t));
+    *fork = *vcd;
+    fork->parent = vcd;
+    fork->line_buffer = NULL;
+    fork->line_n = 0;
+
+    fork->signals = malloc(sizeof(vcd_signal_t) * vcd->signal_count);
+    for (int i = 0; i < vcd->signal_count; i++) {
+        fork->signals[i] = vcd->signals[i];
+        fork->signals[i].data  = calloc(vcd->history_length, sizeof(uint64_t));
+        fork->signals[i].valid = calloc(vcd->history_length, sizeof(bool));
+        fork->signals[i].timeslot = -1;
     }
 
-    vcd_signal_t *signal_block = malloc(sizeof(vcd_signal_t) * range);
+    fork->watched = malloc(sizeof(int) * (vcd->watched_count + 1));
+    memcpy(fork->watched, vcd->watched, sizeof(int) * vcd->watched_count);
+
+    size_t subscribed_size = sizeof(uint64_t) * (vcd->signal_count / 64 + 1);
+    fork->subscribed = malloc(subscribed_size);
+    memcpy(fork->subscribed, vcd->subscribed, subscribed_size);
+
+    return fork;
+}
 
-    vcd_signal_t *next = vcd->signals;
-    while (next != NULL) {
-        
-        size_t idx = (size_t)(next->symbol - vcd->lowest_symbol);
-        memcpy(&signal_block[idx], next, sizeof(vcd_signal_t));
-        signal_block[idx].next = NULL;
+void vcd_seek(vcd_t *vcd, const char *begin, const char *end) {
+    vcd->line = begin;
+    vcd->end = end;
+    vcd->eof = begin == end;
+    vcd->time = 0;
+    vcd->timeslot_idx = 0;
 
-        vcd_signal_t *tmp = next;
-        next = next->next;
-        free(tmp);
+    for (int i = 0; i < vcd->signal_count; i++) {
+        vcd_signal_t *signal = &vcd->signals[i];
+        memset(signal->data, 0, sizeof(uint64_t) * vcd->history_length);
+        memset(signal->valid, 0, sizeof(bool) * vcd->history_length);
+        signal->timeslot = -1;
     }
+}
+
+const char *vcd_find_timeslot(const vcd_t *vcd, const char *p) {
+    const char *end = vcd->map + vcd->map_size;
+    if (p <= vcd->body)
+        p = vcd->body;
+    else
+        p = vcd_skip_line(p - 1, end);
+
+    while (p != end && *p != '#')
+        p = vcd_skip_line(p, end);
+    return p;
+}
 
-    vcd->signals = signal_block;
+const char *vcd_rewind_timeslots(const vcd_t *vcd, const char *p, size_t n) {
+    while (n && p > vcd->body) {
+        const char *nl = p - 1 > vcd->body ? memrchr(vcd->body, '\n', (p - 1) - vcd->body) : NULL;
+        p = nl ? nl + 1 : vcd->body;
+        if (*p == '#')
+            n--;
+    }
+    return p;
 }
 
 size_t vcd_get_data_idx(vcd_t *vcd, ssize_t i) {
     return vcd->history_length_mask & (vcd->history_length + i + vcd->timeslot_idx);
 }
 
-void vcd_parse_body_line(vcd_t *vcd) {
-    char data[64];
-    size_t len;
-    char *line;
-    char symbol;
-    uint64_t new_time;
-    uint64_t *data_ptr;
-    ssize_t data_idx;
+// Stores a value of the signal with the id in [p, end of token) and its aliases
+static const char *vcd_set_value(vcd_t *vcd, const char *p, const char *end, uint64_t data, bool valid) {
+    const char *id = p;
+    while (p < end && *p != ' ' && *p != '\r' && *p != '\n')
+        p++;
+
+    int first = vcd_lookup(vcd, id, p - id);
+    if (vcd->filter && first >= 0 && !(vcd->subscribed[first >> 6] >> (first & 63) & 1))
+        return p;
+
+    ssize_t data_idx = vcd_get_data_idx(vcd, 0);
+    for (int i = first; i >= 0; i = vcd->signals[i].alias) {
+        vcd_signal_t *signal = &vcd->signals[i];
+        signal->valid[data_idx] = valid;
+        signal->data[data_idx] = data;
+        signal->timeslot = vcd->timeslot_idx;
+    }
+
+    return p;
+}
+
+#define VCD_BYTES(b) (0x0101010101010101ULL * (b))
+
+// 8 characters, the first one in the lowest byte
+static inline uint64_t vcd_load_chars(const char *p) {
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
 
-    switch (vcd->line_buffer[0]) {
-        case '$':
-            // Ignore
+const char *vcd_parse_vector_slow(const char *p, const char *end, uint64_t *data, bool *valid) {
+    *data = 0;
+    *valid = true;
+    for (; p < end && *p != ' ' && *p != '\r' && *p != '\n'; p++) {
+        switch (*p) {
+            case '0':
+            case '1':
+                *data = (*data << 1) | (*p & 0x1);
+                break;
+            default:
+                *valid = false;
+                break;
+        }
+    }
+    return p;
+}
+
+/*
+ * Takes 8 characters at a time: after xor with '0', digits have at most their
+ * lowest bit set, so the first other character is the lowest non-zero byte of
+ * the rest, and the multiplication gathers the lowest bits of the bytes before
+ * it into the top byte, the first digit most significant. Values with other
+ * characters (x, z) take the slow path.
+ */
+const char *vcd_parse_vector(const char *p, const char *end, uint64_t *data, bool *valid) {
+    const char *begin = p;
+    uint64_t value = 0;
+
+    for (; end - p >= 8; p += 8) {
+        uint64_t d = vcd_load_chars(p) ^ VCD_BYTES('0');
+        uint64_t other = d & VCD_BYTES(0xFE);
+        other = (((other & VCD_BYTES(0x7F)) + VCD_BYTES(0x7F)) | other) & VCD_BYTES(0x80);
+
+        int n = other ? __builtin_ctzll(other) >> 3 : 8;
+        uint64_t bits = d & VCD_BYTES(0x01);
+        if (n < 8)
+            bits &= (1ULL << (8 * n)) - 1;
+        bits = (bits * 0x8040201008040201ULL) >> 56 >> (8 - n);
+        value = (value << n) | bits;
+
+        if (n < 8) {
+            p += n;
             break;
+        }
+    }
+
+    while (p < end && (*p == '0' || *p == '1'))
+        value = (value << 1) | (*p++ & 0x1);
+
+    if (p < end && *p != ' ' && *p != '\r' && *p != '\n')
+        return vcd_parse_vector_slow(begin, end, data, valid);
+
+    *data = value;
+    *valid = true;
+    return p;
+}
+
+/*
+ * Applies the value change in [p, end), returns the start of the next line.
+ * Timestamps, scalar and vector changes are processed, everything else is
+ * skipped.
+ */
+static const char *vcd_parse_change(vcd_t *vcd, const char *p, const char *end) {
+    uint64_t new_time;
+    uint64_t data;
+    bool valid;
+
+    switch (*p) {
         case '#':
-            sscanf(vcd->line_buffer + 1, "%lu", &new_time);
+            new_time = 0;
+            for (p++; p < end && *p >= '0' && *p <= '9'; p++)
+                new_time = new_time * 10 + (uint64_t)(*p - '0');
+
             if (new_time != vcd->time) {
                 vcd->timeslot_idx++;
                 vcd->time = new_time;
             }
-            return;
+            break;
+        case '0':
+        case '1':
+            p = vcd_set_value(vcd, p + 1, end, *p & 0x1, true);
+            break;
+        case 'x':
+        case 'X':
+        case 'z':
+        case 'Z':
+            p = vcd_set_value(vcd, p + 1, end, 0, false);
+            break;
         case 'b':
-            line = vcd->line_buffer;
- 
-            sscanf(line, "b%s %c", data, &symbol);
-            len = strlen(data);
-
-            vcd_signal_t *signal = &vcd->signals[(size_t)(symbol - vcd->lowest_symbol)];
-
-            data_idx = vcd_get_data_idx(vcd, 0);
-            signal->valid[data_idx] = true;
-            signal->processed = true;
-
-            data_ptr = &signal->data[data_idx];
-            *data_ptr = 0UL;
-
-            for (size_t i = 0; i < len; i++) {                
-                switch (data[i]) {
-                    case '0':
-                    case '1':
-                        *data_ptr = (*data_ptr << 1) | (data[i] & 0x1);
-                        break;
-                    default:
-                        signal->valid[data_idx] = false;
-                        break;
-                }
-            }
-
+        case 'B':
+            p = vcd_parse_vector(p + 1, end, &data, &valid);
+            while (p < end && *p == ' ')
+                p++;
+            p = vcd_set_value(vcd, p, end, data, valid);
+            break;
     }
+
+    return vcd_skip_line(p, end);
 }
 
-void vcd_next(vcd_t *vcd) {
-    for (int i = 0; i < vcd->signal_count; i++)
-        vcd->signals[i].processed = false;
+void vcd_parse_body_line(vcd_t *vcd) {
+    const char *line = vcd->line_buffer;
+    vcd_parse_change(vcd, line, line + strlen(line));
+}
 
-    do {
+void vcd_next(vcd_t *vcd) {
+    if (vcd->backend == VCD_BACKEND_MMAP) {
+        const char *line = vcd->line, *end = vcd_map_end(vcd);
+        size_t lines = 0;
+
+        while (line != end) {
+            line = vcd_parse_change(vcd, line, end);
+            lines++;
+            if (line != end && *line == '#')
+                break;
+        }
 
-        vcd_parse_body_line(vcd);
-        vcd_next_line(vcd);
-    } while (!feof(vcd->source) && vcd->line_buffer[0] != '#');
+        vcd->line = line;
+        vcd->line_idx += lines;
+        vcd->eof = line == end;
+    } else {
+        do {
+            vcd_parse_body_line(vcd);
+            vcd_next_line(vcd);
+        } while (!vcd->eof && vcd->line_buffer[0] != '#');
+    }
 
+    // Carry the watched signals without a change forward
     ssize_t idx = vcd_get_data_idx(vcd, 0);
     ssize_t old_idx = vcd_get_data_idx(vcd, -1);
-    for (int i = 0; i < vcd->signal_count; i++) {
-        if (!vcd->signals[i].processed)
-            vcd->signals[i].data[idx] = vcd->signals[i].data[old_idx];
+    for (int i = 0; i < vcd->watched_count; i++) {
+        vcd_signal_t *signal = &vcd->signals[vcd->watched[i]];
+        if (signal->timeslot != vcd->timeslot_idx) {
+            signal->data[idx] = signal->data[old_idx];
+            signal->valid[idx] = signal->valid[old_idx];
+        }
     }
 }
 
 bool vcd_has_next(vcd_t *vcd) {
-    return !feof(vcd->source);
+    return !vcd->eof;
 }
 
 vcd_signal_t *vcd_get_signal_by_name(vcd_t *vcd, char *name) {
-    for (int i = 0; i < vcd->signal_count; i++)
+    vcd_signal_t *found = NULL;
+    for (int i = 0; i < vcd->signal_count && !found; i++)
+        if (!strcmp(vcd->signals[i].path, name))
+            found = &vcd->signals[i];
+    for (int i = 0; i < vcd->signal_count && !found; i++)
         if (!strcmp(vcd->signals[i].name, name))
-            return &vcd->signals[i];
-    return NULL;
+            found = &vcd->signals[i];
+
+    if (found)
+        vcd_watch(vcd, found);
+    return found;
+}
+
+vcd_signal_t *vcd_get_signal_by_id(vcd_t *vcd, const char *id, size_t len) {
+    int i = vcd_lookup(vcd, id, len);
+    return i < 0 ? NULL : &vcd->signals[i];
+}
+
+void vcd_watch(vcd_t *vcd, vcd_signal_t *signal) {
+    if (signal->watched)
+        return;
+
+    signal->watched = true;
+    vcd->watched = realloc(vcd->watched, sizeof(int) * (vcd->watched_count + 1));
+    vcd->watched[vcd->watched_count++] = (int)(signal - vcd->signals);
+    if (vcd->subscribed)
+        vcd_subscribe(vcd, signal);
+}
+
+void vcd_filter(vcd_t *vcd, bool filter) {
+    vcd->filter = filter;
 }
 
 void vcd_skip(vcd_t *vcd, size_t n) {
@@ -0,0 +1,70 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "golden.h"
+#include "golden_kernel.h"
+
+void golden_eval_avx2(size_t n, const int32_t *exp_e, const int32_t *u_1, const int32_t *u_2, double *x_0,
+        double *x_1, double *e);
+
+static golden_isa_t golden_isa = GOLDEN_ISA_SCALAR;
+static bool golden_isa_init = false;
+
+void golden_libm(uint64_t u_0, uint64_t u_1, uint64_t u_2, double *x, double *e) {
+    double exp_e = (u_0 << 16 ? __builtin_clzll(u_0 << 16) : 48) + 1.0;
+    *e = 2 * (log(2.0) * exp_e - log(1.0 + u_2 * 4.656612873077393e-10));
+
+    double f = sqrt(*e);
+
+    x[0] = sin(2 * M_PI * u_1 * 1.52587890625e-05) * f;
+    x[1] = cos(2 * M_PI * u_1 * 1.52587890625e-05) * f;
+}
+
+static bool golden_isa_supported(golden_isa_t isa) {
+    switch (isa) {
+    case GOLDEN_ISA_SCALAR:
+        return true;
+#ifdef GOLDEN_HAVE_AVX2
+    case GOLDEN_ISA_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+bool golden_set_isa(golden_isa_t isa) {
+    if (!golden_isa_supported(isa))
+        return false;
+
+    golden_isa = isa;
+    golden_isa_init = true;
+    return true;
+}
+
+void golden_eval(size_t n, const uint64_t *u_0, const uint64_t *u_1, const uint64_t *u_2, double *x_0, double *x_1,
+        double *e) {
+    if (!golden_isa_init)
+        golden_set_isa(GOLDEN_ISA_AVX2);
+
+    int32_t exp_e[GOLDEN_BATCH], u_1_32[GOLDEN_BATCH], u_2_32[GOLDEN_BATCH];
+
+    for (size_t i = 0; i < n; i += GOLDEN_BATCH) {
+        size_t m = n - i < GOLDEN_BATCH ? n - i : GOLDEN_BATCH;
+
+        // The lzd of the 48-bit u_0, narrow fields for the conversions to double
+        for (size_t j = 0; j < m; j++) {
+            uint64_t u = u_0[i + j] << 16;
+            exp_e[j] = (u ? __builtin_clzll(u) : 48) + 1;
+            u_1_32[j] = u_1[i + j] & 0xFFFF;
+            u_2_32[j] = u_2[i + j] & 0x7FFFFFFF;
+        }
+
+        if (golden_isa == GOLDEN_ISA_AVX2)
+            golden_eval_avx2(m, exp_e, u_1_32, u_2_32, x_0 + i, x_1 + i, e + i);
+        else
+            golden_kernel(m, exp_e, u_1_32, u_2_32, x_0 + i, x_1 + i, e + i);
+    }
+}
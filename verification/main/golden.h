@@ -0,0 +1,46 @@
+#ifndef HEADER_GOLDEN
+#define HEADER_GOLDEN
+
+/*
+ * Double precision model of the boxmuller core, the reference the hardware
+ * outputs are compared against:
+ *
+ *   e   = -2 ln(u) = 2 (ln(2) (lzd(u_0) + 1) - ln(1 + u_2 2^-31))
+ *   x_0 = sqrt(e) sin(2 pi u_1 2^-16)
+ *   x_1 = sqrt(e) cos(2 pi u_1 2^-16)
+ *
+ * with the fields u_0 (48 bit), u_1 (16 bit) and u_2 (31 bit) of boxmuller.vhd.
+ *
+ * golden_eval evaluates batches with its own log and sincos, which exploit
+ * the narrow arguments: 1 + u_2 2^-31 is in [1, 2), and the angle reduces
+ * exactly to a multiple of pi/2 plus at most pi/4. Every operation vectorizes,
+ * and the results are within a few double ulps of golden_libm (see
+ * test/test_golden.c), i.e. ~1e-14 against the 2^-11 output ulp.
+ */
+
+#define GOLDEN_BATCH 256
+
+/* Instruction sets of golden_eval, all produce identical results */
+typedef enum golden_isa_t {
+    GOLDEN_ISA_SCALAR,
+    GOLDEN_ISA_AVX2
+} golden_isa_t;
+
+/*
+ * One sample with libm, the original model. x[0] = x_0, x[1] = x_1.
+ */
+void golden_libm(uint64_t u_0, uint64_t u_1, uint64_t u_2, double *x, double *e);
+
+/*
+ * n samples, the fields as arrays
+ */
+void golden_eval(size_t n, const uint64_t *u_0, const uint64_t *u_1, const uint64_t *u_2, double *x_0, double *x_1,
+        double *e);
+
+/*
+ * Overrides the instruction set, which defaults to the widest one of the
+ * host. Returns false if it is not available on this host or in this build.
+ */
+bool golden_set_isa(golden_isa_t isa);
+
+#endif
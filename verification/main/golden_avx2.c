@@ -0,0 +1,13 @@
+#include <stdint.h>
+#include <stddef.h>
+
+#include "golden_kernel.h"
+
+/*
+ * golden_kernel for AVX2, four samples per vector. Only called from
+ * golden_eval after checking the host.
+ */
+void golden_eval_avx2(size_t n, const int32_t *exp_e, const int32_t *u_1, const int32_t *u_2, double *x_0,
+        double *x_1, double *e) {
+    golden_kernel(n, exp_e, u_1, u_2, x_0, x_1, e);
+}
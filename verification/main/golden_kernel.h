@@ -0,0 +1,98 @@
+#ifndef HEADER_GOLDEN_KERNEL
+#define HEADER_GOLDEN_KERNEL
+
+/*
+ * The kernel of golden_eval, included by golden.c and golden_avx2.c, which is
+ * compiled with -mavx2. It is plain C without branches, so that the compiler
+ * vectorizes the loop for the target of each file. Only IEEE operations are
+ * used (no FMA, no reassociation), so every target gets the same results.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+// log(1 + f) = f - f^2/2 + s (f^2/2 + R(s^2)), s = f / (2 + f), from fdlibm's e_log.c
+#define GOLDEN_LG1 6.666666666666735130e-01
+#define GOLDEN_LG2 3.999999999940941908e-01
+#define GOLDEN_LG3 2.857142874366239149e-01
+#define GOLDEN_LG4 2.222219843214978396e-01
+#define GOLDEN_LG5 1.818357216161805012e-01
+#define GOLDEN_LG6 1.531383769920937332e-01
+#define GOLDEN_LG7 1.479819860511658591e-01
+#define GOLDEN_LN2_HI 6.93147180369123816490e-01
+#define GOLDEN_LN2_LO 1.90821492927058770002e-10
+
+// m > sqrt(2) for u_2 > GOLDEN_U_2_SQRT2, as a sign bit so that there is no branch
+#define GOLDEN_U_2_SQRT2 889516851
+
+// sin and cos on [-pi/4, pi/4], from fdlibm's k_sin.c and k_cos.c
+#define GOLDEN_S1 -1.66666666666666324348e-01
+#define GOLDEN_S2 8.33333333332248946124e-03
+#define GOLDEN_S3 -1.98412698298579493134e-04
+#define GOLDEN_S4 2.75573137070700676789e-06
+#define GOLDEN_S5 -2.50507602534068634195e-08
+#define GOLDEN_S6 1.58969099521155010221e-10
+#define GOLDEN_C1 4.16666666666666019037e-02
+#define GOLDEN_C2 -1.38888888888741095749e-03
+#define GOLDEN_C3 2.48015872894767294178e-05
+#define GOLDEN_C4 -2.75573143513906633035e-07
+#define GOLDEN_C5 2.08757232129817482790e-09
+#define GOLDEN_C6 -1.13596475577881948265e-11
+
+// 2 pi / 2^16, the angle of one u_1 lsb
+#define GOLDEN_U_1_ANGLE (M_PI / 32768)
+
+// pi/2 - M_PI/2. libm gets the angle in multiples of M_PI, so its zeros at the quadrant boundaries are off by this.
+#define GOLDEN_PIO2_LO 6.12323399573676603587e-17
+
+/*
+ * n <= GOLDEN_BATCH samples, exp_e = lzd(u_0) + 1
+ */
+static inline void golden_kernel(size_t n, const int32_t *restrict exp_e, const int32_t *restrict u_1,
+        const int32_t *restrict u_2, double *restrict x_0, double *restrict x_1, double *restrict e) {
+    for (size_t i = 0; i < n; i++) {
+        // ln(m), m = 1 + u_2 2^-31 is exact. k = 1 halves m to [sqrt(2)/2, 1), so f is small and exact, too.
+        double m = 1.0 + u_2[i] * 0x1p-31;
+        double k = -((GOLDEN_U_2_SQRT2 - u_2[i]) >> 31);
+        double f = m * (1.0 - 0.5 * k) - 1.0;
+        double s = f / (2.0 + f);
+        double z = s * s;
+        double w = z * z;
+        double t_1 = w * (GOLDEN_LG2 + w * (GOLDEN_LG4 + w * GOLDEN_LG6));
+        double t_2 = z * (GOLDEN_LG1 + w * (GOLDEN_LG3 + w * (GOLDEN_LG5 + w * GOLDEN_LG7)));
+        double hfsq = 0.5 * f * f;
+        double ln_m = k * GOLDEN_LN2_HI - ((hfsq - (s * (hfsq + t_2 + t_1) + k * GOLDEN_LN2_LO)) - f);
+
+        double e_i = 2 * (M_LN2 * exp_e[i] - ln_m);
+        double f_i = sqrt(e_i);
+
+        // 2 pi u_1 2^-16 = q pi/2 + r 2 pi 2^-16, |r| <= 2^13
+        int32_t q = u_1[i] >> 14;
+        int32_t r = u_1[i] & 0x3FFF;
+        int32_t up = r > 0x2000;
+        q += up;
+        r -= up << 14;
+
+        double y = r * GOLDEN_U_1_ANGLE - q * GOLDEN_PIO2_LO;
+        double y_2 = y * y;
+        double y_4 = y_2 * y_2;
+        double p_s = GOLDEN_S2 + y_2 * (GOLDEN_S3 + y_2 * GOLDEN_S4) + y_2 * y_4 * (GOLDEN_S5 + y_2 * GOLDEN_S6);
+        double sin_y = y + y_2 * y * (GOLDEN_S1 + y_2 * p_s);
+        double p_c = y_2 * (GOLDEN_C1 + y_2 * (GOLDEN_C2 + y_2 * GOLDEN_C3))
+            + y_4 * y_4 * (GOLDEN_C4 + y_2 * (GOLDEN_C5 + y_2 * GOLDEN_C6));
+        double h = 0.5 * y_2;
+        double v = 1.0 - h;
+        double cos_y = v + (((1.0 - v) - h) + y_2 * p_c);
+
+        // Quadrants 1..3: (cos, -sin), (-sin, -cos), (-cos, sin). The selects are exact products with 0 and +-1.
+        double odd = q & 1;
+        double a = odd * cos_y + (1.0 - odd) * sin_y;
+        double b = odd * sin_y + (1.0 - odd) * cos_y;
+        x_0[i] = (1 - (q & 2)) * a * f_i;
+        x_1[i] = (1 - ((q + 1) & 2)) * b * f_i;
+        e[i] = e_i;
+    }
+}
+
+#endif
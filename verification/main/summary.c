@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "summary.h"
+
+// Bins per unit listed by summary_print
+#define PRINT_BINS 8
+
+static const char *UNIT_NAMES[SUMMARY_UNITS] = { "ln segment", "sqrt exponent", "trig segment" };
+
+summary_t *summary_new(size_t k, double threshold) {
+    summary_t *summary = calloc(1, sizeof(summary_t));
+    summary->threshold = threshold;
+    summary->k = k;
+    summary->top = calloc(k ? k : 1, sizeof(sample_t));
+    return summary;
+}
+
+void summary_free(summary_t *summary) {
+    free(summary->top);
+    free(summary);
+}
+
+// Total order of the samples, the earlier one is worse on equal errors
+static bool worse(const sample_t *a, const sample_t *b) {
+    if (a->error != b->error)
+        return a->error > b->error;
+    return a->time < b->time;
+}
+
+static void top_push(summary_t *summary, const sample_t *s) {
+    sample_t *heap = summary->top;
+    size_t i;
+
+    if (summary->top_n < summary->k) {
+        // Sift up
+        for (i = summary->top_n++; i > 0 && worse(&heap[(i - 1) / 2], s); i = (i - 1) / 2)
+            heap[i] = heap[(i - 1) / 2];
+    } else if (summary->k && worse(s, &heap[0])) {
+        // Replace the top, sift down
+        for (i = 0;;) {
+            size_t c = 2 * i + 1;
+            if (c >= summary->top_n)
+                break;
+            if (c + 1 < summary->top_n && worse(&heap[c], &heap[c + 1]))
+                c++;
+            if (!worse(s, &heap[c]))
+                break;
+            heap[i] = heap[c];
+            i = c;
+        }
+    } else {
+        return;
+    }
+
+    heap[i] = *s;
+}
+
+static void bin_add(summary_bin_t *bin, double error, bool fail) {
+    bin->n++;
+    bin->fails += fail;
+    if (error > bin->max_error)
+        bin->max_error = error;
+}
+
+bool summary_add(summary_t *summary, const sample_t *s, double e) {
+    bool fail = s->error > summary->threshold;
+
+    summary->n++;
+    summary->fails += fail;
+
+    double h = s->error / SUMMARY_HIST_STEP;
+    summary->hist[h < SUMMARY_HIST_BINS - 1 ? (size_t) h : SUMMARY_HIST_BINS - 1]++;
+
+    // e in (7,24) like r_e, the bin is exp_f + 6 like r_f_exp
+    double e_fx = fmin(fmax(ldexp(e, 24), 0), 0x7FFFFFFF);
+    uint32_t e_bits = e_fx;
+
+    bin_add(&summary->ln[(s->u[2] >> 23) & (SUMMARY_LN_BINS - 1)], s->error, fail);
+    bin_add(&summary->f[__builtin_clz((e_bits << 1) | 1)], s->error, fail);
+    bin_add(&summary->trig[(s->u[1] >> 7) & (SUMMARY_TRIG_BINS - 1)], s->error, fail);
+
+    top_push(summary, s);
+    return fail;
+}
+
+static void bins_merge(summary_bin_t *acc, const summary_bin_t *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        acc[i].n += b[i].n;
+        acc[i].fails += b[i].fails;
+        if (b[i].max_error > acc[i].max_error)
+            acc[i].max_error = b[i].max_error;
+    }
+}
+
+void summary_merge(summary_t *acc, const summary_t *b) {
+    acc->n += b->n;
+    acc->fails += b->fails;
+    for (size_t i = 0; i < SUMMARY_HIST_BINS; i++)
+        acc->hist[i] += b->hist[i];
+
+    bins_merge(acc->ln, b->ln, SUMMARY_LN_BINS);
+    bins_merge(acc->f, b->f, SUMMARY_F_BINS);
+    bins_merge(acc->trig, b->trig, SUMMARY_TRIG_BINS);
+
+    for (size_t i = 0; i < b->top_n; i++)
+        top_push(acc, &b->top[i]);
+}
+
+static int cmp_sample(const void *a, const void *b) {
+    return worse(a, b) ? -1 : worse(b, a) ? 1 : 0;
+}
+
+// Lists the PRINT_BINS bins with the largest errors, the lower one on ties
+static void print_bins(FILE *out, summary_unit_t unit, const summary_bin_t *bins, int n) {
+    bool listed[SUMMARY_TRIG_BINS] = { false };
+
+    fprintf(out, "  %-14s %12s %12s %10s\n", UNIT_NAMES[unit], "samples", "failing", "max ulp");
+    for (int k = 0; k < PRINT_BINS; k++) {
+        int j = -1;
+        for (int i = 0; i < n; i++)
+            if (!listed[i] && bins[i].n && (j < 0 || bins[i].max_error > bins[j].max_error))
+                j = i;
+        if (j < 0)
+            break;
+        listed[j] = true;
+
+        if (unit == SUMMARY_F)
+            fprintf(out, "  %14d", j - 6);
+        else if (unit == SUMMARY_TRIG)
+            fprintf(out, "  %10d/%3d", j >> 7, j & 127);
+        else
+            fprintf(out, "  %14d", j);
+        fprintf(out, " %12lu %12lu %10.3f\n", bins[j].n, bins[j].fails, bins[j].max_error);
+    }
+}
+
+void summary_print(const summary_t *summary, FILE *out) {
+    uint64_t n = summary->n ? summary->n : 1;
+
+    fprintf(out, "samples %lu, failing (> %.2f ulp) %lu (%.6f%%)\n", summary->n, summary->threshold, summary->fails,
+            100.0 * summary->fails / n);
+
+    fprintf(out, "\nerror histogram (ulp), non-empty bins\n");
+    for (int i = 0; i < SUMMARY_HIST_BINS; i++) {
+        if (!summary->hist[i])
+            continue;
+        if (i == SUMMARY_HIST_BINS - 1)
+            fprintf(out, "  [%5.2f,   inf)", i * SUMMARY_HIST_STEP);
+        else
+            fprintf(out, "  [%5.2f, %5.2f)", i * SUMMARY_HIST_STEP, (i + 1) * SUMMARY_HIST_STEP);
+        fprintf(out, " %12lu %10.6f%%\n", summary->hist[i], 100.0 * summary->hist[i] / n);
+    }
+
+    sample_t *top = malloc(sizeof(sample_t) * (summary->top_n ? summary->top_n : 1));
+    memcpy(top, summary->top, sizeof(sample_t) * summary->top_n);
+    qsort(top, summary->top_n, sizeof(sample_t), cmp_sample);
+
+    fprintf(out, "\nworst %lu samples\n", summary->top_n);
+    for (size_t i = 0; i < summary->top_n; i++) {
+        const sample_t *s = &top[i];
+        fprintf(out, "  %8.3f x_0=(%8.5f | %8.5f) x_1=(%8.5f | %8.5f) t=%12ld r_i_u_0=0x%016lx r_i_u_1=0x%016lx r_i_u_2=0x%016lx\n",
+                s->error, s->x[0], s->x_[0], s->x[1], s->x_[1], s->time, s->u[0], s->u[1], s->u[2]);
+    }
+    free(top);
+
+    fprintf(out, "\nattribution, at most %d bins per unit by max error\n", PRINT_BINS);
+    print_bins(out, SUMMARY_LN, summary->ln, SUMMARY_LN_BINS);
+    print_bins(out, SUMMARY_F, summary->f, SUMMARY_F_BINS);
+    print_bins(out, SUMMARY_TRIG, summary->trig, SUMMARY_TRIG_BINS);
+
+    // Quadrants, from the trig segments
+    fprintf(out, "  %-14s %12s %12s %10s\n", "trig quadrant", "samples", "failing", "max ulp");
+    for (int q = 0; q < 4; q++) {
+        summary_bin_t quad = { 0 };
+        for (int i = 0; i < SUMMARY_TRIG_BINS / 4; i++)
+            bins_merge(&quad, &summary->trig[q * SUMMARY_TRIG_BINS / 4 + i], 1);
+        fprintf(out, "  %14d %12lu %12lu %10.3f\n", q, quad.n, quad.fails, quad.max_error);
+    }
+}
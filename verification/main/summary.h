@@ -0,0 +1,85 @@
+#ifndef HEADER_SUMMARY
+#define HEADER_SUMMARY
+
+/*
+ * Aggregated verification results, instead of one line per timeslot. Errors
+ * are max(|x_0 - x_0'|, |x_1 - x_1'|) in output lsbs (ulps, 2^-11). Every
+ * statistic is independent of the order of summary_add/summary_merge, so the
+ * summary is the same for every thread count.
+ */
+
+#define SUMMARY_ULP (1.0 / (1 << 11))
+
+// Histogram: bins of SUMMARY_HIST_STEP ulps, the last one is open
+#define SUMMARY_HIST_STEP 0.25
+#define SUMMARY_HIST_BINS 33
+
+/*
+ * Attribution of every sample to the function units of boxmuller.vhd, with
+ * the bins of reference/lib/boxmuller_errmap.c
+ *
+ *   ln    256 segments, u_2 >> 23
+ *   f     32 range reduction exponents of sqrt, exp_f + 6 of e (7,24)
+ *   trig  512 (quadrant, segment), u_1 >> 7
+ */
+typedef enum summary_unit_t {
+    SUMMARY_LN,
+    SUMMARY_F,
+    SUMMARY_TRIG,
+    SUMMARY_UNITS
+} summary_unit_t;
+
+#define SUMMARY_LN_BINS 256
+#define SUMMARY_F_BINS 32
+#define SUMMARY_TRIG_BINS 512
+
+/*
+ * One sample, also the record of the failing sample file: native byte order,
+ * 80 bytes
+ */
+typedef struct sample_t {
+    uint64_t time;
+    uint64_t u[3];      // r_i_u_0/1/2
+    double x[2];        // model
+    double x_[2];       // hardware
+    double error;       // ulps
+    uint64_t pad;
+} sample_t;
+
+typedef struct summary_bin_t {
+    uint64_t n;
+    uint64_t fails;
+    double max_error;
+} summary_bin_t;
+
+typedef struct summary_t {
+    double threshold;   // ulps, samples above fail
+    uint64_t n, fails;
+    uint64_t hist[SUMMARY_HIST_BINS];
+
+    summary_bin_t ln[SUMMARY_LN_BINS];
+    summary_bin_t f[SUMMARY_F_BINS];
+    summary_bin_t trig[SUMMARY_TRIG_BINS];
+
+    // The k worst samples, a heap with the least bad one on top
+    size_t k, top_n;
+    sample_t *top;
+} summary_t;
+
+summary_t *summary_new(size_t k, double threshold);
+
+void summary_free(summary_t *summary);
+
+/*
+ * Adds sample s, e is the model's -2 ln(u). Returns whether it failed.
+ */
+bool summary_add(summary_t *summary, const sample_t *s, double e);
+
+/*
+ * acc += b, both with the same k and threshold
+ */
+void summary_merge(summary_t *acc, const summary_t *b);
+
+void summary_print(const summary_t *summary, FILE *out);
+
+#endif
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+#include "vcd.h"
+#include "trace.h"
+
+#define HISTORY_LOG 1
+
+/*
+ * Number of vcd_next calls until the end of the body: one per timestamp, and
+ * one for changes before the first timestamp
+ */
+static uint64_t count_timeslots(const vcd_t *vcd) {
+    const char *end = vcd->map + vcd->map_size;
+    const char *p = vcd->line;
+    uint64_t n = p != end && *p != '#';
+
+    for (p = vcd_find_timeslot(vcd, p); p != end; p = vcd_find_timeslot(vcd, p + 1))
+        n++;
+    return n;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-a] <DUMP.VCD> <OUTFILE> [SIGNAL...]\n", prog);
+    fprintf(stderr, "  -a  Append the signals to OUTFILE, an existing trace of the same dump\n");
+    fprintf(stderr, "Converts the given SIGNALs, paths or names, or all signals of the dump.\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *prog = argv[0];
+    bool append = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "a")) != -1) {
+        switch (opt) {
+        case 'a':
+            append = true;
+            break;
+        default:
+            usage(prog);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind < 2) {
+        fprintf(stderr, "%s: Missing input or output file\n", prog);
+        usage(prog);
+        return EXIT_FAILURE;
+    }
+
+    const char *out_path = argv[optind + 1];
+    vcd_t *vcd = vcd_open_backend(argv[optind], HISTORY_LOG, VCD_BACKEND_MMAP);
+    if (vcd == NULL) {
+        perror("Failed to open input file");
+        return EXIT_FAILURE;
+    }
+
+    vcd_parse_header(vcd);
+    uint64_t timeslots = count_timeslots(vcd);
+
+    trace_writer_t *w = trace_writer_open(out_path, timeslots, append);
+    if (!w) {
+        perror("Failed to open output file");
+        vcd_close(vcd);
+        return EXIT_FAILURE;
+    }
+
+    // Already converted signals, when appending
+    trace_t *existing = append ? trace_open(out_path) : NULL;
+
+    bool all = optind + 2 == argc;
+    int count = all ? vcd->signal_count : argc - optind - 2;
+    int *signals = malloc(sizeof(int) * (count + 1));
+    int *columns = malloc(sizeof(int) * (count + 1));
+    int n = 0;
+    int ret = EXIT_SUCCESS;
+
+    for (int i = 0; i < count; i++) {
+        vcd_signal_t *signal = all ? &vcd->signals[i] : vcd_get_signal_by_name(vcd, argv[optind + 2 + i]);
+        if (!signal) {
+            fprintf(stderr, "%s: No signal \"%s\" in the dump\n", prog, argv[optind + 2 + i]);
+            ret = EXIT_FAILURE;
+            continue;
+        }
+
+        int j = 0;
+        while (j < n && signals[j] != signal - vcd->signals)
+            j++;
+        if (j < n)
+            continue;
+
+        if (existing && trace_get_signal(existing, signal->path)) {
+            fprintf(stderr, "%s: Skipping %s, already in %s\n", prog, signal->path, out_path);
+            continue;
+        }
+
+        vcd_watch(vcd, signal);
+        signals[n] = (int)(signal - vcd->signals);
+        columns[n++] = trace_writer_add(w, signal->path, signal->width);
+    }
+    vcd_filter(vcd, true);
+
+    if (ret == EXIT_SUCCESS && !trace_writer_map(w)) {
+        perror("Failed to map output file");
+        ret = EXIT_FAILURE;
+    }
+
+    uint64_t t = 0;
+    for (; ret == EXIT_SUCCESS && t < timeslots && vcd_has_next(vcd); t++) {
+        vcd_next(vcd);
+
+        if (existing && existing->time[t] != vcd->time) {
+            fprintf(stderr, "%s: %s is not a trace of this dump\n", prog, out_path);
+            ret = EXIT_FAILURE;
+            break;
+        }
+
+        size_t idx = vcd_get_data_idx(vcd, 0);
+        if (!existing)
+            trace_writer_set_time(w, t, vcd->time);
+        for (int i = 0; i < n; i++) {
+            const vcd_signal_t *signal = &vcd->signals[signals[i]];
+            trace_writer_set(w, columns[i], t, signal->data[idx], signal->valid[idx]);
+        }
+    }
+
+    if (ret == EXIT_SUCCESS && (t != timeslots || vcd_has_next(vcd))) {
+        fprintf(stderr, "%s: Timeslot count mismatch\n", prog);
+        ret = EXIT_FAILURE;
+    }
+
+    if (ret != EXIT_SUCCESS) {
+        trace_writer_abort(w);
+        if (!append)
+            unlink(out_path);
+    } else if (!trace_writer_close(w)) {
+        perror("Failed to write output file");
+        ret = EXIT_FAILURE;
+    }
+
+    if (ret == EXIT_SUCCESS)
+        fprintf(stderr, "%s: %d signals %s, %lu timeslots\n", out_path, n, append ? "appended" : "converted", timeslots);
+
+    if (existing)
+        trace_close(existing);
+    free(columns);
+    free(signals);
+    vcd_close(vcd);
+
+    return ret;
+}
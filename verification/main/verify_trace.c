@@ -5,32 +5,45 @@
 #include <errno.h>
 #include <string.h>
 #include <math.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/types.h>
 
 #include "vcd.h"
+#include "trace.h"
+
+#include "summary.h"
+#include "golden.h"
 
 #define MAX(a,b) ((a) > (b) ? (a) : (b))
 
-int lzd(uint64_t x, int len) {
-    x = x << (64 - len);
-    int i = 0;
-    for (; i < len; i++)
-        if (x & (1UL << 63))
-            break;
-        else
-            x <<= 1;
+#define HISTORY_LOG 6
+#define SKIP_TIMESLOTS 35
 
-    return i;
-}
+// Pipeline delays of the inputs, relative to the outputs, in timeslots
+#define DELAY_U_0 -24
+#define DELAY_U_1 -12
+#define DELAY_U_2 -33
 
-void gaussian(uint64_t u_0, uint64_t u_1, uint64_t u_2, double *out) {
-	double exp_e = lzd(u_0, 48) + 1.0;
-    double e = 2 * (log(2.0) * exp_e - log(1.0+u_2*4.656612873077393e-10));
+/*
+ * Parallel mode: the body is split at timestamps into chunks of about
+ * DEFAULT_CHUNK_BYTES (-c). Every thread owns SLOTS_PER_THREAD result slots, so
+ * workers can run ahead while the results of earlier chunks are written.
+ */
+#define DEFAULT_CHUNK_BYTES (16 << 20)
+#define SLOTS_PER_THREAD 2
 
-    double f = sqrt(e);
+// Summary mode
+#define DEFAULT_TOP_K 20
+#define DEFAULT_THRESHOLD 1.5
 
-    out[0] = sin(2*M_PI * u_1 * 1.52587890625e-05) * f;
-    out[1] = cos(2*M_PI * u_1 * 1.52587890625e-05) * f;
-}
+// Follow mode: seconds between the running statistics
+#define FOLLOW_REPORT_S 1
+
+enum { R_I_U_0, R_I_U_1, R_I_U_2, T_X_0, T_X_1, N_SIGNALS };
+
+static const char *SIGNAL_NAMES[N_SIGNALS] = { "r_i_u_0", "r_i_u_1", "r_i_u_2", "t_x_0", "t_x_1" };
 
 double signed_to_double(uint64_t x, int width) {
     int64_t x_ = x;
@@ -40,100 +53,611 @@ double signed_to_double(uint64_t x, int width) {
     return (x_ & sign_bit) ? (x_ | extended_bits) : (x_);
 }
 
-int main(int argc, char *argv[]) {
-    if (argc == 1) {
-        fprintf(stderr, "%s: Missing input file\n", argv[0]);
-        fprintf(stderr, "Usage: %s <DUMP.VCD>\n", argv[0]);
-        return EXIT_FAILURE;
+/*
+ * Samples are buffered and verified in batches, so that the model is
+ * evaluated by the vectorized golden_eval and the errors in bulk
+ */
+typedef struct batch_t {
+    size_t n;
+    uint64_t time[GOLDEN_BATCH];
+    uint64_t u[3][GOLDEN_BATCH];    // r_i_u_0/1/2
+    double x_[2][GOLDEN_BATCH];     // hardware
+    double x[2][GOLDEN_BATCH];      // model
+    double e[GOLDEN_BATCH];
+    double error[GOLDEN_BATCH];     // ulps
+    double values[2 * GOLDEN_BATCH];
+} batch_t;
+
+/*
+ * Compares the buffered samples against the model and empties the batch.
+ * Without a summary, every sample is printed to text. With one, the samples
+ * are added to it, and written to text (may be NULL) as sample_t if they
+ * failed. The model outputs are appended to dout (may be NULL), x_0 and x_1
+ * interleaved.
+ */
+static void batch_flush(batch_t *b, summary_t *summary, FILE *text, FILE *dout) {
+    size_t n = b->n;
+    b->n = 0;
+
+    golden_eval(n, b->u[0], b->u[1], b->u[2], b->x[0], b->x[1], b->e);
+
+    for (size_t i = 0; i < n; i++) {
+        b->error[i] = MAX(fabs(b->x[0][i] - b->x_[0][i]), fabs(b->x[1][i] - b->x_[1][i])) / SUMMARY_ULP;
+        b->values[2 * i] = b->x[0][i];
+        b->values[2 * i + 1] = b->x[1][i];
     }
 
-    vcd_t *vcd = vcd_open(argv[1], 6);
-    if (vcd == NULL) {
-        perror("Failed to open input file");
-        return EXIT_FAILURE;
+    for (size_t i = 0; i < n; i++) {
+        if (summary) {
+            sample_t s = {
+                .time = b->time[i],
+                .u = { b->u[0][i], b->u[1][i], b->u[2][i] },
+                .x = { b->x[0][i], b->x[1][i] },
+                .x_ = { b->x_[0][i], b->x_[1][i] },
+                .error = b->error[i],
+            };
+            if (summary_add(summary, &s, b->e[i]) && text)
+                fwrite(&s, sizeof(s), 1, text);
+            continue;
+        }
+
+        double max_error = fabs(MAX(b->x[0][i] - b->x_[0][i], b->x[1][i] - b->x_[1][i]));
+
+        fprintf(text, "%8.5f x_0=(%8.5f | %8.5f) x_1=(%8.5f | %8.5f) t=%12ld r_i_u_0=0x%016lx r_i_u_1=0x%016lx r_i_u_2=0x%016lx\n",
+            max_error,
+            b->x[0][i], b->x_[0][i], b->x[1][i], b->x_[1][i],
+            b->time[i],
+            b->u[0][i], b->u[1][i], b->u[2][i]
+            );
     }
 
-    vcd_parse_header(vcd);
+    if (dout)
+        fwrite(b->values, sizeof(double), 2 * n, dout);
+}
 
-    // puts("Signals:");
-    // for (int i = 0; i < vcd->signal_count; i++)
-    //     printf(" * %s, width=%d, symbol=%c\n",
-    //            vcd->signals[i].name, vcd->signals[i].width, vcd->signals[i].symbol);
+/*
+ * Buffers the outputs x_0, x_1 at time, for the inputs u
+ */
+static void batch_add(batch_t *b, const uint64_t *u, double x_0, double x_1, uint64_t time) {
+    size_t i = b->n++;
+    b->time[i] = time;
+    b->u[0][i] = u[0];
+    b->u[1][i] = u[1];
+    b->u[2][i] = u[2];
+    b->x_[0][i] = x_0 * 0.00048828125;
+    b->x_[1][i] = x_1 * 0.00048828125;
+}
 
-    vcd_signal_t *r_i_u_0 = vcd_get_signal_by_name(vcd, "r_i_u_0");
-    vcd_signal_t *r_i_u_1 = vcd_get_signal_by_name(vcd, "r_i_u_1");
-    vcd_signal_t *r_i_u_2 = vcd_get_signal_by_name(vcd, "r_i_u_2");
-    vcd_signal_t *t_x_0 = vcd_get_signal_by_name(vcd, "t_x_0");
-    vcd_signal_t *t_x_1 = vcd_get_signal_by_name(vcd, "t_x_1");
+/*
+ * Buffers the outputs of the current timeslot of vcd, signals are indices
+ * into vcd->signals. The batch is verified when it is full.
+ */
+static void verify_timeslot(vcd_t *vcd, const int *signals, batch_t *b, summary_t *summary, FILE *text, FILE *dout) {
+    ssize_t i = vcd_get_data_idx(vcd, 0);
+    vcd_signal_t *t_x_0 = &vcd->signals[signals[T_X_0]];
+    vcd_signal_t *t_x_1 = &vcd->signals[signals[T_X_1]];
+
+    uint64_t u[3] = {
+        vcd->signals[signals[R_I_U_0]].data[vcd_get_data_idx(vcd, DELAY_U_0)],
+        vcd->signals[signals[R_I_U_1]].data[vcd_get_data_idx(vcd, DELAY_U_1)],
+        vcd->signals[signals[R_I_U_2]].data[vcd_get_data_idx(vcd, DELAY_U_2)],
+    };
+
+    batch_add(b, u, signed_to_double(t_x_0->data[i], t_x_0->width), signed_to_double(t_x_1->data[i], t_x_1->width),
+            vcd->time);
+    if (b->n == GOLDEN_BATCH)
+        batch_flush(b, summary, text, dout);
+}
 
-    puts("");
+/*
+ * Trace mode: the same comparisons, on the columns of a trace from vcd2trace.
+ * Timeslot t of the trace is the t-th vcd_next, so there is no history ring.
+ */
+static int verify_trace_file(const char *prog, trace_t *trace, summary_t *summary, FILE *text, FILE *dout) {
+    const trace_signal_t *signals[N_SIGNALS];
+    for (int i = 0; i < N_SIGNALS; i++) {
+        signals[i] = trace_get_signal(trace, SIGNAL_NAMES[i]);
+        if (!signals[i]) {
+            fprintf(stderr, "%s: Failed to acquire one or more required signals. "
+                            "The required signals are: [r_i_u_0, r_i_u_1, r_i_u_2, t_x_0, t_x_1]\n",
+                            prog);
+            return -1;
+        }
+    }
 
-    if (r_i_u_0 == NULL || r_i_u_1 == NULL || r_i_u_2 == NULL || t_x_0 == NULL || t_x_1 == NULL) {
-        fprintf(stderr, "%s: Failed to acquire one or more required signals. "
-                        "The required signals are: [r_i_u_0, r_i_u_1, r_i_u_2, t_x_0, t_x_1]\n",
-                        argv[0]);
-        return EXIT_FAILURE;
+    batch_t *b = malloc(sizeof(batch_t));
+    b->n = 0;
+
+    for (uint64_t t = SKIP_TIMESLOTS; t < trace->timeslots; t++) {
+        uint64_t u[3] = {
+            trace_value(signals[R_I_U_0], t + DELAY_U_0),
+            trace_value(signals[R_I_U_1], t + DELAY_U_1),
+            trace_value(signals[R_I_U_2], t + DELAY_U_2),
+        };
+
+        batch_add(b, u, signed_to_double(trace_value(signals[T_X_0], t), signals[T_X_0]->width),
+                signed_to_double(trace_value(signals[T_X_1], t), signals[T_X_1]->width), trace->time[t]);
+        if (b->n == GOLDEN_BATCH)
+            batch_flush(b, summary, text, dout);
     }
 
-    vcd_skip(vcd, 35);
+    batch_flush(b, summary, text, dout);
+    free(b);
+
+    return 0;
+}
+
+typedef struct chunk_t {
+    char *text;
+    size_t text_len;
+    char *values;               // doubles
+    size_t values_len;
+    summary_t *summary;
+    bool done;
+} chunk_t;
+
+typedef struct parallel_t {
+    pthread_mutex_t lock;
+    pthread_cond_t slot_free;   // signalled by the writer
+    pthread_cond_t slot_done;   // signalled by the workers
+
+    const vcd_t *vcd;
+    const int *signals;
+    bool values;                // whether to keep the model outputs
+    bool text;                  // whether to keep the text (or failing samples)
+    summary_t *summary;         // merged by the writer, NULL for text output
+
+    const char **bounds;        // chunk i is [bounds[i], bounds[i + 1])
+    size_t chunks, slots;
+    size_t next_chunk;          // next chunk to be claimed by a worker
+    size_t next_write;          // next chunk to be written
+    bool abort;
+    chunk_t *slot;
+} parallel_t;
+
+/*
+ * Whether the watched signals all changed since the last vcd_seek
+ */
+static bool signals_known(const vcd_t *vcd, const int *signals) {
+    for (int i = 0; i < N_SIGNALS; i++)
+        if (vcd->signals[signals[i]].timeslot < 0)
+            return false;
+    return true;
+}
+
+/*
+ * Verifies chunk i on its own cursor. Chunk 0 starts like the sequential mode.
+ * Every other chunk is preceded by a warm-up: at least history_length
+ * timeslots to fill the history rings, after all signals changed at least
+ * once. The results are therefore the same as in the sequential mode.
+ */
+static void verify_chunk(const parallel_t *ctx, size_t i, chunk_t *chunk) {
+    const vcd_t *vcd = ctx->vcd;
+    const char *begin = ctx->bounds[i], *end = ctx->bounds[i + 1];
+    vcd_t *fork = vcd_fork(vcd);
+
+    if (i == 0) {
+        vcd_seek(fork, begin, end);
+        vcd_skip(fork, SKIP_TIMESLOTS);
+    } else {
+        for (size_t warmup = 2 * vcd->history_length;; warmup *= 4) {
+            const char *start = vcd_rewind_timeslots(vcd, begin, warmup);
+            vcd_seek(fork, start, end);
+
+            bool known = start == vcd->body;
+            for (size_t n = 0; fork->line < begin && vcd_has_next(fork); n++) {
+                if (n == warmup - vcd->history_length)
+                    known |= signals_known(fork, ctx->signals);
+                vcd_next(fork);
+            }
+
+            if (known)
+                break;
+        }
+    }
+
+    FILE *text = ctx->text ? open_memstream(&chunk->text, &chunk->text_len) : NULL;
+    FILE *values = ctx->values ? open_memstream(&chunk->values, &chunk->values_len) : NULL;
+    if (ctx->summary)
+        chunk->summary = summary_new(ctx->summary->k, ctx->summary->threshold);
+
+    batch_t *b = malloc(sizeof(batch_t));
+    b->n = 0;
 
-    double ulp = 1.0 / (1 << 11);
+    while (vcd_has_next(fork)) {
+        vcd_next(fork);
+        verify_timeslot(fork, ctx->signals, b, chunk->summary, text, values);
+    }
+    batch_flush(b, chunk->summary, text, values);
+    free(b);
+
+    if (text)
+        fclose(text);
+    if (values)
+        fclose(values);
+    vcd_close(fork);
+}
+
+static void *worker(void *p) {
+    parallel_t *ctx = p;
+
+    pthread_mutex_lock(&ctx->lock);
+    for (;;) {
+        while (!ctx->abort && ctx->next_chunk < ctx->chunks && ctx->next_chunk - ctx->next_write >= ctx->slots)
+            pthread_cond_wait(&ctx->slot_free, &ctx->lock);
+
+        if (ctx->abort || ctx->next_chunk >= ctx->chunks)
+            break;
+
+        size_t i = ctx->next_chunk++;
+        chunk_t *chunk = &ctx->slot[i % ctx->slots];
+        pthread_mutex_unlock(&ctx->lock);
+
+        verify_chunk(ctx, i, chunk);
+
+        pthread_mutex_lock(&ctx->lock);
+        chunk->done = true;
+        pthread_cond_broadcast(&ctx->slot_done);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    return NULL;
+}
+
+/*
+ * Like the sequential mode, text and summary as for batch_flush. Returns 0
+ * on success, -1 if writing dout failed or no thread could be started.
+ */
+static int verify_parallel(const vcd_t *vcd, const int *signals, int threads, size_t chunk_bytes, summary_t *summary,
+        FILE *text, FILE *dout) {
+    parallel_t ctx = {
+        .vcd = vcd,
+        .signals = signals,
+        .values = dout != NULL,
+        .text = text != NULL,
+        .summary = summary,
+        .slots = (size_t) threads * SLOTS_PER_THREAD,
+    };
+
+    // Chunk boundaries at the first timestamp after every chunk_bytes
+    const char *end = vcd->map + vcd->map_size;
+    size_t cap = 16;
+    ctx.bounds = malloc(sizeof(char *) * cap);
+    ctx.bounds[0] = vcd->body;
+    for (const char *p = vcd->body; p != end;) {
+        p = (size_t)(end - p) > chunk_bytes ? vcd_find_timeslot(vcd, p + chunk_bytes) : end;
+        if (ctx.chunks + 2 > cap) {
+            cap *= 2;
+            ctx.bounds = realloc(ctx.bounds, sizeof(char *) * cap);
+        }
+        ctx.bounds[++ctx.chunks] = p;
+    }
+
+    ctx.slot = calloc(ctx.slots, sizeof(chunk_t));
+    pthread_t *pool = malloc(threads * sizeof(pthread_t));
+
+    pthread_mutex_init(&ctx.lock, NULL);
+    pthread_cond_init(&ctx.slot_free, NULL);
+    pthread_cond_init(&ctx.slot_done, NULL);
+
+    int started = 0;
+    for (; started < threads; started++)
+        if (pthread_create(&pool[started], NULL, worker, &ctx))
+            break;
+
+    int ret = started ? 0 : -1;
+
+    // The calling thread writes the finished chunks in order
+    for (size_t i = 0; i < ctx.chunks && !ret; i++) {
+        chunk_t *chunk = &ctx.slot[i % ctx.slots];
+
+        pthread_mutex_lock(&ctx.lock);
+        while (!chunk->done)
+            pthread_cond_wait(&ctx.slot_done, &ctx.lock);
+        pthread_mutex_unlock(&ctx.lock);
+
+        if (text)
+            fwrite(chunk->text, 1, chunk->text_len, text);
+        if (dout && fwrite(chunk->values, 1, chunk->values_len, dout) != chunk->values_len)
+            ret = -1;
+        if (summary) {
+            summary_merge(summary, chunk->summary);
+            summary_free(chunk->summary);
+        }
+
+        free(chunk->text);
+        free(chunk->values);
+
+        pthread_mutex_lock(&ctx.lock);
+        memset(chunk, 0, sizeof(*chunk));
+        ctx.next_write++;
+        ctx.abort = ret != 0;
+        pthread_cond_broadcast(&ctx.slot_free);
+        pthread_mutex_unlock(&ctx.lock);
+    }
+
+    for (int t = 0; t < started; t++)
+        pthread_join(pool[t], NULL);
+
+    // Chunks finished after an abort
+    for (size_t i = 0; i < ctx.slots; i++) {
+        free(ctx.slot[i].text);
+        free(ctx.slot[i].values);
+        if (ctx.slot[i].summary)
+            summary_free(ctx.slot[i].summary);
+    }
+
+    pthread_cond_destroy(&ctx.slot_done);
+    pthread_cond_destroy(&ctx.slot_free);
+    pthread_mutex_destroy(&ctx.lock);
+
+    free(pool);
+    free(ctx.slot);
+    free(ctx.bounds);
+
+    return ret;
+}
 
+/*
+ * Follow mode: the dump is verified while the simulation writes it. Whenever
+ * the parser catches up and waits, the buffered samples are verified and the
+ * running statistics are printed, at most every FOLLOW_REPORT_S seconds.
+ */
+typedef struct follow_t {
+    const vcd_t *vcd;
+    batch_t *b;
+    summary_t *summary;
+    FILE *text;
     FILE *dout;
-    double dout_buffer[1024];
-    size_t dout_i = 0;
-    if (argc == 3) {
-        dout = fopen(argv[2], "w");
-        if (!dout) {
-            perror("Failed to open output file");
-            return EXIT_FAILURE;
+    time_t last_report;
+} follow_t;
+
+static void follow_report(follow_t *f) {
+    const summary_t *s = f->summary;
+    double max_error = 0;
+    for (size_t i = 0; i < s->top_n; i++)
+        max_error = MAX(max_error, s->top[i].error);
+
+    fprintf(stderr, "t=%lu: %lu samples, %lu failed, max error %.3f ulps\n", f->vcd->time, s->n, s->fails,
+            max_error);
+    f->last_report = time(NULL);
+}
+
+// on_wait of the followed vcd, stops at the first failing sample
+static bool follow_wait(void *arg) {
+    follow_t *f = arg;
+
+    batch_flush(f->b, f->summary, f->text, f->dout);
+    if (f->dout)
+        fflush(f->dout);
+    if (f->summary->fails)
+        return false;
+
+    if (time(NULL) - f->last_report >= FOLLOW_REPORT_S)
+        follow_report(f);
+    return true;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-j THREADS] [-c BYTES] [-s] [-k K] [-t ULPS] [-f FAILFILE] [-F] [-i SECONDS] <DUMP.VCD | TRACE> [OUTFILE]\n", prog);
+    fprintf(stderr, "  -j THREADS   Verify chunks of the dump on THREADS threads, default 1. The output is the same\n");
+    fprintf(stderr, "               for every thread count. Requires a regular (mappable) input file.\n");
+    fprintf(stderr, "  -c BYTES     Size of the chunks of -j, default %d MiB\n", DEFAULT_CHUNK_BYTES >> 20);
+    fprintf(stderr, "  -s           Print a summary instead of every sample: error histogram, worst samples and\n");
+    fprintf(stderr, "               errors by ln segment, sqrt exponent and trig quadrant/segment\n");
+    fprintf(stderr, "  -k K         Worst samples in the summary, default %d\n", DEFAULT_TOP_K);
+    fprintf(stderr, "  -t ULPS      Samples with larger errors fail, default %.1f\n", DEFAULT_THRESHOLD);
+    fprintf(stderr, "  -f FAILFILE  Write the failing samples to FAILFILE, as records of sample_t (see summary.h)\n");
+    fprintf(stderr, "  -F           Follow a dump that is still being written, printing running statistics, and\n");
+    fprintf(stderr, "               stop at the first failing sample. The dump ends when the writer closes it.\n");
+    fprintf(stderr, "  -i SECONDS   With -F, also end the dump after SECONDS without new data, default %d\n",
+            VCD_FOLLOW_IDLE_MS / 1000);
+    fprintf(stderr, "-k, -t, -f and -F imply -s, -i implies -F.\n");
+    fprintf(stderr, "TRACE is a dump converted by vcd2trace, it is mapped and needs no parsing (-j is ignored).\n");
+    fprintf(stderr, "OUTFILE receives the model outputs as doubles.\n");
+}
+
+/*
+ * Returns 0 on success, -1 on failure, after printing the reason, and 1 if a
+ * followed dump (idle_ms > 0) was stopped at a failing sample
+ */
+static int verify_vcd(const char *prog, const char *path, int threads, size_t chunk_bytes, int idle_ms,
+        summary_t *summary, FILE *text, FILE *dout) {
+    vcd_t *vcd = idle_ms ? vcd_open_backend((char *) path, HISTORY_LOG, VCD_BACKEND_FOLLOW)
+        : vcd_open((char *) path, HISTORY_LOG);
+    if (vcd == NULL) {
+        perror("Failed to open input file");
+        return -1;
+    }
+
+    vcd_parse_header(vcd);
+
+    int signals[N_SIGNALS];
+    for (int i = 0; i < N_SIGNALS; i++) {
+        vcd_signal_t *signal = vcd_get_signal_by_name(vcd, (char *) SIGNAL_NAMES[i]);
+        signals[i] = signal ? (int)(signal - vcd->signals) : -1;
+    }
+
+    for (int i = 0; i < N_SIGNALS; i++) {
+        if (signals[i] < 0) {
+            fprintf(stderr, "%s: Failed to acquire one or more required signals. "
+                            "The required signals are: [r_i_u_0, r_i_u_1, r_i_u_2, t_x_0, t_x_1]\n",
+                            prog);
+            vcd_close(vcd);
+            return -1;
         }
     }
 
+    // The other signals of the dump are not needed
+    vcd_filter(vcd, true);
 
-    while (vcd_has_next(vcd)) {
-        vcd_next(vcd);
+    if (threads > 1 && vcd->backend != VCD_BACKEND_MMAP) {
+        fprintf(stderr, "%s: Input is %s, verifying on one thread\n", prog,
+                idle_ms ? "followed" : "not a regular file");
+        threads = 1;
+    }
 
-        ssize_t i = vcd_get_data_idx(vcd, 0);
-        ssize_t i_u_0 = vcd_get_data_idx(vcd, -24);
-        ssize_t i_u_1 = vcd_get_data_idx(vcd, -12);
-        ssize_t i_u_2 = vcd_get_data_idx(vcd, -33);
+    int ret = 0;
 
-        double x[2];
-        gaussian(r_i_u_0->data[i_u_0], r_i_u_1->data[i_u_1], r_i_u_2->data[i_u_2], x);
+    if (threads > 1) {
+        fflush(stdout);
+        if (verify_parallel(vcd, signals, threads, chunk_bytes, summary, text, dout)) {
+            perror("Failed to verify in parallel");
+            ret = -1;
+        }
+    } else {
+        batch_t *b = malloc(sizeof(batch_t));
+        b->n = 0;
 
-        if (dout) {
-            dout_buffer[dout_i++] = x[0];
-            dout_buffer[dout_i++] = x[1];
+        follow_t follow = { vcd, b, summary, text, dout, time(NULL) };
+        if (idle_ms)
+            vcd_follow(vcd, idle_ms, follow_wait, &follow);
 
-            if (dout_i >= sizeof(dout_buffer) / sizeof(*dout_buffer)) {
-                fwrite(dout_buffer, sizeof(*dout_buffer), dout_i, dout);
-                dout_i = 0;
+        vcd_skip(vcd, SKIP_TIMESLOTS);
+
+        while (vcd_has_next(vcd) && !(idle_ms && summary->fails)) {
+            vcd_next(vcd);
+            verify_timeslot(vcd, signals, b, summary, text, dout);
+        }
+
+        batch_flush(b, summary, text, dout);
+        free(b);
+
+        if (idle_ms) {
+            follow_report(&follow);
+            if (summary->fails) {
+                fprintf(stderr, "%s: Stopped at the first failing sample\n", prog);
+                ret = 1;
             }
         }
+    }
 
-        double x_[2] = { signed_to_double(t_x_0->data[i], t_x_0->width) * 0.00048828125, signed_to_double(t_x_1->data[i], t_x_1->width) * .00048828125 };
+    vcd_close(vcd);
 
-        double max_error = fabs(MAX(x[0] - x_[0], x[1] - x_[1]));
+    return ret;
+}
 
-        if (max_error > 1.5 * ulp || 1)
-            printf("%8.5f x_0=(%8.5f | %8.5f) x_1=(%8.5f | %8.5f) t=%12ld r_i_u_0=0x%016lx r_i_u_1=0x%016lx r_i_u_2=0x%016lx\n",
-                max_error,
-                x[0], x_[0], x[1], x_[1],
-                vcd->time,
-                r_i_u_0->data[i_u_0], r_i_u_1->data[i_u_1], r_i_u_2->data[i_u_2]
-                );
+int main(int argc, char *argv[]) {
+    const char *prog = argv[0];
+    int threads = 1;
+    size_t chunk_bytes = DEFAULT_CHUNK_BYTES;
+    bool summarize = false;
+    int top_k = DEFAULT_TOP_K;
+    double threshold = DEFAULT_THRESHOLD;
+    const char *fail_path = NULL;
+    int idle_ms = 0;
+    int idle_s;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "j:c:sk:t:f:Fi:")) != -1) {
+        switch (opt) {
+        case 'j':
+            if (sscanf(optarg, "%d", &threads) < 1 || threads < 1) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as thread count!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'c':
+            if (sscanf(optarg, "%zu", &chunk_bytes) < 1 || chunk_bytes < 1) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as chunk size!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 's':
+            summarize = true;
+            break;
+        case 'k':
+            if (sscanf(optarg, "%d", &top_k) < 1 || top_k < 0) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as sample count!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            summarize = true;
+            break;
+        case 't':
+            if (sscanf(optarg, "%lf", &threshold) < 1 || !(threshold >= 0)) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as threshold!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            summarize = true;
+            break;
+        case 'f':
+            fail_path = optarg;
+            summarize = true;
+            break;
+        case 'F':
+            idle_ms = idle_ms ? idle_ms : VCD_FOLLOW_IDLE_MS;
+            summarize = true;
+            break;
+        case 'i':
+            if (sscanf(optarg, "%d", &idle_s) < 1 || idle_s < 1 || idle_s > INT32_MAX / 1000) {
+                fprintf(stderr, "%s: Invalid argument, failed to interpret \"%s\" as seconds!\n", prog, optarg);
+                return EXIT_FAILURE;
+            }
+            idle_ms = idle_s * 1000;
+            summarize = true;
+            break;
+        default:
+            usage(prog);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind == argc) {
+        fprintf(stderr, "%s: Missing input file\n", prog);
+        usage(prog);
+        return EXIT_FAILURE;
+    }
 
+    const char *path = argv[optind];
+    trace_t *trace = NULL;
+    if (!idle_ms && trace_probe(path) && !(trace = trace_open(path))) {
+        perror("Failed to open input file");
+        return EXIT_FAILURE;
     }
 
+    puts("");
 
-    if (dout) {
-        fwrite(dout_buffer, sizeof(*dout_buffer), dout_i, dout);
-        fclose(dout);
+    FILE *dout = NULL;
+    if (argc - optind >= 2) {
+        dout = fopen(argv[optind + 1], "w");
+        if (!dout) {
+            perror("Failed to open output file");
+            return EXIT_FAILURE;
+        }
     }
-    
 
-    vcd_close(vcd);
-    
-    return EXIT_SUCCESS;
+    // Per sample text, or the failing samples of the summary
+    FILE *text = summarize ? NULL : stdout;
+    if (fail_path) {
+        text = fopen(fail_path, "w");
+        if (!text) {
+            perror("Failed to open fail file");
+            return EXIT_FAILURE;
+        }
+    }
+
+    summary_t *summary = summarize ? summary_new(top_k, threshold) : NULL;
+
+    int ret;
+    if (trace) {
+        ret = verify_trace_file(prog, trace, summary, text, dout);
+        trace_close(trace);
+    } else {
+        ret = verify_vcd(prog, path, threads, chunk_bytes, idle_ms, summary, text, dout);
+    }
+
+    if (summary) {
+        if (ret >= 0)
+            summary_print(summary, stdout);
+        summary_free(summary);
+    }
+
+    if (fail_path && fclose(text)) {
+        perror("Failed to write fail file");
+        ret = -1;
+    }
+    if (dout)
+        fclose(dout);
+
+    return ret ? EXIT_FAILURE : EXIT_SUCCESS;
 }
@@ -0,0 +1,111 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <check.h>
+
+#include <golden.h>
+
+/*
+ * golden_eval against golden_libm on every u_1, every lzd(u_0) and random u_2
+ * with the extremes, and the instruction sets against each other
+ */
+
+#define SAMPLES (1 << 16)
+
+// A few double ulps of e <= 2 ln(2) 49 ~ 68, the measured maximum is ~1.4e-14
+#define MAX_ERROR 1e-13
+
+typedef struct golden_case_t {
+    uint64_t u[3][SAMPLES];
+    double x_0[SAMPLES];
+    double x_1[SAMPLES];
+    double e[SAMPLES];
+} golden_case_t;
+
+static golden_case_t *c;
+
+static uint64_t next_rand(uint64_t *x) {
+    // splitmix64
+    uint64_t z = (*x += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+void setup(void) {
+    uint64_t seed = 1;
+
+    c = malloc(sizeof(golden_case_t));
+    for (size_t i = 0; i < SAMPLES; i++) {
+        int lzd = i % 49;
+        c->u[0][i] = lzd == 48 ? 0 : (1ull << (47 - lzd)) | (next_rand(&seed) & ((1ull << (47 - lzd)) - 1));
+        c->u[1][i] = i;
+        c->u[2][i] = i < 2 ? i * 0x7FFFFFFF : next_rand(&seed) & 0x7FFFFFFF;
+    }
+
+    ck_assert(golden_set_isa(GOLDEN_ISA_SCALAR));
+    golden_eval(SAMPLES, c->u[0], c->u[1], c->u[2], c->x_0, c->x_1, c->e);
+}
+
+void teardown(void) {
+    free(c);
+}
+
+START_TEST(test_golden_libm) {
+    double max_x = 0, max_e = 0;
+
+    for (size_t i = 0; i < SAMPLES; i++) {
+        double x[2], e;
+        golden_libm(c->u[0][i], c->u[1][i], c->u[2][i], x, &e);
+        max_x = fmax(max_x, fmax(fabs(x[0] - c->x_0[i]), fabs(x[1] - c->x_1[i])));
+        max_e = fmax(max_e, fabs(e - c->e[i]));
+    }
+
+    ck_assert_double_le(max_x, MAX_ERROR);
+    ck_assert_double_le(max_e, MAX_ERROR);
+}
+END_TEST
+
+START_TEST(test_golden_isa) {
+    static double x_0[SAMPLES], x_1[SAMPLES], e[SAMPLES];
+
+    if (!golden_set_isa(GOLDEN_ISA_AVX2))
+        return;
+
+    golden_eval(SAMPLES, c->u[0], c->u[1], c->u[2], x_0, x_1, e);
+    ck_assert_mem_eq(x_0, c->x_0, sizeof(x_0));
+    ck_assert_mem_eq(x_1, c->x_1, sizeof(x_1));
+    ck_assert_mem_eq(e, c->e, sizeof(e));
+}
+END_TEST
+
+Suite *make_golden_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Golden Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_golden_libm);
+    tcase_add_test(tc_core, test_golden_isa);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_golden_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_golden.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
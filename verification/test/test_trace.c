@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <check.h>
+
+#include <trace.h>
+
+#define TRACE_FILE "test_trace.trace"
+#define TIMESLOTS 100
+
+// Each byte count of the columns, at both ends of its widths
+static const int widths[] = { 1, 8, 9, 16, 17, 32, 33, 64 };
+static const int bytes[] = { 1, 1, 2, 2, 4, 4, 8, 8 };
+#define SIGNALS (int)(sizeof(widths) / sizeof(widths[0]))
+
+static uint64_t value_of(int i, uint64_t t) {
+    uint64_t x = (i + 1) * 0x9E3779B97F4A7C15 ^ t * 0xBF58476D1CE4E5B9;
+    return widths[i] == 64 ? x : x & ((1ULL << widths[i]) - 1);
+}
+
+static bool valid_of(int i, uint64_t t) {
+    return (t + i) % 3 != 0;
+}
+
+// Signals first..first + n - 1 of widths, named tb.s<i>
+static bool write_signals(const char *path, int first, int n, bool append) {
+    trace_writer_t *w = trace_writer_open(path, TIMESLOTS, append);
+    ck_assert_ptr_nonnull(w);
+
+    int columns[SIGNALS];
+    for (int i = first; i < first + n; i++) {
+        char name[16];
+        sprintf(name, "tb.s%d", i);
+        columns[i] = trace_writer_add(w, name, widths[i]);
+    }
+    ck_assert(trace_writer_map(w));
+
+    for (uint64_t t = 0; t < TIMESLOTS; t++) {
+        if (!append)
+            trace_writer_set_time(w, t, 10 * t);
+        for (int i = first; i < first + n; i++)
+            trace_writer_set(w, columns[i], t, value_of(i, t), valid_of(i, t));
+    }
+
+    return trace_writer_close(w);
+}
+
+static void check_signals(trace_t *trace, int n) {
+    ck_assert_uint_eq(trace->timeslots, TIMESLOTS);
+    ck_assert_int_eq(trace->signal_count, n);
+
+    for (uint64_t t = 0; t < TIMESLOTS; t++)
+        ck_assert_uint_eq(trace->time[t], 10 * t);
+
+    for (int i = 0; i < n; i++) {
+        char name[16];
+        sprintf(name, "tb.s%d", i);
+        trace_signal_t *signal = trace_get_signal(trace, name);
+        ck_assert_ptr_eq(signal, &trace->signals[i]);
+        ck_assert_ptr_eq(trace_get_signal(trace, name + 3), signal);
+        ck_assert_int_eq(signal->width, widths[i]);
+        ck_assert_int_eq(signal->bytes, bytes[i]);
+
+        for (uint64_t t = 0; t < TIMESLOTS; t++) {
+            ck_assert_uint_eq(trace_value(signal, t), value_of(i, t));
+            ck_assert(trace_valid(signal, t) == valid_of(i, t));
+        }
+    }
+}
+
+static void read_header(trace_header_t *header) {
+    int fd = open(TRACE_FILE, O_RDONLY);
+    ck_assert_int_eq(pread(fd, header, sizeof(*header), 0), sizeof(*header));
+    close(fd);
+}
+
+static void write_header(const trace_header_t *header) {
+    int fd = open(TRACE_FILE, O_WRONLY);
+    ck_assert_int_eq(pwrite(fd, header, sizeof(*header), 0), sizeof(*header));
+    close(fd);
+}
+
+static void check_invalid(const char *path) {
+    errno = 0;
+    ck_assert_ptr_null(trace_open(path));
+    ck_assert_int_eq(errno, EINVAL);
+}
+
+START_TEST(test_trace_roundtrip) {
+    ck_assert(write_signals(TRACE_FILE, 0, SIGNALS, false));
+    ck_assert(trace_probe(TRACE_FILE));
+
+    trace_t *trace = trace_open(TRACE_FILE);
+    ck_assert_ptr_nonnull(trace);
+    check_signals(trace, SIGNALS);
+    ck_assert_ptr_null(trace_get_signal(trace, "s99"));
+    trace_close(trace);
+}
+END_TEST
+
+START_TEST(test_trace_append) {
+    ck_assert(write_signals(TRACE_FILE, 0, 3, false));
+    ck_assert(write_signals(TRACE_FILE, 3, SIGNALS - 3, true));
+
+    trace_t *trace = trace_open(TRACE_FILE);
+    ck_assert_ptr_nonnull(trace);
+    check_signals(trace, SIGNALS);
+    trace_close(trace);
+
+    // Only with the same number of timeslots
+    errno = 0;
+    ck_assert_ptr_null(trace_writer_open(TRACE_FILE, TIMESLOTS + 1, true));
+    ck_assert_int_eq(errno, EINVAL);
+
+    // Aborting keeps the old signals
+    trace_writer_t *w = trace_writer_open(TRACE_FILE, TIMESLOTS, true);
+    ck_assert_ptr_nonnull(w);
+    trace_writer_add(w, "tb.discarded", 8);
+    ck_assert(trace_writer_map(w));
+    trace_writer_abort(w);
+
+    trace = trace_open(TRACE_FILE);
+    ck_assert_ptr_nonnull(trace);
+    check_signals(trace, SIGNALS);
+    trace_close(trace);
+}
+END_TEST
+
+START_TEST(test_trace_invalid) {
+    trace_header_t header, bad;
+
+    errno = 0;
+    ck_assert_ptr_null(trace_open("test_trace.missing"));
+    ck_assert_int_eq(errno, ENOENT);
+
+    // Empty
+    fclose(fopen(TRACE_FILE, "w"));
+    ck_assert(!trace_probe(TRACE_FILE));
+    check_invalid(TRACE_FILE);
+
+    // Never closed, so without a directory
+    trace_writer_t *w = trace_writer_open(TRACE_FILE, TIMESLOTS, false);
+    trace_writer_add(w, "tb.s0", widths[0]);
+    ck_assert(trace_writer_map(w));
+    trace_writer_abort(w);
+    ck_assert(trace_probe(TRACE_FILE));
+    check_invalid(TRACE_FILE);
+
+    // tb.s0 is the last name, 5 characters padded to 8
+    ck_assert(write_signals(TRACE_FILE, 0, 1, false));
+    read_header(&header);
+
+    bad = header;
+    bad.magic[0] = 'X';
+    write_header(&bad);
+    ck_assert(!trace_probe(TRACE_FILE));
+    check_invalid(TRACE_FILE);
+
+    bad = header;
+    bad.version = TRACE_VERSION + 1;
+    write_header(&bad);
+    check_invalid(TRACE_FILE);
+
+    bad = header;
+    bad.timeslots = header.dir_offset;
+    write_header(&bad);
+    check_invalid(TRACE_FILE);
+
+    // The name fits in the directory, its padding does not
+    bad = header;
+    bad.dir_size = header.dir_size - 3;
+    write_header(&bad);
+    check_invalid(TRACE_FILE);
+
+    bad = header;
+    bad.dir_size = sizeof(uint32_t) + sizeof(trace_dir_entry_t) - 1;
+    write_header(&bad);
+    check_invalid(TRACE_FILE);
+
+    write_header(&header);
+    trace_t *trace = trace_open(TRACE_FILE);
+    ck_assert_ptr_nonnull(trace);
+    trace_close(trace);
+
+    // Truncated in the directory
+    ck_assert_int_eq(truncate(TRACE_FILE, header.dir_offset + 8), 0);
+    check_invalid(TRACE_FILE);
+}
+END_TEST
+
+Suite *make_trace_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Trace Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_test(tc_core, test_trace_roundtrip);
+    tcase_add_test(tc_core, test_trace_append);
+    tcase_add_test(tc_core, test_trace_invalid);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_trace_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_trace.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
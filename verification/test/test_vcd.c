@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <check.h>
+
+#include <vcd.h>
+
+#define VCD_FILE "test_vcd.vcd"
+#define TIMESLOTS 4
+
+/*
+ * Signals of the test dump in declaration order: b, c and g share one id, f
+ * is never watched. The identifiers of every signal, per lookup variant.
+ */
+enum { A, B, C, G, D, E, F, SIGNALS };
+
+typedef struct id_variant_t {
+    const char *name;
+    const char *ids[SIGNALS];
+    bool radix;
+    bool radix_msb_first;
+} id_variant_t;
+
+static const id_variant_t variants[] = {
+    // "!#" is 96 with the first character most significant, 282 otherwise
+    { "radix msb first", { "!", "\"", "\"", "\"", "!#", "#", "$" }, true, true },
+    { "radix lsb first", { "!", "\"", "\"", "\"", "#!", "#", "$" }, true, false },
+    // 3 and 4 characters are too sparse for the table, 5 don't fit at all
+    { "hash", { "!", "%%%", "%%%", "%%%", "~~~~", "ab", "long5" }, false, false },
+};
+
+static const char *paths[SIGNALS] = { "tb.a", "tb.b", "tb.uut.c", "tb.uut.g", "tb.d", "tb.e", "tb.f" };
+
+typedef struct expected_t {
+    uint64_t data;
+    bool valid;
+} expected_t;
+
+// Watched signals carry their value forward, f only has one where it changes
+static const expected_t expected[TIMESLOTS][SIGNALS] = {
+    { { 0, true }, { 0, true }, { 0, true }, { 0, true }, { 0, true }, { 0, false }, { 0, true } },
+    { { 1, true }, { 0xB3, true }, { 0xB3, true }, { 0xB3, true }, { 0xFFFFFFFFFFFFFFFE, true }, { 0, false },
+      { 1, true } },
+    { { 0, false }, { 0xB3, true }, { 0xB3, true }, { 0xB3, true }, { 0xFFFFFFFFFFFFFFFE, true }, { 1, true },
+      { 0, false } },
+    { { 0, false }, { 0xB3, true }, { 0xB3, true }, { 0xB3, true }, { 0, true }, { 1, true }, { 0, true } },
+};
+
+static const uint64_t times[TIMESLOTS] = { 0, 10, 20, 30 };
+
+// The last line has no newline, with crlf the others end in \r\n
+static void write_vcd(const id_variant_t *v, bool crlf) {
+    const char *const *id = v->ids;
+    char *text;
+    size_t size;
+    FILE *f = open_memstream(&text, &size);
+
+    fprintf(f, "$date\n   today\n$end\n$version\n   test\n$end\n$timescale\n   1ps\n$end\n");
+    fprintf(f, "$scope module tb $end\n");
+    fprintf(f, "$var wire 1 %s a $end\n", id[A]);
+    fprintf(f, "$var wire 8 %s b $end\n", id[B]);
+    fprintf(f, "$scope module uut $end\n");
+    fprintf(f, "$var wire 8 %s c $end\n", id[C]);
+    fprintf(f, "$var wire 8 %s g $end\n", id[G]);
+    fprintf(f, "$upscope $end\n");
+    fprintf(f, "$var wire 64 %s d $end\n", id[D]);
+    fprintf(f, "$var wire 4 %s e $end\n", id[E]);
+    fprintf(f, "$var wire 1 %s f $end\n", id[F]);
+    fprintf(f, "$upscope $end\n$enddefinitions $end\n");
+
+    fprintf(f, "#0\n$dumpvars\n0%s\nb0 %s\nb0 %s\nbxxxx %s\n0%s\n$end\n", id[A], id[B], id[D], id[E], id[F]);
+    fprintf(f, "#10\n1%s\nb10110011 %s\n", id[A], id[B]);
+    fprintf(f, "b1111111111111111111111111111111111111111111111111111111111111110 %s\n", id[D]);
+    fprintf(f, "b10z1 %s\n1%s\n", id[E], id[F]);
+    fprintf(f, "#20\nx%s\nb1 %s\n", id[A], id[E]);
+    fprintf(f, "#30\nz%s\nb0 %s\n0%s", id[A], id[D], id[F]);
+    fclose(f);
+
+    f = fopen(VCD_FILE, "w");
+    ck_assert_ptr_nonnull(f);
+    for (size_t i = 0; i < size; i++) {
+        if (crlf && text[i] == '\n')
+            fputc('\r', f);
+        fputc(text[i], f);
+    }
+    fclose(f);
+    free(text);
+}
+
+static void check_dump(const id_variant_t *v, vcd_backend_t backend, bool filter) {
+    vcd_t *vcd = vcd_open_backend(VCD_FILE, 4, backend);
+    ck_assert_ptr_nonnull(vcd);
+    // The file is complete, so don't wait for more
+    vcd_follow(vcd, 0, NULL, NULL);
+    vcd_parse_header(vcd);
+
+    ck_assert_int_eq(vcd->signal_count, SIGNALS);
+    ck_assert(!vcd->index.radix == !v->radix);
+    ck_assert(!vcd->index.hash == v->radix);
+    if (v->radix)
+        ck_assert(vcd->index.radix_msb_first == v->radix_msb_first);
+
+    vcd_signal_t *signals[SIGNALS];
+    for (int i = 0; i < SIGNALS; i++) {
+        signals[i] = &vcd->signals[i];
+        ck_assert_str_eq(signals[i]->path, paths[i]);
+        ck_assert_str_eq(signals[i]->id, v->ids[i]);
+        if (i != F)
+            ck_assert_ptr_eq(vcd_get_signal_by_name(vcd, (char *) paths[i]), signals[i]);
+    }
+    vcd_filter(vcd, filter);
+
+    // The first declared of the aliases, then in declaration order
+    ck_assert_ptr_eq(vcd_get_signal_by_id(vcd, v->ids[G], strlen(v->ids[G])), signals[B]);
+    ck_assert_ptr_eq(vcd_get_signal_by_id(vcd, v->ids[F], strlen(v->ids[F])), signals[F]);
+    ck_assert_ptr_null(vcd_get_signal_by_id(vcd, "long", 4));
+    ck_assert_ptr_null(vcd_get_signal_by_id(vcd, "?", 1));
+    ck_assert_int_eq(signals[B]->alias, signals[C] - vcd->signals);
+    ck_assert_int_eq(signals[C]->alias, signals[G] - vcd->signals);
+    ck_assert_int_eq(signals[G]->alias, -1);
+
+    for (int t = 0; t < TIMESLOTS; t++) {
+        ck_assert(vcd_has_next(vcd));
+        vcd_next(vcd);
+        ck_assert_uint_eq(vcd->time, times[t]);
+
+        size_t idx = vcd_get_data_idx(vcd, 0);
+        for (int i = 0; i < SIGNALS; i++) {
+            // The filter drops every change of f
+            const expected_t *e = &expected[t][i];
+            bool valid = e->valid && !(filter && i == F);
+            ck_assert_msg(signals[i]->valid[idx] == valid, "%s, backend %d, filter %d: valid of %s in timeslot %d",
+                    v->name, backend, filter, paths[i], t);
+            if (valid)
+                ck_assert_uint_eq(signals[i]->data[idx], e->data);
+        }
+    }
+    ck_assert(!vcd_has_next(vcd));
+
+    vcd_close(vcd);
+}
+
+START_TEST(test_vcd_backends) {
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+        write_vcd(&variants[v], false);
+        for (int filter = 0; filter < 2; filter++) {
+            check_dump(&variants[v], VCD_BACKEND_STDIO, filter);
+            check_dump(&variants[v], VCD_BACKEND_MMAP, filter);
+            check_dump(&variants[v], VCD_BACKEND_FOLLOW, filter);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_vcd_crlf) {
+    write_vcd(&variants[0], true);
+    for (int filter = 0; filter < 2; filter++) {
+        check_dump(&variants[0], VCD_BACKEND_STDIO, filter);
+        check_dump(&variants[0], VCD_BACKEND_MMAP, filter);
+        check_dump(&variants[0], VCD_BACKEND_FOLLOW, filter);
+    }
+}
+END_TEST
+
+// Compares vcd_parse_vector on [p, end) against vcd_parse_vector_slow, and the
+// latter against the len digits of pattern at p, bad is the first non-digit
+static void check_vector(const char *p, const char *end, size_t len, uint64_t pattern, int bad) {
+    uint64_t data, slow_data;
+    bool valid, slow_valid;
+
+    const char *q = vcd_parse_vector(p, end, &data, &valid);
+    const char *slow_q = vcd_parse_vector_slow(p, end, &slow_data, &slow_valid);
+
+    ck_assert_ptr_eq(q, slow_q);
+    ck_assert(valid == slow_valid);
+    ck_assert_uint_eq(data, slow_data);
+
+    ck_assert_ptr_eq(slow_q, p + len);
+    ck_assert(slow_valid == (bad < 0));
+    if (bad < 0)
+        ck_assert_uint_eq(slow_data, len < 64 ? pattern >> (64 - len) : pattern);
+}
+
+START_TEST(test_vcd_vector) {
+    const size_t lengths[] = { 1, 7, 8, 9, 64 };
+    const int bad_positions[] = { -1, 0, 7, 8 };
+    const char bad_chars[] = { 'x', 'z', 'X', 'Z', '2', 'b' };
+    const char *terminators[] = { " !\n", " !\r\n", "\n", "\r\n", "" };
+    const uint64_t pattern = 0x9E3779B97F4A7C15;
+
+    // The last page of the map is followed by one that faults on access, a
+    // value at the end of the map ends right before it
+    long page = sysconf(_SC_PAGESIZE);
+    char *map = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ck_assert_ptr_ne(map, MAP_FAILED);
+    ck_assert_int_eq(mprotect(map + page, page, PROT_NONE), 0);
+    char *end = map + page;
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t len = lengths[l];
+        for (size_t b = 0; b < sizeof(bad_positions) / sizeof(bad_positions[0]); b++) {
+            int bad = bad_positions[b];
+            if (bad >= (int) len)
+                continue;
+
+            for (size_t c = 0; c < (bad < 0 ? 1 : sizeof(bad_chars)); c++) {
+                for (size_t t = 0; t < sizeof(terminators) / sizeof(terminators[0]); t++) {
+                    size_t term = strlen(terminators[t]);
+                    char *p = end - len - term;
+
+                    // Digits around the value, which a decoder that reads outside
+                    // of it would take
+                    memset(map, '1', page);
+                    for (size_t i = 0; i < len; i++)
+                        p[i] = '0' + (pattern >> (63 - i) & 1);
+                    if (bad >= 0)
+                        p[bad] = bad_chars[c];
+                    memcpy(p + len, terminators[t], term);
+
+                    check_vector(p, end, len, pattern, bad);
+                }
+            }
+        }
+    }
+
+    munmap(map, 2 * page);
+}
+END_TEST
+
+Suite *make_vcd_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("VCD Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_test(tc_core, test_vcd_backends);
+    tcase_add_test(tc_core, test_vcd_crlf);
+    tcase_add_test(tc_core, test_vcd_vector);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_vcd_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_vcd.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <check.h>
+
+#include <golden.h>
+
+/*
+ * Runs verify_trace (its path is the first argument) on a generated dump,
+ * sequentially and on several threads with small chunks, and compares the
+ * outputs byte for byte
+ */
+
+#define DUMP_FILE "test_verify_trace.vcd"
+#define TIMESLOTS 5000
+#define CHUNK_BYTES 16384
+
+// r_i_u_2 changes much less often than the warm-up of a chunk is long, so
+// most chunks need it extended
+#define U_2_PERIOD 1000
+
+// Pipeline delays of verify_trace
+#define DELAY_U_0 24
+#define DELAY_U_1 12
+#define DELAY_U_2 33
+
+static const char *verify_trace;
+
+static uint64_t next_rand(uint64_t *x) {
+    // splitmix64
+    uint64_t z = (*x += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+static void put_vector(FILE *f, uint64_t x, int width, const char *id) {
+    fputc('b', f);
+    for (int i = width - 1; i >= 0; i--)
+        fputc('0' + (x >> i & 1), f);
+    fprintf(f, " %s\n", id);
+}
+
+// Outputs of the model for the delayed inputs, every 97th sample is off by a few ulps
+static void write_dump(void) {
+    static uint64_t u[3][TIMESLOTS];
+    uint64_t seed = 1;
+
+    for (size_t t = 0; t < TIMESLOTS; t++) {
+        u[0][t] = next_rand(&seed) & 0xFFFFFFFFFFFF;
+        u[1][t] = next_rand(&seed) & 0xFFFF;
+        u[2][t] = t % U_2_PERIOD ? u[2][t - 1] : next_rand(&seed) & 0x7FFFFFFF;
+    }
+
+    FILE *f = fopen(DUMP_FILE, "w");
+    ck_assert_ptr_nonnull(f);
+
+    fprintf(f, "$timescale\n   1ps\n$end\n$scope module tb $end\n");
+    fprintf(f, "$var wire 1 ! clk $end\n");
+    fprintf(f, "$var wire 48 \" r_i_u_0 $end\n$var wire 16 # r_i_u_1 $end\n$var wire 31 $ r_i_u_2 $end\n");
+    fprintf(f, "$var wire 16 %% t_x_0 $end\n$var wire 16 & t_x_1 $end\n");
+    fprintf(f, "$upscope $end\n$enddefinitions $end\n");
+
+    for (size_t t = 0; t < TIMESLOTS; t++) {
+        double x[2] = { 0, 0 }, e;
+        if (t >= DELAY_U_2)
+            golden_libm(u[0][t - DELAY_U_0], u[1][t - DELAY_U_1], u[2][t - DELAY_U_2], x, &e);
+
+        fprintf(f, "#%zu\n%d!\n", 10 * t, (int)(t & 1));
+        put_vector(f, u[0][t], 48, "\"");
+        put_vector(f, u[1][t], 16, "#");
+        if (t % U_2_PERIOD == 0)
+            put_vector(f, u[2][t], 31, "$");
+        for (int i = 0; i < 2; i++) {
+            int16_t code = (int16_t) lrint(x[i] * 2048) + (t % 97 ? 0 : 3);
+            put_vector(f, (uint16_t) code, 16, i ? "&" : "%");
+        }
+    }
+
+    fclose(f);
+}
+
+static char *read_file(const char *path, size_t *size) {
+    FILE *f = fopen(path, "rb");
+    ck_assert_ptr_nonnull(f);
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *data = malloc(*size + 1);
+    ck_assert_uint_eq(fread(data, 1, *size, f), *size);
+    fclose(f);
+    return data;
+}
+
+static void check_same(const char *a, const char *b) {
+    size_t size_a, size_b;
+    char *data_a = read_file(a, &size_a);
+    char *data_b = read_file(b, &size_b);
+
+    ck_assert_uint_gt(size_a, 0);
+    ck_assert_uint_eq(size_a, size_b);
+    ck_assert(!memcmp(data_a, data_b, size_a));
+
+    free(data_a);
+    free(data_b);
+}
+
+// verify_trace -j threads with the arguments args, stdout to out
+static void run(int threads, const char *args, const char *out) {
+    char cmd[1024];
+    snprintf(cmd, sizeof(cmd), "%s -j %d -c %d %s > %s", verify_trace, threads, CHUNK_BYTES, args, out);
+    ck_assert_int_eq(system(cmd), 0);
+}
+
+START_TEST(test_verify_trace_threads) {
+    write_dump();
+
+    // Per sample text and the model outputs
+    run(1, DUMP_FILE " seq.values", "seq.txt");
+    run(3, DUMP_FILE " par.values", "par.txt");
+    check_same("seq.txt", "par.txt");
+    check_same("seq.values", "par.values");
+
+    size_t size;
+    free(read_file("seq.values", &size));
+    ck_assert_uint_eq(size, (TIMESLOTS - 35) * 2 * sizeof(double));
+
+    // Summary and failing samples
+    run(1, "-s -f seq.fails " DUMP_FILE, "seq.summary");
+    run(3, "-s -f par.fails " DUMP_FILE, "par.summary");
+    check_same("seq.summary", "par.summary");
+    check_same("seq.fails", "par.fails");
+}
+END_TEST
+
+Suite *make_verify_trace_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Verify Trace Test Suite");
+    tc_core = tcase_create("Test Cases");
+
+    tcase_add_test(tc_core, test_verify_trace_threads);
+
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s VERIFY_TRACE\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    verify_trace = argv[1];
+
+    int number_failed = 0;
+    SRunner *sr = srunner_create(make_verify_trace_suite());
+    srunner_set_fork_status(sr, CK_NOFORK);
+    srunner_set_log(sr, "test_verify_trace.log");
+    srunner_run_all(sr, CK_VERBOSE);
+
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}